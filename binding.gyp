@@ -1,12 +1,93 @@
 {
+  "target_defaults": {
+    "defines": [
+      "UNICODE",
+      "_UNICODE"
+    ],
+    "conditions": [
+      [
+        "OS=='win'",
+        {
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "ExceptionHandling": 1,
+              "RuntimeLibrary": 2
+            }
+          }
+        }
+      ]
+    ]
+  },
   "targets": [
     {
-      "target_name": "brightness",
+      "target_name": "brightsync_hal",
+      "type": "static_library",
       "sources": [
-        "native/brightness.cc",
         "native/real_monitor.cpp",
+        "native/hardware_executor.cpp",
+        "native/internal_wmi_monitor.cpp",
+        "native/ddc_monitor.cpp",
+        "native/wmi_session.cpp",
         "native/mock_monitor.cpp",
-        "native/monitor_factory.cpp"
+        "native/monitor_factory.cpp",
+        "native/monitor_cache.cpp",
+        "native/monitor_batch.cpp",
+        "native/brightness_animator.cpp",
+        "native/write_queue.cpp",
+        "native/brightness_cache.cpp",
+        "native/monitor_prober.cpp",
+        "native/capability_store.cpp",
+        "native/ddc_pacer.cpp",
+        "native/circuit_breaker.cpp",
+        "native/native_log.cpp",
+        "native/monitor_stats.cpp",
+        "native/mock_topology.cpp",
+        "native/brightness_watcher.cpp",
+        "native/health_watcher.cpp",
+        "native/display_watcher.cpp",
+        "native/panel_event_watcher.cpp",
+        "native/trace_recorder.cpp",
+        "native/state_segment.cpp"
+      ],
+      "conditions": [
+        [
+          "OS=='win'",
+          {
+            "link_settings": {
+              "libraries": [
+                "-lDxva2.lib",
+                "-lUser32.lib",
+                "-lAdvapi32.lib",
+                "-lOle32.lib",
+                "-lOleAut32.lib",
+                "-lwbemuuid.lib"
+              ]
+            }
+          }
+        ]
+      ]
+    },
+    {
+      "target_name": "brightness",
+      "sources": [
+        "native/brightness.cc"
+      ],
+      "include_dirs": [
+        "<!@(node -p \"require('node-addon-api').include\")"
+      ],
+      "dependencies": [
+        "brightsync_hal",
+        "<!(node -p \"require('node-addon-api').gyp\")"
+      ],
+      "defines": [
+        "NAPI_DISABLE_CPP_EXCEPTIONS"
+      ]
+    },
+    {
+      "target_name": "brightsync_state",
+      "sources": [
+        "native/state_reader.cc",
+        "native/state_segment.cpp"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")"
@@ -15,29 +96,17 @@
         "<!(node -p \"require('node-addon-api').gyp\")"
       ],
       "defines": [
-        "NAPI_DISABLE_CPP_EXCEPTIONS",
-        "UNICODE",
-        "_UNICODE"
+        "NAPI_DISABLE_CPP_EXCEPTIONS"
+      ]
+    },
+    {
+      "target_name": "brightsync_cli",
+      "type": "executable",
+      "sources": [
+        "native/brightsync_cli.cpp"
       ],
-      "conditions": [
-        [
-          "OS=='win'",
-          {
-            "libraries": [
-              "-lDxva2.lib",
-              "-lUser32.lib",
-              "-lAdvapi32.lib",
-              "-lOle32.lib",
-              "-lOleAut32.lib"
-            ],
-            "msvs_settings": {
-              "VCCLCompilerTool": {
-                "ExceptionHandling": 1,
-                "RuntimeLibrary": 2
-              }
-            }
-          }
-        ]
+      "dependencies": [
+        "brightsync_hal"
       ]
     }
   ]
@@ -43,6 +43,12 @@ interface Window {
       data?: boolean;
       error?: string;
     }>;
+    getStats: () => Promise<{
+      success: boolean;
+      data?: import("./src/shared/types").NativeStats | null;
+      error?: string;
+    }>;
+    getMonitorState: () => import("./src/shared/types").Monitor[] | null;
     onBrightnessChanged: (
       callback: (
         event: import("./src/shared/types").BrightnessChangeEvent,
@@ -57,6 +63,43 @@ declare module "*.node" {
     getMonitors: () => import("./src/shared/types").Monitor[];
     getBrightness: (monitorId: string) => number;
     setBrightness: (monitorId: string, brightness: number) => boolean;
+    getMonitorsAsync: () => Promise<import("./src/shared/types").Monitor[]>;
+    getBrightnessAsync: (monitorId: string) => Promise<number>;
+    setBrightnessAsync: (
+      monitorId: string,
+      brightness: number,
+    ) => Promise<boolean>;
+    setBrightnessBatch: (
+      entries: import("./src/shared/types").BrightnessBatchEntry[],
+    ) => Promise<import("./src/shared/types").BrightnessBatchResult[]>;
+    setBrightnessTarget: (
+      monitorId: string,
+      brightness: number,
+      durationMs: number,
+    ) => Promise<import("./src/shared/types").BrightnessTransitionResult>;
+    setLogHandler: (
+      handler:
+        | ((entries: import("./src/shared/types").NativeLogEntry[]) => void)
+        | null,
+    ) => void;
+    getStats: (reset?: boolean) => import("./src/shared/types").NativeStats;
+    getMonitorDescriptors: () =>
+      | import("./src/shared/types").MonitorDescriptorSet
+      | null;
+    readBrightnessSnapshot: (values: Int32Array) => number;
+    readSharedState: () =>
+      | import("./src/shared/types").SharedMonitorState
+      | null;
+    onBrightnessChanged: (
+      handler:
+        | ((event: import("./src/shared/types").BrightnessChangeEvent) => void)
+        | null,
+      sampleIntervalMs?: number,
+    ) => void;
+    whenHardwareReady: () => Promise<boolean>;
+    setTracing: (enabled: boolean) => void;
+    traceNow: () => number;
+    drainTrace: () => import("./src/shared/types").NativeTrace;
   };
   export default content;
 }
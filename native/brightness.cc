@@ -8,79 +8,468 @@
 #include <napi.h>
 #include "monitor_interface.h"
 #include "monitor_factory.h"
+#include "monitor_cache.h"
+#include "display_watcher.h"
+#include "monitor_batch.h"
+#include "brightness_animator.h"
+#include "write_queue.h"
+#include "brightness_cache.h"
+#include "monitor_prober.h"
+#include "capability_store.h"
+#include "native_log.h"
+#include "monitor_stats.h"
+#include "mock_topology.h"
+#include "brightness_watcher.h"
+#include "health_watcher.h"
+#include "panel_event_watcher.h"
+#include "hardware_executor.h"
+#include "trace_recorder.h"
+#include "state_segment.h"
 #include <windows.h>
 #include <vector>
 #include <string>
 #include <memory>
-#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <system_error>
 
 // Global configuration
-static bool g_mockMode = false;
+static std::atomic<bool> g_mockMode(false);
 
-// Global monitor cache
-static std::vector<std::shared_ptr<IMonitor>> g_monitorCache;
-static DWORD g_lastCacheUpdate = 0;
-static const DWORD CACHE_TIMEOUT_MS = 500;
+// Simulated displays of mock mode (replaced by initialize)
+static std::mutex g_mockTopologyMutex;
+static std::shared_ptr<const MockTopology> g_mockTopology = std::make_shared<MockTopology>(MockTopology::Default());
 
 /**
- * Refresh monitor cache if needed
+ * Get the current mock topology
  */
-void RefreshMonitorCache()
+static std::shared_ptr<const MockTopology> GetMockTopology()
 {
-    DWORD currentTime = GetTickCount();
-    if (g_monitorCache.empty() || (currentTime - g_lastCacheUpdate) > CACHE_TIMEOUT_MS)
+    std::lock_guard<std::mutex> lock(g_mockTopologyMutex);
+    return g_mockTopology;
+}
+
+// Default staleness window for cached brightness values
+static const int DEFAULT_BRIGHTNESS_CACHE_MS = 5000;
+
+// Last known brightness per monitor; reads inside the window skip the hardware
+static BrightnessCache g_brightnessCache(std::chrono::milliseconds(DEFAULT_BRIGHTNESS_CACHE_MS));
+
+// Monitor table and confirmed brightness for other processes (see state_segment.h)
+static StateSegment g_stateSegment;
+
+/**
+ * Remember a value just read from or written to the hardware
+ * Negative values (read errors) are ignored
+ */
+static void StoreBrightness(const std::shared_ptr<IMonitor> &monitor, int value)
+{
+    g_brightnessCache.Store(monitor, value);
+    g_stateSegment.Update(*monitor, value);
+}
+
+// Runs capability probes of newly found monitors in parallel
+static MonitorProber g_prober;
+
+// DDC/CI capabilities remembered across launches (declared before the monitor
+// cache so monitors holding a pointer to it are destroyed first)
+static CapabilityStore g_capabilityStore;
+
+static void RetireMonitor(const std::shared_ptr<IMonitor> &monitor);
+
+/**
+ * Rebuild the monitor list (reusing monitors that are still present)
+ */
+static std::vector<std::shared_ptr<IMonitor>> RefreshMonitorCache(
+    const std::vector<std::shared_ptr<IMonitor>> &existing)
+{
+    if (g_mockMode)
     {
-        if (g_mockMode)
+        BS_LOG_DEBUG("[MOCK MODE] Refreshing monitor cache...");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<const MockTopology> topology = GetMockTopology();
+    std::vector<std::shared_ptr<IMonitor>> monitors = CreateMonitors(g_mockMode, existing, &g_capabilityStore, topology.get());
+    MonitorStats::Instance().RecordEnumeration(std::chrono::steady_clock::now() - start);
+
+    for (const auto &monitor : existing)
+    {
+        if (std::find(monitors.begin(), monitors.end(), monitor) == monitors.end())
+        {
+            RetireMonitor(monitor);
+        }
+    }
+
+    std::vector<std::shared_ptr<IMonitor>> unprobed;
+    for (const auto &monitor : monitors)
+    {
+        bool reused = std::find(existing.begin(), existing.end(), monitor) != existing.end();
+        if (reused)
         {
-            std::cout << "[MOCK MODE] Refreshing monitor cache..." << std::endl;
+            continue;
         }
 
-        g_monitorCache = CreateMonitors(g_mockMode);
-        g_lastCacheUpdate = currentTime;
+        if (!monitor->IsProbed())
+        {
+            unprobed.push_back(monitor);
+        }
+        else if (monitor->IsControllable())
+        {
+            StoreBrightness(monitor, monitor->GetLastKnownBrightness());
+        }
     }
+
+    // Published before the probes start, so every probe result reaches it
+    g_stateSegment.Publish(monitors);
+
+    // Probe all new displays at once, off the enumeration; each probe result
+    // seeds the cache so the first getMonitors does not read it again
+    g_prober.ProbeAsync(unprobed, [](const std::shared_ptr<IMonitor> &monitor)
+                        {
+        int cached;
+        if (monitor->IsControllable() && !g_brightnessCache.Lookup(monitor, cached))
+        {
+            StoreBrightness(monitor, monitor->GetLastKnownBrightness());
+        } });
+
+    return monitors;
 }
 
+// Global monitor cache - rebuilt only when the display watcher reports a
+// topology change (or after initialize), never on a timer; its rebuild
+// thread starts the rebuild as soon as the change is reported
+static MonitorCache g_monitorCache(RefreshMonitorCache);
+
+// Hidden window listening for WM_DISPLAYCHANGE / monitor arrival (real mode only)
+static DisplayWatcher g_displayWatcher;
+
+// Plays back simulated hotplug events (mock mode only)
+static MockHotplugTimer g_mockHotplug;
+
 /**
- * Convert IMonitor to Napi::Object
+ * Plain snapshot of a monitor, safe to build off the JS thread
+ */
+struct MonitorState
+{
+    MonitorDescriptor descriptor;
+    int current;     // -1 while probing
+    bool probing;    // capability probe still running
+    bool responding; // false while calls fail fast (monitor stopped answering)
+    bool provisional = false; // from the last session; discovery still running
+};
+
+/**
+ * Get a copy of the current monitor list, refreshing the cache if needed
+ */
+static std::vector<std::shared_ptr<IMonitor>> GetCachedMonitors()
+{
+    return g_monitorCache.GetMonitors();
+}
+
+/**
+ * Find a monitor by ID, refreshing the cache if needed
+ * @return Monitor instance, or nullptr if not found
+ */
+static std::shared_ptr<IMonitor> FindMonitor(const std::string &monitorId)
+{
+    return g_monitorCache.Find(monitorId);
+}
+
+// Coalesces concurrent writes per monitor (latest value wins)
+static WriteQueue g_writeQueue;
+
+/**
+ * Write brightness through the per-monitor write queue, as a hardware fade
+ * @param durationMs Fade time, 0 for a plain write
+ * @return false only if the hardware write failed
+ */
+static bool WriteBrightnessRamped(const std::shared_ptr<IMonitor> &monitor, int value, int durationMs)
+{
+    TraceSpan span("write queue", "native", monitor->GetId());
+    WriteOutcome outcome = g_writeQueue.Write(monitor, value, durationMs);
+
+    if (outcome == WriteOutcome::Superseded)
+    {
+        MonitorStats::Instance().RecordWriteCoalesced();
+    }
+    else if (outcome == WriteOutcome::Written || outcome == WriteOutcome::Unchanged)
+    {
+        StoreBrightness(monitor, value);
+    }
+    else if (outcome == WriteOutcome::Failed)
+    {
+        // Other processes keep the last confirmed value but see the failure
+        g_brightnessCache.Invalidate(monitor);
+        g_stateSegment.Update(*monitor, -1);
+    }
+
+    return outcome != WriteOutcome::Failed;
+}
+
+/**
+ * Write brightness through the per-monitor write queue
+ * @return false only if the hardware write failed
+ */
+static bool WriteBrightness(const std::shared_ptr<IMonitor> &monitor, int value)
+{
+    return WriteBrightnessRamped(monitor, value, 0);
+}
+
+/**
+ * Read brightness, answering from the cache while the value is fresh
+ * @param forceRefresh Always read from the hardware
+ */
+static int ReadBrightness(const std::shared_ptr<IMonitor> &monitor, bool forceRefresh = false)
+{
+    int brightness = -1;
+    if (!forceRefresh && g_brightnessCache.Lookup(monitor, brightness))
+    {
+        MonitorStats::Instance().RecordCacheHit();
+        return brightness;
+    }
+
+    MonitorStats::Instance().RecordCacheMiss();
+    brightness = monitor->GetBrightness();
+    StoreBrightness(monitor, brightness);
+    g_writeQueue.Observe(monitor, brightness);
+    return brightness;
+}
+
+// Probes monitors that stopped answering until they are back (both modes)
+static HealthWatcher g_healthWatcher;
+
+// Time between health rounds; each monitor's backoff decides when it is probed
+static const int HEALTH_CHECK_MS = 500;
+
+/**
+ * Start probing the monitors of the current list that stopped answering
+ */
+static void StartHealthWatcher()
+{
+    g_healthWatcher.Start([]()
+                          {
+        // Never enumerate from the health thread
+        std::vector<std::shared_ptr<IMonitor>> monitors;
+        g_monitorCache.TryGetMonitors(monitors);
+        return monitors; },
+                          [](const std::shared_ptr<IMonitor> &monitor)
+                          {
+        // The probe read the hardware; its value replaces the stale one
+        int brightness = monitor->GetLastKnownBrightness();
+        StoreBrightness(monitor, brightness);
+        g_writeQueue.Observe(monitor, brightness); },
+                          std::chrono::milliseconds(HEALTH_CHECK_MS));
+}
+
+/**
+ * Read monitor state (may perform a hardware brightness read)
+ * @param forceRefresh Bypass the brightness cache
+ */
+static MonitorState ReadMonitorState(const std::shared_ptr<IMonitor> &monitor, bool forceRefresh = false)
+{
+    MonitorState state;
+    state.descriptor = monitor->GetDescriptor();
+    state.probing = !monitor->IsProbed();
+    state.responding = monitor->IsResponding();
+
+    // Do not queue behind a running probe; its result arrives shortly
+    state.current = state.probing ? -1 : ReadBrightness(monitor, forceRefresh);
+    return state;
+}
+
+/**
+ * Build monitor states purely from memory
+ * @param states Receives one state per monitor
+ * @return false if enumeration or a hardware read would be needed
+ */
+static bool TryReadCachedStates(std::vector<MonitorState> &states)
+{
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+    if (!g_monitorCache.TryGetMonitors(monitors))
+    {
+        return false;
+    }
+
+    states.clear();
+    states.reserve(monitors.size());
+    for (const auto &monitor : monitors)
+    {
+        MonitorState state;
+        state.probing = !monitor->IsProbed();
+        state.responding = monitor->IsResponding();
+        if (state.probing)
+        {
+            state.current = -1;
+        }
+        else if (!g_brightnessCache.Lookup(monitor, state.current))
+        {
+            return false;
+        }
+        state.descriptor = monitor->GetDescriptor();
+        states.push_back(state);
+    }
+
+    for (const auto &state : states)
+    {
+        if (!state.probing)
+        {
+            MonitorStats::Instance().RecordCacheHit();
+        }
+    }
+    return true;
+}
+
+// Set while initialize({ deferHardware: true }) is still discovering monitors
+static std::atomic<bool> g_discoveryPending(false);
+
+/**
+ * Build monitor states from the topology saved by the last session
+ * Used while deferred discovery runs, so nothing waits for the hardware
+ * @return false if discovery has finished or nothing was saved
+ */
+static bool TryReadProvisionalStates(std::vector<MonitorState> &states)
+{
+    // Only real mode loads the store
+    if (!g_discoveryPending || g_mockMode)
+    {
+        return false;
+    }
+
+    std::vector<KnownDisplay> displays = g_capabilityStore.GetDisplays();
+    if (displays.empty())
+    {
+        return false;
+    }
+
+    states.clear();
+    states.reserve(displays.size());
+    for (const auto &display : displays)
+    {
+        MonitorState state;
+        state.descriptor = {display.id, display.name, display.type, 0, 100};
+        state.current = display.brightness;
+        state.probing = display.brightness < 0;
+        state.responding = true;
+        state.provisional = true;
+        states.push_back(state);
+    }
+    return true;
+}
+
+/**
+ * Read the optional forceRefresh argument at the given position
+ */
+static bool GetForceRefreshArg(const Napi::CallbackInfo &info, size_t index)
+{
+    return info.Length() > index && info[index].IsBoolean() && info[index].As<Napi::Boolean>().Value();
+}
+
+/**
+ * Read the optional trace request ID at the given position (0 for none)
+ */
+static uint64_t GetTraceIdArg(const Napi::CallbackInfo &info, size_t index)
+{
+    if (info.Length() <= index || !info[index].IsNumber())
+    {
+        return 0;
+    }
+
+    double id = info[index].As<Napi::Number>().DoubleValue();
+    return id > 0 ? static_cast<uint64_t>(id) : 0;
+}
+
+/**
+ * Convert MonitorDescriptor to Napi::Object
  */
-Napi::Object MonitorToObject(Napi::Env env, const std::shared_ptr<IMonitor> &monitor)
+Napi::Object DescriptorToObject(Napi::Env env, const MonitorDescriptor &descriptor)
 {
     Napi::Object obj = Napi::Object::New(env);
 
-    obj.Set("id", Napi::String::New(env, monitor->GetId()));
-    obj.Set("name", Napi::String::New(env, monitor->GetName()));
-    obj.Set("type", Napi::String::New(env, monitor->GetType()));
-    obj.Set("min", Napi::Number::New(env, monitor->GetMinBrightness()));
-    obj.Set("max", Napi::Number::New(env, monitor->GetMaxBrightness()));
-    obj.Set("current", Napi::Number::New(env, monitor->GetBrightness()));
+    obj.Set("id", Napi::String::New(env, descriptor.id));
+    obj.Set("name", Napi::String::New(env, descriptor.name));
+    obj.Set("type", Napi::String::New(env, MonitorTypeName(descriptor.type)));
+    obj.Set("min", Napi::Number::New(env, descriptor.minBrightness));
+    obj.Set("max", Napi::Number::New(env, descriptor.maxBrightness));
+
+    return obj;
+}
+
+/**
+ * Convert MonitorState to Napi::Object
+ */
+Napi::Object MonitorStateToObject(Napi::Env env, const MonitorState &state)
+{
+    Napi::Object obj = DescriptorToObject(env, state.descriptor);
+
+    obj.Set("current", Napi::Number::New(env, state.current));
+    obj.Set("probing", Napi::Boolean::New(env, state.probing));
+    obj.Set("responding", Napi::Boolean::New(env, state.responding));
+    if (state.provisional)
+    {
+        obj.Set("provisional", Napi::Boolean::New(env, true));
+    }
 
     return obj;
 }
 
+/**
+ * Convert monitor states to a JS array
+ */
+static Napi::Array StatesToArray(Napi::Env env, const std::vector<MonitorState> &states)
+{
+    Napi::Array result = Napi::Array::New(env, states.size());
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        result[i] = MonitorStateToObject(env, states[i]);
+    }
+    return result;
+}
+
+/**
+ * Convert IMonitor to Napi::Object
+ */
+Napi::Object MonitorToObject(Napi::Env env, const std::shared_ptr<IMonitor> &monitor, bool forceRefresh = false)
+{
+    return MonitorStateToObject(env, ReadMonitorState(monitor, forceRefresh));
+}
+
 /**
  * N-API: Get all monitors
+ * Args: forceRefresh (boolean, optional) - bypass the brightness cache
  * Returns: Array of monitor objects
  */
 Napi::Value GetMonitors(const Napi::CallbackInfo &info)
 {
     Napi::Env env = info.Env();
+    bool forceRefresh = GetForceRefreshArg(info, 0);
+
+    // Deferred discovery still running: answer with the last session's monitors
+    std::vector<MonitorState> provisional;
+    if (TryReadProvisionalStates(provisional))
+    {
+        return StatesToArray(env, provisional);
+    }
 
     try
     {
-        // Refresh monitor cache
-        RefreshMonitorCache();
+        std::vector<std::shared_ptr<IMonitor>> monitors = GetCachedMonitors();
 
         if (g_mockMode)
         {
-            std::cout << "[MOCK MODE] Returning " << g_monitorCache.size() << " monitors" << std::endl;
+            BS_LOG_DEBUG("[MOCK MODE] Returning " << monitors.size() << " monitors");
         }
 
         // Create array to return
-        Napi::Array result = Napi::Array::New(env, g_monitorCache.size());
+        Napi::Array result = Napi::Array::New(env, monitors.size());
 
-        for (size_t i = 0; i < g_monitorCache.size(); i++)
+        for (size_t i = 0; i < monitors.size(); i++)
         {
-            result[i] = MonitorToObject(env, g_monitorCache[i]);
+            result[i] = MonitorToObject(env, monitors[i], forceRefresh);
         }
 
         return result;
@@ -94,7 +483,7 @@ Napi::Value GetMonitors(const Napi::CallbackInfo &info)
 
 /**
  * N-API: Get brightness for a specific monitor
- * Args: monitorId (string)
+ * Args: monitorId (string), forceRefresh (boolean, optional)
  * Returns: brightness value (number) or -1 on error
  */
 Napi::Value GetBrightness(const Napi::CallbackInfo &info)
@@ -109,22 +498,12 @@ Napi::Value GetBrightness(const Napi::CallbackInfo &info)
     }
 
     std::string monitorId = info[0].As<Napi::String>().Utf8Value();
+    bool forceRefresh = GetForceRefreshArg(info, 1);
 
     try
     {
-        // Refresh monitor cache
-        RefreshMonitorCache();
-
         // Find monitor
-        std::shared_ptr<IMonitor> monitor = nullptr;
-        for (const auto &m : g_monitorCache)
-        {
-            if (m->GetId() == monitorId)
-            {
-                monitor = m;
-                break;
-            }
-        }
+        std::shared_ptr<IMonitor> monitor = FindMonitor(monitorId);
 
         if (!monitor)
         {
@@ -132,11 +511,11 @@ Napi::Value GetBrightness(const Napi::CallbackInfo &info)
             return Napi::Number::New(env, -1);
         }
 
-        int brightness = monitor->GetBrightness();
+        int brightness = ReadBrightness(monitor, forceRefresh);
 
         if (g_mockMode && brightness >= 0)
         {
-            std::cout << "[MOCK MODE] GetBrightness(" << monitorId << ") = " << brightness << std::endl;
+            BS_LOG_DEBUG("[MOCK MODE] GetBrightness(" << monitorId << ") = " << brightness);
         }
 
         return Napi::Number::New(env, brightness);
@@ -175,19 +554,8 @@ Napi::Value SetBrightness(const Napi::CallbackInfo &info)
 
     try
     {
-        // Refresh monitor cache
-        RefreshMonitorCache();
-
         // Find monitor
-        std::shared_ptr<IMonitor> monitor = nullptr;
-        for (const auto &m : g_monitorCache)
-        {
-            if (m->GetId() == monitorId)
-            {
-                monitor = m;
-                break;
-            }
-        }
+        std::shared_ptr<IMonitor> monitor = FindMonitor(monitorId);
 
         if (!monitor)
         {
@@ -195,11 +563,11 @@ Napi::Value SetBrightness(const Napi::CallbackInfo &info)
             return Napi::Boolean::New(env, false);
         }
 
-        bool success = monitor->SetBrightness(brightness);
+        bool success = WriteBrightness(monitor, brightness);
 
         if (g_mockMode)
         {
-            std::cout << "[MOCK MODE] SetBrightness(" << monitorId << ", " << brightness << ") = " << (success ? "success" : "failed") << std::endl;
+            BS_LOG_DEBUG("[MOCK MODE] SetBrightness(" << monitorId << ", " << brightness << ") = " << (success ? "success" : "failed"));
         }
 
         return Napi::Boolean::New(env, success);
@@ -211,66 +579,1546 @@ Napi::Value SetBrightness(const Napi::CallbackInfo &info)
     }
 }
 
+// ============================================================================
+// Async Exports (Napi::AsyncWorker)
+//
+// Hardware calls run on the libuv thread pool so DDC/CI and WMI round trips
+// never block the Electron main thread. Each export returns a Promise.
+// ============================================================================
+
 /**
- * N-API: Initialize the addon with configuration
- * Args: config object with { mockMode: boolean }
- * Returns: success (boolean)
+ * Create a Promise that is already rejected (argument validation errors)
  */
-Napi::Value Initialize(const Napi::CallbackInfo &info)
+static Napi::Value RejectedPromise(Napi::Env env, const Napi::Error &error)
 {
-    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    deferred.Reject(error.Value());
+    return deferred.Promise();
+}
 
-    try
+/**
+ * Async worker: enumerate monitors and read their brightness
+ */
+class GetMonitorsWorker : public Napi::AsyncWorker
+{
+public:
+    GetMonitorsWorker(Napi::Env env, bool forceRefresh)
+        : Napi::AsyncWorker(env),
+          m_deferred(Napi::Promise::Deferred::New(env)),
+          m_forceRefresh(forceRefresh)
     {
-        // Check if config object is provided
-        if (info.Length() > 0 && info[0].IsObject())
-        {
-            Napi::Object config = info[0].As<Napi::Object>();
+    }
 
-            // Get mockMode flag
-            if (config.Has("mockMode"))
-            {
-                Napi::Value mockModeValue = config.Get("mockMode");
-                if (mockModeValue.IsBoolean())
-                {
-                    g_mockMode = mockModeValue.As<Napi::Boolean>().Value();
+    Napi::Promise GetPromise() { return m_deferred.Promise(); }
 
-                    if (g_mockMode)
-                    {
-                        std::cout << "[MOCK MODE] Hardware abstraction layer initialized in MOCK mode" << std::endl;
-                        std::cout << "[MOCK MODE] All monitor operations will be simulated" << std::endl;
-                    }
-                    else
-                    {
-                        std::cout << "Hardware abstraction layer initialized in REAL mode" << std::endl;
-                    }
-                }
+protected:
+    void Execute() override
+    {
+        TraceRequestScope request(m_trace, "uv queue", "queue");
+        TraceSpan span("getMonitorsAsync", "napi");
+
+        try
+        {
+            for (const auto &monitor : GetCachedMonitors())
+            {
+                m_states.push_back(ReadMonitorState(monitor, m_forceRefresh));
             }
         }
+        catch (const std::exception &e)
+        {
+            SetError(std::string("Failed to get monitors: ") + e.what());
+        }
+    }
 
-        // Clear cache to force reinitialization with new mode
-        g_monitorCache.clear();
-        g_lastCacheUpdate = 0;
+    void OnOK() override
+    {
+        m_deferred.Resolve(StatesToArray(Env(), m_states));
+    }
 
-        return Napi::Boolean::New(env, true);
+    void OnError(const Napi::Error &error) override
+    {
+        m_deferred.Reject(error.Value());
     }
-    catch (const std::exception &e)
+
+private:
+    Napi::Promise::Deferred m_deferred;
+    TraceHandoff m_trace; // taken on the JS thread when the worker is created
+    bool m_forceRefresh;
+    std::vector<MonitorState> m_states;
+};
+
+/**
+ * Async worker: read brightness for one monitor
+ */
+class GetBrightnessWorker : public Napi::AsyncWorker
+{
+public:
+    GetBrightnessWorker(Napi::Env env, const std::string &monitorId, bool forceRefresh)
+        : Napi::AsyncWorker(env),
+          m_deferred(Napi::Promise::Deferred::New(env)),
+          m_monitorId(monitorId),
+          m_forceRefresh(forceRefresh),
+          m_brightness(-1)
     {
-        Napi::Error::New(env, std::string("Failed to initialize: ") + e.what()).ThrowAsJavaScriptException();
-        return Napi::Boolean::New(env, false);
     }
-}
+
+    Napi::Promise GetPromise() { return m_deferred.Promise(); }
+
+protected:
+    void Execute() override
+    {
+        TraceRequestScope request(m_trace, "uv queue", "queue");
+        TraceSpan span("getBrightnessAsync", "napi");
+
+        try
+        {
+            std::shared_ptr<IMonitor> monitor = FindMonitor(m_monitorId);
+            if (!monitor)
+            {
+                SetError("Monitor not found: " + m_monitorId);
+                return;
+            }
+
+            m_brightness = ReadBrightness(monitor, m_forceRefresh);
+        }
+        catch (const std::exception &e)
+        {
+            SetError(std::string("Failed to get brightness: ") + e.what());
+        }
+    }
+
+    void OnOK() override
+    {
+        m_deferred.Resolve(Napi::Number::New(Env(), m_brightness));
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        m_deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred m_deferred;
+    TraceHandoff m_trace; // taken on the JS thread when the worker is created
+    std::string m_monitorId;
+    bool m_forceRefresh;
+    int m_brightness;
+};
 
 /**
- * Initialize N-API module
+ * Async worker: write brightness for one monitor
  */
-Napi::Object Init(Napi::Env env, Napi::Object exports)
+class SetBrightnessWorker : public Napi::AsyncWorker
 {
+public:
+    SetBrightnessWorker(Napi::Env env, const std::string &monitorId, int brightness)
+        : Napi::AsyncWorker(env),
+          m_deferred(Napi::Promise::Deferred::New(env)),
+          m_monitorId(monitorId),
+          m_brightness(brightness),
+          m_success(false)
+    {
+    }
+
+    Napi::Promise GetPromise() { return m_deferred.Promise(); }
+
+protected:
+    void Execute() override
+    {
+        TraceRequestScope request(m_trace, "uv queue", "queue");
+        TraceSpan span("setBrightnessAsync", "napi");
+
+        try
+        {
+            std::shared_ptr<IMonitor> monitor = FindMonitor(m_monitorId);
+            if (!monitor)
+            {
+                SetError("Monitor not found: " + m_monitorId);
+                return;
+            }
+
+            m_success = WriteBrightness(monitor, m_brightness);
+        }
+        catch (const std::exception &e)
+        {
+            SetError(std::string("Failed to set brightness: ") + e.what());
+        }
+    }
+
+    void OnOK() override
+    {
+        m_deferred.Resolve(Napi::Boolean::New(Env(), m_success));
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        m_deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred m_deferred;
+    TraceHandoff m_trace; // taken on the JS thread when the worker is created
+    std::string m_monitorId;
+    int m_brightness;
+    bool m_success;
+};
+
+/**
+ * Async worker: write brightness for several monitors in parallel
+ */
+class SetBrightnessBatchWorker : public Napi::AsyncWorker
+{
+public:
+    SetBrightnessBatchWorker(Napi::Env env, const std::vector<std::pair<std::string, int>> &requests)
+        : Napi::AsyncWorker(env),
+          m_deferred(Napi::Promise::Deferred::New(env)),
+          m_requests(requests)
+    {
+    }
+
+    Napi::Promise GetPromise() { return m_deferred.Promise(); }
+
+protected:
+    void Execute() override
+    {
+        TraceRequestScope request(m_trace, "uv queue", "queue");
+        TraceSpan span("setBrightnessBatch", "napi");
+
+        try
+        {
+            std::vector<BatchItem> items;
+            items.reserve(m_requests.size());
+
+            for (const auto &request : m_requests)
+            {
+                BatchItem item;
+                item.id = request.first;
+                item.monitor = FindMonitor(request.first);
+                item.value = request.second;
+                items.push_back(item);
+            }
+
+            m_results = ExecuteBrightnessBatch(items, WriteBrightness);
+        }
+        catch (const std::exception &e)
+        {
+            SetError(std::string("Failed to set brightness batch: ") + e.what());
+        }
+    }
+
+    void OnOK() override
+    {
+        Napi::Env env = Env();
+        Napi::Array result = Napi::Array::New(env, m_results.size());
+
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("id", Napi::String::New(env, m_results[i].id));
+            obj.Set("success", Napi::Boolean::New(env, m_results[i].success));
+            if (!m_results[i].error.empty())
+            {
+                obj.Set("error", Napi::String::New(env, m_results[i].error));
+            }
+            result[i] = obj;
+        }
+
+        if (g_mockMode)
+        {
+            BS_LOG_DEBUG("[MOCK MODE] SetBrightnessBatch(" << m_results.size() << " monitors) completed");
+        }
+
+        m_deferred.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        m_deferred.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred m_deferred;
+    TraceHandoff m_trace; // taken on the JS thread when the worker is created
+    std::vector<std::pair<std::string, int>> m_requests;
+    std::vector<BatchResult> m_results;
+};
+
+/**
+ * N-API: Get all monitors (async)
+ * Args: forceRefresh (boolean, optional) - bypass the brightness cache,
+ *       traceId (number, optional)
+ * Returns: Promise<Array of monitor objects>
+ */
+Napi::Value GetMonitorsAsync(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    bool forceRefresh = GetForceRefreshArg(info, 0);
+    TraceRequestScope request(GetTraceIdArg(info, 1));
+
+    // Everything cached (or deferred discovery still running): answer from
+    // memory without a worker round trip
+    std::vector<MonitorState> states;
+    if (TryReadProvisionalStates(states) || (!forceRefresh && TryReadCachedStates(states)))
+    {
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        deferred.Resolve(StatesToArray(env, states));
+        return deferred.Promise();
+    }
+
+    GetMonitorsWorker *worker = new GetMonitorsWorker(env, forceRefresh);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * N-API: Get brightness for a specific monitor (async)
+ * Args: monitorId (string), forceRefresh (boolean, optional), traceId (number, optional)
+ * Returns: Promise<brightness value (number)>
+ */
+Napi::Value GetBrightnessAsync(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    // Validate arguments
+    if (info.Length() < 1 || !info[0].IsString())
+    {
+        return RejectedPromise(env, Napi::TypeError::New(env, "String expected for monitorId"));
+    }
+
+    std::string monitorId = info[0].As<Napi::String>().Utf8Value();
+    bool forceRefresh = GetForceRefreshArg(info, 1);
+    TraceRequestScope request(GetTraceIdArg(info, 2));
+
+    GetBrightnessWorker *worker = new GetBrightnessWorker(env, monitorId, forceRefresh);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * N-API: Set brightness for a specific monitor (async)
+ * Args: monitorId (string), brightness (number), traceId (number, optional)
+ * Returns: Promise<success (boolean)>
+ */
+Napi::Value SetBrightnessAsync(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    // Validate arguments
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber())
+    {
+        return RejectedPromise(env, Napi::TypeError::New(env, "String and Number expected"));
+    }
+
+    std::string monitorId = info[0].As<Napi::String>().Utf8Value();
+    int brightness = info[1].As<Napi::Number>().Int32Value();
+
+    // Clamp brightness to 0-100
+    if (brightness < 0)
+        brightness = 0;
+    if (brightness > 100)
+        brightness = 100;
+
+    TraceRequestScope request(GetTraceIdArg(info, 2));
+    SetBrightnessWorker *worker = new SetBrightnessWorker(env, monitorId, brightness);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * N-API: Set brightness for several monitors at once (async)
+ * Args: requests (Array of { id: string, value: number }), traceId (number, optional)
+ * Returns: Promise<Array of { id, success, error? }> in request order
+ */
+Napi::Value SetBrightnessBatch(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    // Validate arguments
+    if (info.Length() < 1 || !info[0].IsArray())
+    {
+        return RejectedPromise(env, Napi::TypeError::New(env, "Array of { id, value } expected"));
+    }
+
+    Napi::Array input = info[0].As<Napi::Array>();
+    std::vector<std::pair<std::string, int>> requests;
+    requests.reserve(input.Length());
+
+    for (uint32_t i = 0; i < input.Length(); i++)
+    {
+        Napi::Value entry = input.Get(i);
+        if (!entry.IsObject())
+        {
+            return RejectedPromise(env, Napi::TypeError::New(env, "Array of { id, value } expected"));
+        }
+
+        Napi::Object obj = entry.As<Napi::Object>();
+        Napi::Value id = obj.Get("id");
+        Napi::Value value = obj.Get("value");
+        if (!id.IsString() || !value.IsNumber())
+        {
+            return RejectedPromise(env, Napi::TypeError::New(env, "Array of { id, value } expected"));
+        }
+
+        int brightness = value.As<Napi::Number>().Int32Value();
+
+        // Clamp brightness to 0-100
+        if (brightness < 0)
+            brightness = 0;
+        if (brightness > 100)
+            brightness = 100;
+
+        requests.push_back(std::make_pair(id.As<Napi::String>().Utf8Value(), brightness));
+    }
+
+    TraceRequestScope request(GetTraceIdArg(info, 1));
+    SetBrightnessBatchWorker *worker = new SetBrightnessBatchWorker(env, requests);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+// ============================================================================
+// Native Transitions
+// ============================================================================
+
+// Created on the first setBrightnessTarget call on the JS thread; the pointer
+// is guarded by g_animatorMutex since rebuilds remove tracks of lost monitors
+static std::unique_ptr<BrightnessAnimator> g_animator;
+static std::mutex g_animatorMutex;
+static Napi::ThreadSafeFunction g_animatorCallback; // JS thread only
+
+// Pending setBrightnessTarget promises by animator token (JS thread only)
+static std::unordered_map<uint64_t, Napi::Promise::Deferred> g_pendingTransitions;
+
+/**
+ * Resolve the promise of a finished transition (runs on the JS thread)
+ */
+static void ResolveTransition(Napi::Env env, Napi::Function, AnimationResult *result)
+{
+    auto it = g_pendingTransitions.find(result->token);
+    if (it != g_pendingTransitions.end())
+    {
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("id", Napi::String::New(env, result->id));
+        obj.Set("value", Napi::Number::New(env, result->value));
+        obj.Set("success", Napi::Boolean::New(env, result->success));
+        obj.Set("superseded", Napi::Boolean::New(env, result->superseded));
+        obj.Set("hardwareRamp", Napi::Boolean::New(env, result->hardwareRamp));
+        it->second.Resolve(obj);
+        g_pendingTransitions.erase(it);
+    }
+    delete result;
+}
+
+/**
+ * Hand an animator result to the JS thread (called on a track thread)
+ */
+static void PostTransitionResult(const AnimationResult &result)
+{
+    AnimationResult *copy = new AnimationResult(result);
+    if (g_animatorCallback.NonBlockingCall(copy, ResolveTransition) != napi_ok)
+    {
+        delete copy;
+    }
+}
+
+/**
+ * Get the animator, creating it and its JS callback on first use
+ */
+static BrightnessAnimator &GetAnimator(Napi::Env env)
+{
+    std::lock_guard<std::mutex> lock(g_animatorMutex);
+    if (!g_animator)
+    {
+        g_animatorCallback = Napi::ThreadSafeFunction::New(
+            env, Napi::Function::New(env, [](const Napi::CallbackInfo &) {}), "BrightnessAnimator", 0, 1);
+
+        // Pending transitions must not keep the process alive
+        g_animatorCallback.Unref(env);
+
+        g_animator.reset(new BrightnessAnimator(FindMonitor, PostTransitionResult, 10, WriteBrightness,
+                                                [](const std::shared_ptr<IMonitor> &monitor)
+                                                { return ReadBrightness(monitor); },
+                                                WriteBrightnessRamped));
+    }
+    return *g_animator;
+}
+
+/**
+ * Stop all transitions and release the JS callback
+ */
+static void StopAnimator()
+{
+    // Stopped outside the lock: tracks may be rebuilding the monitor list
+    std::unique_ptr<BrightnessAnimator> animator;
+    {
+        std::lock_guard<std::mutex> lock(g_animatorMutex);
+        animator.swap(g_animator);
+    }
+
+    if (animator)
+    {
+        animator->Stop();
+        animator.reset();
+        g_animatorCallback.Release();
+    }
+}
+
+/**
+ * Release the threads of a monitor the topology dropped (any thread)
+ * Its transition fails; its lane finishes only its own queued commands
+ */
+static void RetireMonitor(const std::shared_ptr<IMonitor> &monitor)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_animatorMutex);
+        if (g_animator)
+        {
+            g_animator->RemoveTrack(monitor->GetId());
+        }
+    }
+
+    monitor->Retire();
+}
+
+/**
+ * N-API: Animate a monitor towards a target brightness
+ * Args: monitorId (string), brightness (number), durationMs (number),
+ *       traceId (number, optional)
+ * Returns: Promise<{ id, value, success, superseded, hardwareRamp }>
+ *
+ * A newer target for the same monitor replaces this one mid-flight; the
+ * replaced promise resolves with superseded = true. Monitors that fade by
+ * themselves get one ramped write (hardwareRamp = true) when the duration
+ * allows it.
+ */
+Napi::Value SetBrightnessTarget(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    // Validate arguments
+    if (info.Length() < 3 || !info[0].IsString() || !info[1].IsNumber() || !info[2].IsNumber())
+    {
+        return RejectedPromise(env, Napi::TypeError::New(env, "String, Number and Number expected"));
+    }
+
+    std::string monitorId = info[0].As<Napi::String>().Utf8Value();
+    int brightness = info[1].As<Napi::Number>().Int32Value();
+    int durationMs = info[2].As<Napi::Number>().Int32Value();
+
+    // Clamp brightness to 0-100
+    if (brightness < 0)
+        brightness = 0;
+    if (brightness > 100)
+        brightness = 100;
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    // Results are delivered through the thread-safe function, i.e. on a later
+    // turn of this thread's event loop, so registering after SetTarget is safe
+    TraceRequestScope request(GetTraceIdArg(info, 3));
+    uint64_t token = GetAnimator(env).SetTarget(monitorId, brightness, durationMs);
+    g_pendingTransitions.emplace(token, deferred);
+
+    return deferred.Promise();
+}
+
+// ============================================================================
+// Polling Snapshot
+// ============================================================================
+// UI polling reads brightness into a caller-owned Int32Array and receives the
+// monitor descriptors as one persistent object that is only rebuilt when the
+// topology version moves, so a steady-state poll allocates nothing on either
+// side of the boundary.
+
+// Descriptor set last handed to JS and its topology version (JS thread only)
+static Napi::ObjectReference g_descriptorSet;
+static unsigned long g_descriptorVersion = 0;
+
+/**
+ * N-API: Get the immutable part of every monitor
+ * Never enumerates; the same object is returned until the topology changes
+ * Returns: { version, monitors: [{ id, name, type, min, max }] }, or null
+ *          while the monitor list is being rebuilt
+ */
+Napi::Value GetMonitorDescriptors(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    MonitorCache::SnapshotPtr snapshot = g_monitorCache.TryGetSnapshot();
+    if (!snapshot)
+    {
+        return env.Null();
+    }
+
+    if (g_descriptorSet.IsEmpty() || g_descriptorVersion != snapshot->version)
+    {
+        Napi::Array monitors = Napi::Array::New(env, snapshot->monitors.size());
+        for (size_t i = 0; i < snapshot->monitors.size(); i++)
+        {
+            monitors[i] = DescriptorToObject(env, snapshot->monitors[i]->GetDescriptor());
+        }
+
+        Napi::Object set = Napi::Object::New(env);
+        set.Set("version", Napi::Number::New(env, static_cast<double>(snapshot->version)));
+        set.Set("monitors", monitors);
+
+        g_descriptorSet = Napi::Persistent(set);
+        g_descriptorVersion = snapshot->version;
+    }
+
+    return g_descriptorSet.Value();
+}
+
+/**
+ * N-API: Fill an Int32Array with the brightness of every monitor
+ * Answers purely from memory, in the order of getMonitorDescriptors();
+ * probing monitors read -1
+ * Args: values (Int32Array) - at least one element per monitor
+ * Returns: Topology version of the values, or -1 if enumeration or a
+ *          hardware read would be needed (use getMonitorsAsync instead)
+ */
+Napi::Value ReadBrightnessSnapshot(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsTypedArray() ||
+        info[0].As<Napi::TypedArray>().TypedArrayType() != napi_int32_array)
+    {
+        Napi::TypeError::New(env, "Expected values (Int32Array)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Int32Array values = info[0].As<Napi::Int32Array>();
+
+    // The snapshot is shared, not copied, so polling allocates nothing
+    MonitorCache::SnapshotPtr snapshot = g_monitorCache.TryGetSnapshot();
+    bool complete = snapshot && snapshot->monitors.size() <= values.ElementLength();
+
+    for (size_t i = 0; complete && i < snapshot->monitors.size(); i++)
+    {
+        const std::shared_ptr<IMonitor> &monitor = snapshot->monitors[i];
+        int brightness = -1;
+        if (monitor->IsProbed())
+        {
+            complete = g_brightnessCache.Lookup(monitor, brightness);
+            if (complete)
+            {
+                MonitorStats::Instance().RecordCacheHit();
+            }
+        }
+        values[i] = brightness;
+    }
+
+    return Napi::Number::New(env, complete ? static_cast<double>(snapshot->version) : -1);
+}
+
+// ============================================================================
+// Shared State
+// ============================================================================
+
+// Segment as seen by readSharedState (JS thread only)
+static StateSegmentReader g_stateReader;
+
+/**
+ * N-API: Read the shared state segment
+ * Never enumerates or touches the hardware: the main process reads its own
+ * segment, other processes with this addon map the published one. Renderers
+ * use the brightsync_state module (state_reader.cc) instead.
+ * Returns: { version, monitors: [{ id, name, type, min, max, current, probing,
+ *          responding }] }, or null if no segment is published
+ */
+Napi::Value ReadSharedState(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (!g_stateReader.IsOpen())
+    {
+        const std::atomic<uint32_t> *words = g_stateSegment.GetWords();
+        if (words)
+        {
+            g_stateReader.Attach(words);
+        }
+        else if (!g_stateReader.Open(STATE_SEGMENT_NAME))
+        {
+            return env.Null();
+        }
+    }
+
+    SharedState state;
+    if (!g_stateReader.Read(state))
+    {
+        return env.Null();
+    }
+
+    Napi::Array monitors = Napi::Array::New(env, state.monitors.size());
+    for (size_t i = 0; i < state.monitors.size(); i++)
+    {
+        const SharedMonitorState &monitor = state.monitors[i];
+        Napi::Object obj = DescriptorToObject(env, monitor.descriptor);
+        obj.Set("current", Napi::Number::New(env, monitor.brightness));
+        obj.Set("probing", Napi::Boolean::New(env, monitor.probing));
+        obj.Set("responding", Napi::Boolean::New(env, monitor.responding));
+        monitors[i] = obj;
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("version", Napi::Number::New(env, state.topologyVersion));
+    result.Set("monitors", monitors);
+    return result;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * Convert a latency histogram to { count, meanMs, maxMs, p50Ms, p95Ms, p99Ms }
+ */
+static Napi::Object LatencyToObject(Napi::Env env, const LatencyHistogram::Snapshot &latency)
+{
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("count", Napi::Number::New(env, static_cast<double>(latency.count)));
+    obj.Set("meanMs", Napi::Number::New(env, latency.MeanMs()));
+    obj.Set("maxMs", Napi::Number::New(env, latency.maxMs));
+    obj.Set("p50Ms", Napi::Number::New(env, latency.PercentileMs(50)));
+    obj.Set("p95Ms", Napi::Number::New(env, latency.PercentileMs(95)));
+    obj.Set("p99Ms", Napi::Number::New(env, latency.PercentileMs(99)));
+    return obj;
+}
+
+/**
+ * N-API: Get native counters and latencies
+ * Args: reset (boolean, optional) - set all counters back to zero afterwards
+ * Returns: { monitors: { [id]: {...} }, enumeration, cache, writeQueue }
+ */
+Napi::Value GetStats(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    MonitorStats &stats = MonitorStats::Instance();
+    StatsSnapshot snapshot = stats.Read();
+
+    if (info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value())
+    {
+        stats.Reset();
+    }
+
+    Napi::Object monitors = Napi::Object::New(env);
+    for (const auto &monitor : snapshot.monitors)
+    {
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("reads", Napi::Number::New(env, static_cast<double>(monitor.reads)));
+        obj.Set("readFailures", Napi::Number::New(env, static_cast<double>(monitor.readFailures)));
+        obj.Set("writes", Napi::Number::New(env, static_cast<double>(monitor.writes)));
+        obj.Set("writeFailures", Napi::Number::New(env, static_cast<double>(monitor.writeFailures)));
+        obj.Set("retries", Napi::Number::New(env, static_cast<double>(monitor.retries)));
+        obj.Set("readLatency", LatencyToObject(env, monitor.readLatency));
+        obj.Set("writeLatency", LatencyToObject(env, monitor.writeLatency));
+        monitors.Set(monitor.id, obj);
+    }
+
+    Napi::Object cache = Napi::Object::New(env);
+    cache.Set("hits", Napi::Number::New(env, static_cast<double>(snapshot.cacheHits)));
+    cache.Set("misses", Napi::Number::New(env, static_cast<double>(snapshot.cacheMisses)));
+
+    Napi::Object writeQueue = Napi::Object::New(env);
+    writeQueue.Set("depth", Napi::Number::New(env, static_cast<double>(g_writeQueue.GetDepth())));
+    writeQueue.Set("coalesced", Napi::Number::New(env, static_cast<double>(snapshot.writesCoalesced)));
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("monitors", monitors);
+    result.Set("enumeration", LatencyToObject(env, snapshot.enumeration));
+    result.Set("cache", cache);
+    result.Set("writeQueue", writeQueue);
+    return result;
+}
+
+// ============================================================================
+// Request Tracing
+// ============================================================================
+
+/**
+ * N-API: Turn per-request tracing on or off
+ * Args: enabled (boolean) - turning it on discards earlier events
+ */
+Napi::Value SetTracing(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBoolean())
+    {
+        Napi::TypeError::New(env, "Boolean expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    TraceRecorder::SetEnabled(info[0].As<Napi::Boolean>().Value());
+    return env.Undefined();
+}
+
+/**
+ * N-API: Read the clock native trace events are stamped with
+ * Returns: microseconds (monotonic)
+ */
+Napi::Value TraceNow(const Napi::CallbackInfo &info)
+{
+    return Napi::Number::New(info.Env(), static_cast<double>(TraceRecorder::NowUs()));
+}
+
+/**
+ * N-API: Take the native trace events recorded so far
+ * Returns: { events: [{ name, cat, traceId, ts, dur, tid, monitorId? }],
+ *            threads: [{ tid, name }], dropped }
+ */
+Napi::Value DrainTrace(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    std::vector<TraceEvent> events = TraceRecorder::Drain();
+    std::vector<TraceThread> threads = TraceRecorder::GetThreads();
+
+    Napi::Array eventArray = Napi::Array::New(env, events.size());
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const TraceEvent &event = events[i];
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("name", Napi::String::New(env, event.name));
+        obj.Set("cat", Napi::String::New(env, event.category));
+        obj.Set("traceId", Napi::Number::New(env, static_cast<double>(event.requestId)));
+        obj.Set("ts", Napi::Number::New(env, static_cast<double>(event.startUs)));
+        obj.Set("dur", Napi::Number::New(env, static_cast<double>(event.durationUs)));
+        obj.Set("tid", Napi::Number::New(env, event.threadId));
+        if (!event.monitorId.empty())
+        {
+            obj.Set("monitorId", Napi::String::New(env, event.monitorId));
+        }
+        eventArray[i] = obj;
+    }
+
+    Napi::Array threadArray = Napi::Array::New(env, threads.size());
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("tid", Napi::Number::New(env, threads[i].id));
+        obj.Set("name", Napi::String::New(env, threads[i].name));
+        threadArray[i] = obj;
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("events", eventArray);
+    result.Set("threads", threadArray);
+    result.Set("dropped", Napi::Number::New(env, static_cast<double>(TraceRecorder::GetDroppedCount())));
+    return result;
+}
+
+// ============================================================================
+// Native Log Forwarding
+// ============================================================================
+
+// Set while a JS log handler is installed (JS thread only)
+static Napi::ThreadSafeFunction g_logCallback;
+static bool g_logForwarding = false;
+
+/**
+ * Pass a batch of log messages to the JS handler (runs on the JS thread)
+ */
+static void DeliverLogBatch(Napi::Env env, Napi::Function callback, std::vector<LogEntry> *batch)
+{
+    Napi::Array entries = Napi::Array::New(env, batch->size());
+    for (size_t i = 0; i < batch->size(); i++)
+    {
+        const LogEntry &entry = (*batch)[i];
+        double time = (double)std::chrono::duration_cast<std::chrono::milliseconds>(
+                          entry.time.time_since_epoch())
+                          .count();
+
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("level", Napi::String::New(env, NativeLog::LevelName(entry.level)));
+        obj.Set("time", Napi::Number::New(env, time));
+        obj.Set("message", Napi::String::New(env, entry.message));
+        entries.Set((uint32_t)i, obj);
+    }
+    delete batch;
+
+    callback.Call({entries});
+}
+
+/**
+ * Send native log messages back to stdout and release the JS handler
+ */
+static void StopLogForwarding()
+{
+    if (g_logForwarding)
+    {
+        // Returns once the log thread no longer uses the handler
+        NativeLog::SetSink(LogSink());
+        g_logCallback.Release();
+        g_logForwarding = false;
+    }
+}
+
+/**
+ * N-API: Forward native log messages to JavaScript
+ * Args: handler (function receiving { level, time, message }[]) or null
+ * Returns: undefined
+ *
+ * Messages are delivered in batches from the native log thread instead of
+ * being written to stdout. Pass null to go back to stdout.
+ */
+Napi::Value SetLogHandler(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !(info[0].IsFunction() || info[0].IsNull() || info[0].IsUndefined()))
+    {
+        Napi::TypeError::New(env, "Function or null expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    StopLogForwarding();
+
+    if (info[0].IsFunction())
+    {
+        g_logCallback = Napi::ThreadSafeFunction::New(
+            env, info[0].As<Napi::Function>(), "NativeLog", 0, 1);
+
+        // An installed handler must not keep the process alive
+        g_logCallback.Unref(env);
+        g_logForwarding = true;
+
+        Napi::ThreadSafeFunction callback = g_logCallback;
+        NativeLog::SetSink([callback](const std::vector<LogEntry> &entries)
+                           {
+            std::vector<LogEntry> *copy = new std::vector<LogEntry>(entries);
+            if (callback.NonBlockingCall(copy, DeliverLogBatch) != napi_ok)
+            {
+                delete copy;
+            } });
+    }
+
+    return env.Undefined();
+}
+
+// ============================================================================
+// Change Notifications
+// ============================================================================
+
+// Default and shortest time between background samples
+static const int DEFAULT_CHANGE_SAMPLE_MS = 3000;
+static const int MIN_CHANGE_SAMPLE_MS = 500;
+
+// Set while a JS change handler is installed (JS thread only)
+static Napi::ThreadSafeFunction g_changeCallback;
+static bool g_changeForwarding = false;
+static int g_changeSampleMs = DEFAULT_CHANGE_SAMPLE_MS;
+
+// Samples externals (all monitors in mock mode, or without panel events)
+static BrightnessWatcher g_brightnessWatcher;
+
+// WmiMonitorBrightnessEvent listener for internal panels (real mode only)
+static PanelEventWatcher g_panelEvents;
+
+/**
+ * Pass one change to the JS handler (runs on the JS thread)
+ */
+static void DeliverBrightnessChange(Napi::Env env, Napi::Function callback, BrightnessChange *change)
+{
+    Napi::Object event = Napi::Object::New(env);
+    event.Set("monitorId", Napi::String::New(env, change->id));
+    event.Set("oldValue", Napi::Number::New(env, change->previous));
+    event.Set("newValue", Napi::Number::New(env, change->current));
+    delete change;
+
+    callback.Call({event});
+}
+
+/**
+ * Record a change found by a watcher and queue it for JS (watcher threads)
+ */
+static void ReportBrightnessChange(const BrightnessChange &change)
+{
+    MonitorCache::SnapshotPtr snapshot = g_monitorCache.TryGetSnapshot();
+    std::shared_ptr<IMonitor> monitor = snapshot ? snapshot->Find(change.id) : nullptr;
+
+    if (monitor)
+    {
+        // The change is the freshest value there is; later reads use it
+        StoreBrightness(monitor, change.current);
+        g_writeQueue.Observe(monitor, change.current);
+    }
+
+    BS_LOG_DEBUG("Brightness of " << change.id << " changed outside BrightSync: "
+                                  << change.previous << " -> " << change.current);
+
+    BrightnessChange *copy = new BrightnessChange(change);
+    if (g_changeCallback.NonBlockingCall(copy, DeliverBrightnessChange) != napi_ok)
+    {
+        delete copy;
+    }
+}
+
+/**
+ * Monitors the background sampler reads in one round
+ */
+static std::vector<std::shared_ptr<IMonitor>> GetSampledMonitors()
+{
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+
+    // Never enumerate from the sampler and leave the buses to pending writes
+    if (!g_monitorCache.TryGetMonitors(monitors) || g_writeQueue.GetDepth() > 0)
+    {
+        return std::vector<std::shared_ptr<IMonitor>>();
+    }
+
+    // The steps of a hardware fade are not external changes
+    bool skipPanels = !g_mockMode && g_panelEvents.IsListening();
+    monitors.erase(std::remove_if(monitors.begin(), monitors.end(),
+                                  [skipPanels](const std::shared_ptr<IMonitor> &monitor)
+                                  { return (skipPanels && monitor->GetType() == MonitorType::Internal) ||
+                                           g_writeQueue.IsFading(monitor); }),
+                   monitors.end());
+
+    return monitors;
+}
+
+/**
+ * Read the internal panels after a WMI brightness event (panel event thread)
+ */
+static void OnPanelEvent(const WmiPanel &)
+{
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+    if (!g_monitorCache.TryGetMonitors(monitors))
+    {
+        return;
+    }
+
+    // A panel that is fading raises events for its own steps
+    std::vector<std::shared_ptr<IMonitor>> panels;
+    for (const auto &monitor : monitors)
+    {
+        if (monitor->GetType() == MonitorType::Internal && !g_writeQueue.IsFading(monitor))
+        {
+            panels.push_back(monitor);
+        }
+    }
+
+    BrightnessWatcher::Sample(panels, ReportBrightnessChange);
+}
+
+/**
+ * Start the change sources for the current mode
+ */
+static void StartChangeSources()
+{
+    g_panelEvents.Stop();
+    if (!g_mockMode)
+    {
+        g_panelEvents.Start(OnPanelEvent);
+    }
+
+    g_brightnessWatcher.Start(GetSampledMonitors, ReportBrightnessChange,
+                              std::chrono::milliseconds(g_changeSampleMs));
+}
+
+/**
+ * Stop the change sources and release the JS handler
+ */
+static void StopChangeForwarding()
+{
+    if (g_changeForwarding)
+    {
+        // Both threads are joined, so no call can reach the handler afterwards
+        g_brightnessWatcher.Stop();
+        g_panelEvents.Stop();
+        g_changeCallback.Release();
+        g_changeForwarding = false;
+    }
+}
+
+/**
+ * N-API: Push brightness changes made outside BrightSync to JavaScript
+ * Args: handler (function receiving { monitorId, oldValue, newValue }) or null,
+ *       sampleIntervalMs (optional, default 3000, at least 500)
+ * Returns: undefined
+ *
+ * Internal panels report through WmiMonitorBrightnessEvent; external
+ * monitors are read once per interval in the background. Values written by
+ * BrightSync are not reported. Pass null to stop.
+ */
+Napi::Value OnBrightnessChanged(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !(info[0].IsFunction() || info[0].IsNull() || info[0].IsUndefined()))
+    {
+        Napi::TypeError::New(env, "Function or null expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    StopChangeForwarding();
+
+    if (info[0].IsFunction())
+    {
+        int sampleMs = DEFAULT_CHANGE_SAMPLE_MS;
+        if (info.Length() > 1 && info[1].IsNumber())
+        {
+            sampleMs = std::max(MIN_CHANGE_SAMPLE_MS, info[1].As<Napi::Number>().Int32Value());
+        }
+
+        g_changeCallback = Napi::ThreadSafeFunction::New(
+            env, info[0].As<Napi::Function>(), "BrightnessChanged", 0, 1);
+
+        // An installed handler must not keep the process alive
+        g_changeCallback.Unref(env);
+        g_changeForwarding = true;
+        g_changeSampleMs = sampleMs;
+
+        StartChangeSources();
+    }
+
+    return env.Undefined();
+}
+
+// ============================================================================
+// Deferred Discovery
+// ============================================================================
+
+// Runs the first enumeration and probes after initialize({ deferHardware: true })
+static std::thread g_discoveryThread;
+
+// Pending whenHardwareReady promises (JS thread only)
+static std::vector<Napi::Promise::Deferred> g_readyPromises;
+
+/**
+ * Remember the current monitors and their brightness for the next launch
+ * Never touches the hardware; monitors without a known value keep the
+ * value saved last time
+ */
+static void SaveKnownDisplays()
+{
+    MonitorCache::SnapshotPtr snapshot = g_monitorCache.TryGetSnapshot();
+    if (g_mockMode || !snapshot)
+    {
+        return;
+    }
+
+    std::vector<KnownDisplay> previous = g_capabilityStore.GetDisplays();
+    std::vector<KnownDisplay> displays;
+    displays.reserve(snapshot->monitors.size());
+    for (const auto &monitor : snapshot->monitors)
+    {
+        KnownDisplay display;
+        display.id = monitor->GetId();
+        display.name = monitor->GetName();
+        display.type = monitor->GetType();
+        if (monitor->IsProbed() && monitor->IsControllable())
+        {
+            display.brightness = monitor->GetLastKnownBrightness();
+        }
+        else
+        {
+            for (const auto &known : previous)
+            {
+                if (known.id == display.id)
+                {
+                    display.brightness = known.brightness;
+                }
+            }
+        }
+        displays.push_back(display);
+    }
+
+    g_capabilityStore.SetDisplays(displays);
+}
+
+/**
+ * Resolve all whenHardwareReady promises (runs on the JS thread)
+ */
+static void ResolveReadyPromises(Napi::Env env)
+{
+    for (auto &deferred : g_readyPromises)
+    {
+        deferred.Resolve(Napi::Boolean::New(env, true));
+    }
+    g_readyPromises.clear();
+}
+
+/**
+ * Body of the discovery thread
+ * @param ready Released here after signalling the JS thread
+ */
+static void RunDeferredDiscovery(Napi::ThreadSafeFunction ready)
+{
+    try
+    {
+        // Probe() waits for the background probe every new monitor already has
+        MonitorCache::SnapshotPtr snapshot = g_monitorCache.GetSnapshot();
+        for (const auto &monitor : snapshot->monitors)
+        {
+            monitor->Probe();
+        }
+        SaveKnownDisplays();
+    }
+    catch (const std::exception &e)
+    {
+        BS_LOG_ERROR("ERROR: Deferred monitor discovery failed: " << e.what());
+    }
+
+    g_discoveryPending = false;
+    ready.NonBlockingCall([](Napi::Env env, Napi::Function)
+                          { ResolveReadyPromises(env); });
+    ready.Release();
+}
+
+/**
+ * Wait for a running discovery thread
+ */
+static void JoinDiscovery()
+{
+    if (g_discoveryThread.joinable())
+    {
+        g_discoveryThread.join();
+    }
+}
+
+/**
+ * Start discovering monitors in the background
+ * Until it finishes, getMonitors answers with the last session's topology
+ */
+static void StartDeferredDiscovery(Napi::Env env)
+{
+    JoinDiscovery();
+
+    Napi::ThreadSafeFunction ready = Napi::ThreadSafeFunction::New(
+        env, Napi::Function::New(env, [](const Napi::CallbackInfo &) {}), "HardwareReady", 0, 1);
+
+    // A pending discovery must not keep the process alive
+    ready.Unref(env);
+
+    g_discoveryPending = true;
+    try
+    {
+        g_discoveryThread = std::thread(RunDeferredDiscovery, ready);
+    }
+    catch (const std::system_error &)
+    {
+        // The first getMonitors discovers instead
+        BS_LOG_WARN("WARNING: Could not start deferred monitor discovery");
+        g_discoveryPending = false;
+        ready.Release();
+        ResolveReadyPromises(env);
+    }
+}
+
+/**
+ * N-API: Wait until deferred discovery has finished
+ * Args: none
+ * Returns: Promise<true>, already resolved when nothing is pending
+ *
+ * After initialize({ deferHardware: true }) getMonitors first reports the
+ * monitors of the last session (provisional: true); once this resolves it
+ * reports the real ones.
+ */
+Napi::Value WhenHardwareReady(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    // Cleared before the ready callback is queued, so nothing is missed
+    if (g_discoveryPending)
+    {
+        g_readyPromises.push_back(deferred);
+    }
+    else
+    {
+        deferred.Resolve(Napi::Boolean::New(env, true));
+    }
+    return deferred.Promise();
+}
+
+// ============================================================================
+// Mock Topology
+// ============================================================================
+
+/**
+ * Read an optional number property
+ */
+static double GetNumberOr(const Napi::Object &obj, const char *key, double fallback)
+{
+    Napi::Value value = obj.Get(key);
+    return value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : fallback;
+}
+
+/**
+ * Read an optional string property
+ */
+static std::string GetStringOr(const Napi::Object &obj, const char *key, const std::string &fallback)
+{
+    Napi::Value value = obj.Get(key);
+    return value.IsString() ? value.As<Napi::String>().Utf8Value() : fallback;
+}
+
+/**
+ * Build a topology from an array of display entries:
+ * { type, count?, id?, name?, brightness?, maxValue?, timing?: "instant" | "ddc" | "wmi",
+ *   readLatencyMs?, writeLatencyMs?, jitterMs?, failureRate?, connectAtMs?, disconnectAtMs? }
+ * Entries that are not objects are skipped
+ */
+static MockTopology ParseMockTopology(const Napi::Array &entries)
+{
+    MockTopology topology;
+
+    for (uint32_t i = 0; i < entries.Length(); i++)
+    {
+        Napi::Value entryValue = entries.Get(i);
+        if (!entryValue.IsObject())
+        {
+            BS_LOG_WARN("[MOCK MODE] Ignoring mock topology entry " << i << ": object expected");
+            continue;
+        }
+        Napi::Object entry = entryValue.As<Napi::Object>();
+
+        MockDisplay display;
+        display.type = GetStringOr(entry, "type", "external") == "internal" ? "internal" : "external";
+        display.id = GetStringOr(entry, "id", "");
+        display.name = GetStringOr(entry, "name", "");
+        display.brightness = static_cast<int>(GetNumberOr(entry, "brightness", 50));
+        display.maxValue = static_cast<int>(GetNumberOr(entry, "maxValue", 100));
+        display.connectAtMs = static_cast<int>(GetNumberOr(entry, "connectAtMs", 0));
+        display.disconnectAtMs = static_cast<int>(GetNumberOr(entry, "disconnectAtMs", -1));
+
+        // Start from a preset, then apply individual overrides
+        std::string preset = GetStringOr(entry, "timing", "instant");
+        if (preset == "ddc")
+        {
+            display.timing = MockTiming::Ddc();
+        }
+        else if (preset == "wmi")
+        {
+            display.timing = MockTiming::Wmi();
+        }
+        display.timing.readLatencyUs = static_cast<int>(GetNumberOr(entry, "readLatencyMs", display.timing.readLatencyUs / 1000.0) * 1000);
+        display.timing.writeLatencyUs = static_cast<int>(GetNumberOr(entry, "writeLatencyMs", display.timing.writeLatencyUs / 1000.0) * 1000);
+        display.timing.jitterUs = static_cast<int>(GetNumberOr(entry, "jitterMs", display.timing.jitterUs / 1000.0) * 1000);
+        display.timing.failureRate = GetNumberOr(entry, "failureRate", display.timing.failureRate);
+        display.timing.rampResolutionMs = static_cast<int>(GetNumberOr(entry, "hardwareRampMs", 0));
+
+        int count = static_cast<int>(GetNumberOr(entry, "count", 1));
+        topology.Add(display, count > 0 ? count : 0);
+    }
+
+    return topology;
+}
+
+/**
+ * N-API: Initialize the addon with configuration
+ * Args: config object with { mockMode: boolean, brightnessCacheMs?: number,
+ *       capabilityCachePath?: string, logLevel?: string, mockTopology?: array,
+ *       deferHardware?: boolean }
+ * Returns: success (boolean)
+ *
+ * With deferHardware the monitors are discovered on a background thread
+ * (see whenHardwareReady); otherwise the first getMonitors discovers them.
+ * A discovery still running from an earlier call is waited for.
+ */
+Napi::Value Initialize(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    try
+    {
+        std::string capabilityCachePath;
+        std::shared_ptr<const MockTopology> topology;
+        bool deferHardware = false;
+
+        // The caches are reset below
+        JoinDiscovery();
+
+        // Check if config object is provided
+        if (info.Length() > 0 && info[0].IsObject())
+        {
+            Napi::Object config = info[0].As<Napi::Object>();
+
+            // Native log level: "trace", "debug", "info" (default), "warn", "error" or "off"
+            if (config.Has("logLevel"))
+            {
+                Napi::Value levelValue = config.Get("logLevel");
+                LogLevel level;
+                if (levelValue.IsString() && NativeLog::ParseLevel(levelValue.As<Napi::String>().Utf8Value(), level))
+                {
+                    NativeLog::SetLevel(level);
+                }
+            }
+
+            // Get mockMode flag
+            if (config.Has("mockMode"))
+            {
+                Napi::Value mockModeValue = config.Get("mockMode");
+                if (mockModeValue.IsBoolean())
+                {
+                    g_mockMode = mockModeValue.As<Napi::Boolean>().Value();
+
+                    if (g_mockMode)
+                    {
+                        BS_LOG_INFO("[MOCK MODE] Hardware abstraction layer initialized in MOCK mode");
+                        BS_LOG_INFO("[MOCK MODE] All monitor operations will be simulated");
+                    }
+                    else
+                    {
+                        BS_LOG_INFO("Hardware abstraction layer initialized in REAL mode");
+                    }
+                }
+            }
+
+            // Staleness window for cached brightness reads (0 = always read hardware)
+            if (config.Has("brightnessCacheMs"))
+            {
+                Napi::Value cacheValue = config.Get("brightnessCacheMs");
+                if (cacheValue.IsNumber())
+                {
+                    int cacheMs = cacheValue.As<Napi::Number>().Int32Value();
+                    g_brightnessCache.SetMaxAge(std::chrono::milliseconds(cacheMs < 0 ? 0 : cacheMs));
+                }
+            }
+
+            // Discover monitors in the background instead of on the first getMonitors
+            if (config.Has("deferHardware"))
+            {
+                Napi::Value deferValue = config.Get("deferHardware");
+                deferHardware = deferValue.IsBoolean() && deferValue.As<Napi::Boolean>().Value();
+            }
+
+            // File remembering DDC/CI capabilities between launches
+            if (config.Has("capabilityCachePath"))
+            {
+                Napi::Value pathValue = config.Get("capabilityCachePath");
+                if (pathValue.IsString())
+                {
+                    capabilityCachePath = pathValue.As<Napi::String>().Utf8Value();
+                }
+            }
+
+            // Simulated displays for mock mode (default: 1 internal, 2 external)
+            if (config.Has("mockTopology"))
+            {
+                Napi::Value topologyValue = config.Get("mockTopology");
+                if (topologyValue.IsArray())
+                {
+                    topology = std::make_shared<MockTopology>(ParseMockTopology(topologyValue.As<Napi::Array>()));
+                }
+            }
+        }
+
+        // A new topology also restarts its hotplug timeline
+        if (!topology)
+        {
+            topology = std::make_shared<MockTopology>(MockTopology::Default());
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_mockTopologyMutex);
+            g_mockTopology = topology;
+        }
+
+        // Rebuild the list as soon as it is invalidated, so the sampler and the
+        // memory-only exports do not wait for a blocking reader
+        g_monitorCache.StartRebuilder();
+
+        // Watch for display changes when talking to real hardware; replay the
+        // simulated hotplug events in mock mode
+        if (g_mockMode)
+        {
+            g_displayWatcher.Stop();
+            g_mockHotplug.Start(topology, []()
+                                { g_monitorCache.Invalidate(); });
+        }
+        else
+        {
+            g_mockHotplug.Stop();
+            if (!g_displayWatcher.Start([]()
+                                        { g_monitorCache.Invalidate(); }))
+            {
+                BS_LOG_WARN("WARNING: Display change notifications unavailable; monitor list will not refresh on hotplug");
+            }
+        }
+
+        // The next enumeration fills the table
+        if (!g_stateSegment.IsOpen() && !g_stateSegment.Create(STATE_SEGMENT_NAME))
+        {
+            BS_LOG_WARN("WARNING: Shared state segment unavailable; other processes must use IPC");
+        }
+
+        // Clear cache to force reinitialization with new mode
+        std::vector<std::shared_ptr<IMonitor>> previous;
+        g_monitorCache.TryGetMonitors(previous);
+        g_monitorCache.Clear();
+        for (const auto &monitor : previous)
+        {
+            RetireMonitor(monitor);
+        }
+        g_writeQueue.Clear();
+        g_brightnessCache.Clear();
+
+        // An installed change handler follows the new mode
+        if (g_changeForwarding)
+        {
+            StartChangeSources();
+        }
+        StartHealthWatcher();
+
+        // Load before the next enumeration so new monitors pick it up
+        if (!g_mockMode && g_capabilityStore.Load(capabilityCachePath))
+        {
+            BS_LOG_INFO("Loaded capabilities of " << g_capabilityStore.Size() << " monitors");
+        }
+
+        if (deferHardware)
+        {
+            StartDeferredDiscovery(env);
+        }
+
+        return Napi::Boolean::New(env, true);
+    }
+    catch (const std::exception &e)
+    {
+        Napi::Error::New(env, std::string("Failed to initialize: ") + e.what()).ThrowAsJavaScriptException();
+        return Napi::Boolean::New(env, false);
+    }
+}
+
+/**
+ * Initialize N-API module
+ */
+Napi::Object Init(Napi::Env env, Napi::Object exports)
+{
+    // Join the animator, watcher, rebuild, health, discovery, probe and hardware threads before the
+    // module is unloaded; the topology is saved for a deferred start next time
+    env.AddCleanupHook([]()
+                       { StopAnimator(); StopChangeForwarding(); g_displayWatcher.Stop(); g_mockHotplug.Stop(); g_monitorCache.StopRebuilder(); g_healthWatcher.Stop(); JoinDiscovery(); g_prober.Wait(); SaveKnownDisplays(); HardwareExecutor::Instance().Shutdown(); StopLogForwarding(); g_descriptorSet.Reset(); NativeLog::Flush(); });
+
+    // Trace events of the JS thread (N-API entry points) show under this name
+    TraceRecorder::NameThread("JavaScript");
+
     // Export functions
     exports.Set("initialize", Napi::Function::New(env, Initialize));
     exports.Set("getMonitors", Napi::Function::New(env, GetMonitors));
     exports.Set("getBrightness", Napi::Function::New(env, GetBrightness));
     exports.Set("setBrightness", Napi::Function::New(env, SetBrightness));
+    exports.Set("getMonitorsAsync", Napi::Function::New(env, GetMonitorsAsync));
+    exports.Set("getBrightnessAsync", Napi::Function::New(env, GetBrightnessAsync));
+    exports.Set("setBrightnessAsync", Napi::Function::New(env, SetBrightnessAsync));
+    exports.Set("setBrightnessBatch", Napi::Function::New(env, SetBrightnessBatch));
+    exports.Set("setBrightnessTarget", Napi::Function::New(env, SetBrightnessTarget));
+    exports.Set("setLogHandler", Napi::Function::New(env, SetLogHandler));
+    exports.Set("getStats", Napi::Function::New(env, GetStats));
+    exports.Set("getMonitorDescriptors", Napi::Function::New(env, GetMonitorDescriptors));
+    exports.Set("readBrightnessSnapshot", Napi::Function::New(env, ReadBrightnessSnapshot));
+    exports.Set("readSharedState", Napi::Function::New(env, ReadSharedState));
+    exports.Set("onBrightnessChanged", Napi::Function::New(env, OnBrightnessChanged));
+    exports.Set("whenHardwareReady", Napi::Function::New(env, WhenHardwareReady));
+    exports.Set("setTracing", Napi::Function::New(env, SetTracing));
+    exports.Set("traceNow", Napi::Function::New(env, TraceNow));
+    exports.Set("drainTrace", Napi::Function::New(env, DrainTrace));
 
     return exports;
 }
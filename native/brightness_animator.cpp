@@ -0,0 +1,415 @@
+/**
+ * BrightSync - Brightness Animator Implementation
+ */
+
+#include "brightness_animator.h"
+#include "trace_recorder.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <system_error>
+
+typedef std::chrono::steady_clock Clock;
+
+// Weight of the newest sample in the write latency moving average
+static const double LATENCY_SMOOTHING = 0.25;
+
+// ============================================================================
+// Track State
+// ============================================================================
+
+struct BrightnessAnimator::Track
+{
+    std::string id;
+    std::thread thread;
+
+    // Guarded by mutex
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    bool removed = false;    // monitor is gone; requests fail instead of being dropped
+    bool hasRequest = false; // a target the thread has not picked up yet
+    uint64_t token = 0;
+    int target = 0;
+    int durationMs = 0;
+    TraceHandoff handoff; // trace request that set the target
+    int value = -1;         // last confirmed brightness
+    double latencyMs = -1.0; // moving average of SetBrightness duration
+
+    std::atomic<bool> finished{false}; // thread has left RunTrack
+};
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+BrightnessAnimator::BrightnessAnimator(MonitorLookup lookup, CompletionCallback onComplete, int minStepIntervalMs,
+                                       BrightnessWriter write, BrightnessReader read, BrightnessRampWriter rampWrite)
+    : m_lookup(lookup), m_onComplete(onComplete), m_write(write), m_read(read), m_rampWrite(rampWrite),
+      m_minStepIntervalMs(std::max(1, minStepIntervalMs)),
+      m_nextToken(0), m_stopped(false)
+{
+}
+
+BrightnessAnimator::~BrightnessAnimator()
+{
+    Stop();
+}
+
+uint64_t BrightnessAnimator::SetTarget(const std::string &id, int target, int durationMs)
+{
+    uint64_t token = ++m_nextToken;
+    std::shared_ptr<Track> track;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_stopped)
+        {
+            std::shared_ptr<Track> &slot = m_tracks[id];
+            if (!slot)
+            {
+                slot = std::make_shared<Track>();
+                slot->id = id;
+                try
+                {
+                    slot->thread = std::thread(&BrightnessAnimator::RunTrack, this, slot);
+                }
+                catch (const std::system_error &)
+                {
+                    slot.reset();
+                    m_tracks.erase(id);
+                }
+            }
+            track = slot;
+        }
+    }
+
+    if (!track)
+    {
+        m_onComplete({token, id, -1, false, false, false});
+        return token;
+    }
+
+    // Replace a target the track has not started on yet
+    AnimationResult replaced = {0, id, -1, false, true, false};
+    {
+        std::lock_guard<std::mutex> lock(track->mutex);
+        if (track->hasRequest)
+        {
+            replaced.token = track->token;
+            replaced.value = track->value;
+        }
+        track->token = token;
+        track->target = target;
+        track->durationMs = std::max(0, durationMs);
+        track->handoff = TraceHandoff();
+        track->hasRequest = true;
+    }
+    track->cv.notify_one();
+
+    if (replaced.token != 0)
+    {
+        m_onComplete(replaced);
+    }
+
+    return token;
+}
+
+double BrightnessAnimator::GetWriteLatencyMs(const std::string &id) const
+{
+    std::shared_ptr<Track> track;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_tracks.find(id);
+        if (it == m_tracks.end())
+        {
+            return -1.0;
+        }
+        track = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(track->mutex);
+    return track->latencyMs;
+}
+
+void BrightnessAnimator::RemoveTrack(const std::string &id)
+{
+    std::shared_ptr<Track> track;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        JoinFinishedTracksLocked();
+
+        auto it = m_tracks.find(id);
+        if (it == m_tracks.end())
+        {
+            return;
+        }
+        track = it->second;
+        m_tracks.erase(it);
+        m_removed.push_back(track);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(track->mutex);
+        track->stop = true;
+        track->removed = true;
+    }
+    track->cv.notify_one();
+}
+
+size_t BrightnessAnimator::GetTrackCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tracks.size();
+}
+
+void BrightnessAnimator::Stop()
+{
+    std::vector<std::shared_ptr<Track>> tracks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+        for (auto &entry : m_tracks)
+        {
+            tracks.push_back(entry.second);
+        }
+        m_tracks.clear();
+        tracks.insert(tracks.end(), m_removed.begin(), m_removed.end());
+        m_removed.clear();
+    }
+
+    for (auto &track : tracks)
+    {
+        {
+            std::lock_guard<std::mutex> lock(track->mutex);
+            track->stop = true;
+        }
+        track->cv.notify_one();
+    }
+
+    for (auto &track : tracks)
+    {
+        if (track->thread.joinable())
+        {
+            track->thread.join();
+        }
+    }
+}
+
+void BrightnessAnimator::JoinFinishedTracksLocked()
+{
+    auto finished = std::remove_if(m_removed.begin(), m_removed.end(), [](const std::shared_ptr<Track> &track)
+                                   {
+        // A track may remove itself (through the lookup); it is joined later
+        if (!track->finished || track->thread.get_id() == std::this_thread::get_id())
+        {
+            return false;
+        }
+        track->thread.join();
+        return true; });
+    m_removed.erase(finished, m_removed.end());
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void BrightnessAnimator::RunTrack(const std::shared_ptr<Track> &track)
+{
+    std::shared_ptr<IMonitor> monitor;
+    bool active = false;
+    uint64_t token = 0;
+    int target = 0;
+    int current = -1;
+    bool fading = false; // a hardware fade was cut short; the value is unknown
+    Clock::time_point deadline;
+    TraceHandoff handoff;
+
+    TraceRecorder::NameThread("animator " + track->id);
+
+    for (;;)
+    {
+        bool newRequest = false;
+        AnimationResult superseded = {0, track->id, current, false, true, false};
+        std::vector<uint64_t> failed; // requests of a removed track
+
+        {
+            std::unique_lock<std::mutex> lock(track->mutex);
+            if (!active)
+            {
+                track->cv.wait(lock, [&]
+                               { return track->stop || track->hasRequest; });
+            }
+            if (track->stop)
+            {
+                if (track->removed && active)
+                {
+                    failed.push_back(token);
+                }
+                if (track->removed && track->hasRequest)
+                {
+                    failed.push_back(track->token);
+                }
+                lock.unlock();
+
+                for (uint64_t request : failed)
+                {
+                    m_onComplete({request, track->id, -1, false, false, false});
+                }
+                break;
+            }
+            if (track->hasRequest)
+            {
+                if (active)
+                {
+                    superseded.token = token;
+                }
+                token = track->token;
+                target = track->target;
+                deadline = Clock::now() + std::chrono::milliseconds(track->durationMs);
+                handoff = track->handoff;
+                track->hasRequest = false;
+                newRequest = true;
+            }
+        }
+
+        if (superseded.token != 0)
+        {
+            m_onComplete(superseded);
+        }
+
+        if (newRequest)
+        {
+            // The steps towards this target belong to the request that set it
+            TraceRecorder::Resume(handoff, "animator wait", "queue");
+
+            std::shared_ptr<IMonitor> resolved = m_lookup(track->id);
+            if (!resolved)
+            {
+                m_onComplete({token, track->id, -1, false, false, false});
+                monitor.reset();
+                active = false;
+                current = -1;
+                continue;
+            }
+
+            // Re-read when starting from idle; mid-flight the ramp continues
+            // from the last value we wrote
+            if (resolved != monitor || !active || fading)
+            {
+                monitor = resolved;
+                current = m_read ? m_read(monitor) : monitor->GetBrightness();
+                fading = false;
+            }
+
+            target = std::max(monitor->GetMinBrightness(), std::min(monitor->GetMaxBrightness(), target));
+            active = true;
+        }
+
+        if (current == target)
+        {
+            m_onComplete({token, track->id, current, true, false, false});
+            active = false;
+            continue;
+        }
+
+        // Hand the whole transition to hardware that fades by itself
+        int resolutionMs = newRequest && current >= 0 ? monitor->GetHardwareRampResolutionMs() : 0;
+        long long budgetMs = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (resolutionMs > 0 && budgetMs >= resolutionMs)
+        {
+            int rampMs = static_cast<int>(budgetMs / resolutionMs * resolutionMs);
+            Clock::time_point writeStart = Clock::now();
+            bool success = m_rampWrite ? m_rampWrite(monitor, target, rampMs) : monitor->SetBrightnessRamped(target, rampMs);
+
+            if (!success)
+            {
+                m_onComplete({token, track->id, current, false, false, false});
+                active = false;
+                current = -1;
+                continue;
+            }
+
+            current = target;
+            bool interrupted;
+            {
+                std::unique_lock<std::mutex> lock(track->mutex);
+                track->value = target;
+                interrupted = track->cv.wait_until(lock, writeStart + std::chrono::milliseconds(rampMs), [&]
+                                                   { return track->stop || track->hasRequest; });
+            }
+
+            // A new target takes over from wherever the fade has got to
+            fading = interrupted;
+            if (!interrupted)
+            {
+                m_onComplete({token, track->id, target, true, false, true});
+                active = false;
+            }
+            continue;
+        }
+
+        // Spread the remaining distance over the steps that fit in the time
+        // budget at this monitor's write rate
+        double intervalMs = m_minStepIntervalMs;
+        {
+            std::lock_guard<std::mutex> lock(track->mutex);
+            intervalMs = std::max(intervalMs, track->latencyMs);
+        }
+
+        double remainingMs = std::chrono::duration<double, std::milli>(deadline - Clock::now()).count();
+        int stepsLeft = std::max(1, static_cast<int>(remainingMs / intervalMs));
+        int distance = target - current;
+        int step = distance / stepsLeft;
+        if (step == 0)
+        {
+            step = distance > 0 ? 1 : -1;
+        }
+        // Unknown start value (read failed): write the target directly
+        int next = current < 0 ? target : current + step;
+
+        Clock::time_point writeStart = Clock::now();
+        bool success = m_write ? m_write(monitor, next) : monitor->SetBrightness(next);
+        double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - writeStart).count();
+
+        {
+            std::lock_guard<std::mutex> lock(track->mutex);
+            track->latencyMs = track->latencyMs < 0
+                                   ? elapsedMs
+                                   : track->latencyMs + LATENCY_SMOOTHING * (elapsedMs - track->latencyMs);
+            if (success)
+            {
+                track->value = next;
+            }
+        }
+
+        if (!success)
+        {
+            m_onComplete({token, track->id, current, false, false, false});
+            active = false;
+            current = -1;
+            continue;
+        }
+
+        current = next;
+        if (current == target)
+        {
+            m_onComplete({token, track->id, current, true, false, false});
+            active = false;
+            continue;
+        }
+
+        // Keep writes at least one interval apart; a new target does not cut
+        // the wait short so the hardware is never driven faster than it accepts
+        double waitMs = intervalMs - elapsedMs;
+        if (waitMs > 0)
+        {
+            std::unique_lock<std::mutex> lock(track->mutex);
+            track->cv.wait_for(lock, std::chrono::duration<double, std::milli>(waitMs), [&]
+                               { return track->stop; });
+        }
+    }
+
+    track->finished = true;
+}
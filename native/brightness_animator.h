@@ -0,0 +1,151 @@
+/**
+ * BrightSync - Brightness Animator
+ *
+ * Native smooth transitions with coalescing of in-flight targets
+ */
+
+#ifndef BRIGHTNESS_ANIMATOR_H
+#define BRIGHTNESS_ANIMATOR_H
+
+#include "monitor_interface.h"
+#include "write_queue.h"
+#include "brightness_cache.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+/**
+ * Outcome of one animation request
+ */
+struct AnimationResult
+{
+    uint64_t token;  // value returned by SetTarget
+    std::string id;  // monitor ID
+    int value;       // brightness reached (last confirmed value)
+    bool success;    // target reached without a hardware error
+    bool superseded; // a newer target replaced this one before it finished
+    bool hardwareRamp; // the hardware faded by itself after a single write
+};
+
+/**
+ * Per-monitor brightness animator
+ *
+ * Each monitor gets a track that owns a single target value and a native
+ * thread that steps the hardware towards it. Calling SetTarget() while a
+ * transition is running replaces the target in place: the old request is
+ * reported as superseded and the ramp continues from the current value, so
+ * writes never queue up behind each other.
+ *
+ * The step interval follows the measured write latency of each monitor
+ * (moving average), and the number of steps is chosen so a transition still
+ * finishes within the requested duration. A slow DDC/CI monitor therefore
+ * gets a few large steps while an internal panel gets many small ones.
+ *
+ * Monitors that fade by themselves (IMonitor::GetHardwareRampResolutionMs)
+ * get a single ramped write instead when the time budget covers at least
+ * one unit of their resolution; the request completes when the fade has
+ * run. Shorter transitions fall back to software steps.
+ *
+ * Completion callbacks run on the track thread. All methods are thread-safe.
+ */
+class BrightnessAnimator
+{
+public:
+    /**
+     * Resolves a monitor ID; called on the track thread for every new target
+     */
+    typedef std::function<std::shared_ptr<IMonitor>(const std::string &id)> MonitorLookup;
+
+    /**
+     * Receives one result per SetTarget() call
+     */
+    typedef std::function<void(const AnimationResult &result)> CompletionCallback;
+
+    /**
+     * Constructor
+     * @param lookup Function used to resolve monitor IDs
+     * @param onComplete Function invoked when a request finishes
+     * @param minStepIntervalMs Lower bound for the time between two writes
+     * @param write Function used for each step (defaults to IMonitor::SetBrightness)
+     * @param read Function used to get the start value (defaults to IMonitor::GetBrightness)
+     * @param rampWrite Function used for hardware fades (defaults to IMonitor::SetBrightnessRamped)
+     */
+    BrightnessAnimator(MonitorLookup lookup, CompletionCallback onComplete, int minStepIntervalMs = 10,
+                       BrightnessWriter write = BrightnessWriter(), BrightnessReader read = BrightnessReader(),
+                       BrightnessRampWriter rampWrite = BrightnessRampWriter());
+
+    /**
+     * Destructor - stops all tracks
+     */
+    ~BrightnessAnimator();
+
+    BrightnessAnimator(const BrightnessAnimator &) = delete;
+    BrightnessAnimator &operator=(const BrightnessAnimator &) = delete;
+
+    /**
+     * Animate a monitor towards a target value
+     * Replaces any in-flight target of the same monitor
+     * @param id Monitor identifier
+     * @param target Target brightness (clamped to the monitor range)
+     * @param durationMs Time budget for the whole transition
+     * @return Token identifying this request in the completion callback
+     */
+    uint64_t SetTarget(const std::string &id, int target, int durationMs);
+
+    /**
+     * Measured average write latency of a monitor
+     * @return Latency in milliseconds, or -1 if nothing was written yet
+     */
+    double GetWriteLatencyMs(const std::string &id) const;
+
+    /**
+     * Drop the track of a monitor that is gone
+     * Its thread stops after the current step and is joined later (by the
+     * next RemoveTrack() or Stop()), so this never waits for the hardware.
+     * The request it was working on and a pending one complete as failed.
+     */
+    void RemoveTrack(const std::string &id);
+
+    /**
+     * Number of tracks (one per monitor animated so far and not removed)
+     */
+    size_t GetTrackCount() const;
+
+    /**
+     * Stop all tracks and join their threads
+     * Pending requests are dropped without a completion callback
+     */
+    void Stop();
+
+private:
+    struct Track;
+
+    /**
+     * Body of a track thread
+     */
+    void RunTrack(const std::shared_ptr<Track> &track);
+
+    /**
+     * Join removed tracks whose thread has exited (caller holds m_mutex)
+     */
+    void JoinFinishedTracksLocked();
+
+    MonitorLookup m_lookup;
+    CompletionCallback m_onComplete;
+    BrightnessWriter m_write;
+    BrightnessReader m_read;
+    BrightnessRampWriter m_rampWrite;
+    int m_minStepIntervalMs;
+    std::atomic<uint64_t> m_nextToken;
+    mutable std::mutex m_mutex;
+    bool m_stopped;
+    std::unordered_map<std::string, std::shared_ptr<Track>> m_tracks;
+    std::vector<std::shared_ptr<Track>> m_removed; // stopping, not joined yet
+};
+
+#endif // BRIGHTNESS_ANIMATOR_H
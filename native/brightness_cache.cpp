@@ -0,0 +1,118 @@
+/**
+ * BrightSync - Brightness Cache Implementation
+ */
+
+#include "brightness_cache.h"
+#include <limits>
+
+const int64_t BrightnessCache::NEVER_UPDATED = std::numeric_limits<int64_t>::min();
+
+/**
+ * Current time in steady_clock ticks
+ */
+static int64_t NowTicks()
+{
+    return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/**
+ * Convert a duration to steady_clock ticks
+ */
+static int64_t ToTicks(std::chrono::milliseconds duration)
+{
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration).count());
+}
+
+BrightnessCache::BrightnessCache(std::chrono::milliseconds maxAge)
+    : m_maxAge(ToTicks(maxAge)),
+      m_table(std::make_shared<Table>())
+{
+}
+
+bool BrightnessCache::Lookup(const std::shared_ptr<IMonitor> &monitor, int &value) const
+{
+    // A re-created monitor with the same ID has no entry and is read again
+    std::shared_ptr<Entry> entry = FindEntry(monitor);
+    if (!entry)
+    {
+        return false;
+    }
+
+    int64_t updated = entry->updated.load(std::memory_order_acquire);
+    if (updated == NEVER_UPDATED || NowTicks() - updated >= m_maxAge.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    value = entry->value.load(std::memory_order_relaxed);
+    return true;
+}
+
+void BrightnessCache::Store(const std::shared_ptr<IMonitor> &monitor, int value)
+{
+    if (value < 0)
+    {
+        return;
+    }
+
+    std::shared_ptr<Entry> entry = FindEntry(monitor);
+    if (!entry)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        // Another writer may have added it meanwhile
+        entry = FindEntry(monitor);
+        if (!entry)
+        {
+            entry = std::make_shared<Entry>();
+            entry->monitor = monitor;
+            entry->value = value;
+            entry->updated = NEVER_UPDATED;
+
+            std::shared_ptr<Table> table = std::make_shared<Table>(*std::atomic_load(&m_table));
+            (*table)[monitor->GetId()] = entry;
+            std::atomic_store(&m_table, std::shared_ptr<const Table>(std::move(table)));
+        }
+    }
+
+    entry->value.store(value, std::memory_order_relaxed);
+    entry->updated.store(NowTicks(), std::memory_order_release);
+}
+
+void BrightnessCache::Invalidate(const std::shared_ptr<IMonitor> &monitor)
+{
+    std::shared_ptr<Entry> entry = FindEntry(monitor);
+    if (entry)
+    {
+        entry->updated.store(NEVER_UPDATED, std::memory_order_release);
+    }
+}
+
+void BrightnessCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    std::atomic_store(&m_table, std::shared_ptr<const Table>(std::make_shared<Table>()));
+}
+
+void BrightnessCache::SetMaxAge(std::chrono::milliseconds maxAge)
+{
+    m_maxAge = ToTicks(maxAge);
+}
+
+std::chrono::milliseconds BrightnessCache::GetMaxAge() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::duration(m_maxAge.load()));
+}
+
+std::shared_ptr<BrightnessCache::Entry> BrightnessCache::FindEntry(const std::shared_ptr<IMonitor> &monitor) const
+{
+    std::shared_ptr<const Table> table = std::atomic_load(&m_table);
+
+    auto it = table->find(monitor->GetId());
+    if (it == table->end() || it->second->monitor.lock() != monitor)
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
@@ -0,0 +1,110 @@
+/**
+ * BrightSync - Brightness Cache
+ *
+ * Read-through cache of per-monitor brightness values
+ */
+
+#ifndef BRIGHTNESS_CACHE_H
+#define BRIGHTNESS_CACHE_H
+
+#include "monitor_interface.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+ * Function used to read brightness from a monitor
+ */
+typedef std::function<int(const std::shared_ptr<IMonitor> &monitor)> BrightnessReader;
+
+/**
+ * Last known brightness of each monitor
+ *
+ * Values written by BrightSync or read from the hardware are kept for a
+ * configurable window, during which reads are answered from memory. Changes
+ * made outside BrightSync (monitor OSD, Windows slider) therefore show up
+ * after at most one window.
+ *
+ * Every monitor instance has its own entry holding the value and its time
+ * as atomics, so Lookup() and Store() of a known monitor never contend with
+ * each other. The table of entries is copied and swapped atomically when a
+ * monitor is seen for the first time, which only happens around topology
+ * changes. Loading the table takes the short internal lock of
+ * std::atomic_load on a shared_ptr (not lock-free on libstdc++ or MSVC),
+ * held only while the reference count is taken; it is never held during a
+ * table copy.
+ *
+ * All methods are thread-safe.
+ */
+class BrightnessCache
+{
+public:
+    /**
+     * Constructor
+     * @param maxAge How long a value stays fresh (zero disables caching)
+     */
+    explicit BrightnessCache(std::chrono::milliseconds maxAge);
+
+    /**
+     * Get a fresh cached value
+     * @param monitor Monitor to look up
+     * @param value Receives the cached brightness
+     * @return true if a value younger than the window exists
+     */
+    bool Lookup(const std::shared_ptr<IMonitor> &monitor, int &value) const;
+
+    /**
+     * Remember a value just read from or written to the hardware
+     * Negative values (read errors) are ignored
+     */
+    void Store(const std::shared_ptr<IMonitor> &monitor, int value);
+
+    /**
+     * Drop the value of one monitor (e.g. after a failed write)
+     */
+    void Invalidate(const std::shared_ptr<IMonitor> &monitor);
+
+    /**
+     * Drop all values
+     */
+    void Clear();
+
+    /**
+     * Change the staleness window
+     */
+    void SetMaxAge(std::chrono::milliseconds maxAge);
+
+    /**
+     * Get the staleness window
+     */
+    std::chrono::milliseconds GetMaxAge() const;
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<IMonitor> monitor; // instance the value belongs to (fixed)
+        std::atomic<int> value;
+        std::atomic<int64_t> updated; // steady_clock ticks, NEVER_UPDATED if none
+    };
+
+    typedef std::unordered_map<std::string, std::shared_ptr<Entry>> Table;
+
+    static const int64_t NEVER_UPDATED;
+
+    /**
+     * Get the entry of a monitor instance
+     * @return Entry, or nullptr if the instance has none
+     */
+    std::shared_ptr<Entry> FindEntry(const std::shared_ptr<IMonitor> &monitor) const;
+
+    std::mutex m_writeMutex; // serializes table replacements
+    std::atomic<int64_t> m_maxAge; // steady_clock ticks
+    std::shared_ptr<const Table> m_table; // accessed only through std::atomic_load / atomic_store
+};
+
+#endif // BRIGHTNESS_CACHE_H
@@ -0,0 +1,102 @@
+/**
+ * BrightSync - Brightness Watcher Implementation
+ */
+
+#include "brightness_watcher.h"
+#include <exception>
+
+BrightnessWatcher::BrightnessWatcher()
+    : m_stopRequested(false)
+{
+}
+
+BrightnessWatcher::~BrightnessWatcher()
+{
+    Stop();
+}
+
+void BrightnessWatcher::Start(MonitorSource source, ChangeCallback onChange, std::chrono::milliseconds interval)
+{
+    Stop();
+
+    m_stopRequested = false;
+    m_thread = std::thread(&BrightnessWatcher::Run, this, std::move(source), std::move(onChange), interval);
+}
+
+void BrightnessWatcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool BrightnessWatcher::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_thread.joinable() && !m_stopRequested;
+}
+
+size_t BrightnessWatcher::Sample(const std::vector<std::shared_ptr<IMonitor>> &monitors, const ChangeCallback &onChange)
+{
+    size_t changes = 0;
+
+    for (const auto &monitor : monitors)
+    {
+        if (!monitor || !monitor->IsProbed() || !monitor->IsControllable())
+        {
+            continue;
+        }
+
+        BrightnessChange change;
+        change.previous = monitor->GetLastKnownBrightness();
+        try
+        {
+            change.current = monitor->GetBrightness();
+        }
+        catch (const std::exception &)
+        {
+            // Treated like a failed read
+            continue;
+        }
+
+        if (change.current < 0 || change.current == change.previous)
+        {
+            continue;
+        }
+
+        change.id = monitor->GetId();
+        changes++;
+        if (onChange)
+        {
+            onChange(change);
+        }
+    }
+
+    return changes;
+}
+
+void BrightnessWatcher::Run(MonitorSource source, ChangeCallback onChange, std::chrono::milliseconds interval)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        if (m_wake.wait_for(lock, interval, [this]()
+                            { return m_stopRequested; }))
+        {
+            return;
+        }
+
+        // Sample without the lock so Stop() is never blocked by the hardware
+        lock.unlock();
+        Sample(source ? source() : std::vector<std::shared_ptr<IMonitor>>(), onChange);
+        lock.lock();
+    }
+}
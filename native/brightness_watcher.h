@@ -0,0 +1,98 @@
+/**
+ * BrightSync - Brightness Watcher
+ *
+ * Notices brightness changes that did not come from BrightSync
+ */
+
+#ifndef BRIGHTNESS_WATCHER_H
+#define BRIGHTNESS_WATCHER_H
+
+#include "monitor_interface.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * One observed brightness change
+ */
+struct BrightnessChange
+{
+    std::string id;
+    int previous; // last value BrightSync read or wrote
+    int current;  // value the hardware reports now
+};
+
+/**
+ * Low-rate background sampling of monitor brightness
+ *
+ * A sample reads each monitor once and compares the result with the value
+ * the monitor last read or wrote. BrightSync's own writes update that value,
+ * so only changes made elsewhere (Fn keys, adaptive brightness, the monitor's
+ * OSD) are reported. A write that completes while a monitor is being sampled
+ * may be reported too, with the value that was written.
+ *
+ * Monitors still probing or not controllable are skipped, as are failed
+ * reads (they answer with the last known value and report nothing).
+ */
+class BrightnessWatcher
+{
+public:
+    /**
+     * Monitors to sample; called on the watcher thread before every round
+     */
+    typedef std::function<std::vector<std::shared_ptr<IMonitor>>()> MonitorSource;
+
+    /**
+     * Invoked on the sampling thread for every change
+     */
+    typedef std::function<void(const BrightnessChange &change)> ChangeCallback;
+
+    BrightnessWatcher();
+
+    /**
+     * Destructor - stops the watcher thread
+     */
+    ~BrightnessWatcher();
+
+    BrightnessWatcher(const BrightnessWatcher &) = delete;
+    BrightnessWatcher &operator=(const BrightnessWatcher &) = delete;
+
+    /**
+     * Start sampling every interval (replaces a running watcher)
+     * @param source Monitors to sample in each round
+     * @param onChange Called for every change found
+     * @param interval Time between rounds; the first round runs after one interval
+     */
+    void Start(MonitorSource source, ChangeCallback onChange, std::chrono::milliseconds interval);
+
+    /**
+     * Stop and join the watcher thread (waits for a running round)
+     */
+    void Stop();
+
+    /**
+     * Check if the watcher thread is running
+     */
+    bool IsRunning() const;
+
+    /**
+     * Sample monitors once on the calling thread
+     * @return Number of changes reported
+     */
+    static size_t Sample(const std::vector<std::shared_ptr<IMonitor>> &monitors, const ChangeCallback &onChange);
+
+private:
+    void Run(MonitorSource source, ChangeCallback onChange, std::chrono::milliseconds interval);
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopRequested;
+};
+
+#endif // BRIGHTNESS_WATCHER_H
@@ -0,0 +1,325 @@
+/**
+ * BrightSync - Command Line Tool
+ *
+ * Drives the hardware abstraction layer without Electron, so the hardware
+ * path can be exercised and profiled on its own. Links against the same
+ * brightsync_hal library as the addon.
+ *
+ * Usage: brightsync_cli [--mock] [--verbose] <command>
+ *   list                      Enumerate and probe all monitors
+ *   get <id>                  Read the brightness of a monitor
+ *   set <id> <value>          Write the brightness of a monitor
+ *   bench <id> [count]        Time count reads and writes (default 20)
+ *   state                     Print the state a running BrightSync publishes
+ *                             (shared memory; no hardware access)
+ */
+
+#include "monitor_interface.h"
+#include "monitor_factory.h"
+#include "monitor_prober.h"
+#include "monitor_stats.h"
+#include "hardware_executor.h"
+#include "native_log.h"
+#include "state_segment.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+
+static const int DEFAULT_BENCH_COUNT = 20;
+
+/**
+ * Print the command line help
+ */
+static void PrintUsage()
+{
+    std::cerr << "Usage: brightsync_cli [--mock] [--verbose] <command>\n"
+              << "  list                      Enumerate and probe all monitors\n"
+              << "  get <id>                  Read the brightness of a monitor\n"
+              << "  set <id> <value>          Write the brightness of a monitor\n"
+              << "  bench <id> [count]        Time count reads and writes (default "
+              << DEFAULT_BENCH_COUNT << ")\n"
+              << "  state                     Print the state a running BrightSync publishes\n";
+}
+
+/**
+ * Parse a whole decimal number
+ */
+static bool ParseInt(const std::string &text, int &value)
+{
+    char *end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0')
+    {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+/**
+ * Enumerate all monitors and probe them at once
+ */
+static std::vector<std::shared_ptr<IMonitor>> LoadMonitors(bool useMock)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<IMonitor>> monitors = CreateMonitors(useMock);
+    MonitorStats::Instance().RecordEnumeration(std::chrono::steady_clock::now() - start);
+
+    MonitorProber prober;
+    prober.ProbeAsync(monitors, [](const std::shared_ptr<IMonitor> &) {});
+    prober.Wait();
+    return monitors;
+}
+
+/**
+ * Find a monitor by ID, reporting unknown IDs
+ */
+static std::shared_ptr<IMonitor> FindMonitor(
+    const std::vector<std::shared_ptr<IMonitor>> &monitors,
+    const std::string &id)
+{
+    for (const auto &monitor : monitors)
+    {
+        if (monitor->GetId() == id)
+        {
+            return monitor;
+        }
+    }
+    std::cerr << "Unknown monitor: " << id << " (see 'list')\n";
+    return nullptr;
+}
+
+/**
+ * Print the latency of one kind of operation
+ */
+static void PrintLatency(const char *label, const LatencyHistogram::Snapshot &latency, uint64_t failures)
+{
+    std::cout << std::fixed << std::setprecision(1)
+              << label << ": " << latency.count << " calls, " << failures << " failed, mean "
+              << latency.MeanMs() << " ms, p50 " << latency.PercentileMs(50)
+              << " ms, p95 " << latency.PercentileMs(95)
+              << " ms, p99 " << latency.PercentileMs(99)
+              << " ms, max " << latency.maxMs << " ms\n";
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+static int ListMonitors(const std::vector<std::shared_ptr<IMonitor>> &monitors)
+{
+    for (const auto &monitor : monitors)
+    {
+        std::cout << monitor->GetId() << "\t" << MonitorTypeName(monitor->GetType())
+                  << "\t" << monitor->GetName() << "\t";
+        if (monitor->IsControllable())
+        {
+            std::cout << monitor->GetMinBrightness() << "-" << monitor->GetMaxBrightness()
+                      << "\t" << monitor->GetLastKnownBrightness() << "\n";
+        }
+        else
+        {
+            std::cout << "not controllable\n";
+        }
+    }
+
+    const LatencyHistogram::Snapshot enumeration = MonitorStats::Instance().Read().enumeration;
+    std::cout << std::fixed << std::setprecision(1) << monitors.size()
+              << " monitors, enumerated in " << enumeration.maxMs << " ms\n";
+    return 0;
+}
+
+static int GetBrightness(const std::shared_ptr<IMonitor> &monitor)
+{
+    int brightness = monitor->GetBrightness();
+    if (brightness < 0)
+    {
+        std::cerr << "Failed to read brightness of " << monitor->GetId() << "\n";
+        return 1;
+    }
+    std::cout << brightness << "\n";
+    return 0;
+}
+
+static int SetBrightness(const std::shared_ptr<IMonitor> &monitor, int value)
+{
+    if (!monitor->SetBrightness(value))
+    {
+        std::cerr << "Failed to set brightness of " << monitor->GetId() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Alternate reads and writes between two values, then restore the original
+ */
+static int Benchmark(const std::shared_ptr<IMonitor> &monitor, int count)
+{
+    int original = monitor->GetBrightness();
+    if (original < 0)
+    {
+        std::cerr << "Failed to read brightness of " << monitor->GetId() << "\n";
+        return 1;
+    }
+
+    // Stay close to the current value so the screen barely flickers
+    int low = original > monitor->GetMinBrightness() ? original - 1 : original;
+    int high = low + 1 <= monitor->GetMaxBrightness() ? low + 1 : low;
+
+    LatencyHistogram reads;
+    LatencyHistogram writes;
+    uint64_t readFailures = 0;
+    uint64_t writeFailures = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        bool written = monitor->SetBrightness(i % 2 == 0 ? low : high);
+        writes.Record(std::chrono::steady_clock::now() - start);
+        writeFailures += written ? 0 : 1;
+
+        start = std::chrono::steady_clock::now();
+        bool read = monitor->GetBrightness() >= 0;
+        reads.Record(std::chrono::steady_clock::now() - start);
+        readFailures += read ? 0 : 1;
+    }
+
+    monitor->SetBrightness(original);
+
+    std::cout << monitor->GetId() << " (" << monitor->GetName() << ")\n";
+    PrintLatency("read ", reads.Read(), readFailures);
+    PrintLatency("write", writes.Read(), writeFailures);
+    return readFailures + writeFailures > 0 ? 1 : 0;
+}
+
+/**
+ * Print the shared state segment of a running BrightSync
+ */
+static int PrintSharedState()
+{
+    StateSegmentReader reader;
+    SharedState state;
+    if (!reader.Open(STATE_SEGMENT_NAME) || !reader.Read(state))
+    {
+        std::cerr << "No shared state published (is BrightSync running?)\n";
+        return 1;
+    }
+
+    for (const auto &monitor : state.monitors)
+    {
+        const MonitorDescriptor &descriptor = monitor.descriptor;
+        std::cout << descriptor.id << "\t" << MonitorTypeName(descriptor.type)
+                  << "\t" << descriptor.name << "\t" << descriptor.minBrightness << "-"
+                  << descriptor.maxBrightness << "\t" << monitor.brightness
+                  << (monitor.probing ? "\tprobing" : "")
+                  << (monitor.responding ? "" : "\tnot responding") << "\n";
+    }
+    std::cout << state.monitors.size() << " monitors, topology version " << state.topologyVersion << "\n";
+    return 0;
+}
+
+// ============================================================================
+// Entry Point
+// ============================================================================
+
+static int Run(bool useMock, const std::vector<std::string> &args)
+{
+    const std::string &command = args[0];
+
+    // Reads another process; nothing is enumerated here
+    if (command == "state" && args.size() == 1)
+    {
+        return PrintSharedState();
+    }
+
+    std::vector<std::shared_ptr<IMonitor>> monitors = LoadMonitors(useMock);
+
+    if (command == "list" && args.size() == 1)
+    {
+        return ListMonitors(monitors);
+    }
+
+    if (args.size() < 2)
+    {
+        PrintUsage();
+        return 2;
+    }
+    std::shared_ptr<IMonitor> monitor = FindMonitor(monitors, args[1]);
+    if (!monitor)
+    {
+        return 1;
+    }
+
+    int number = 0;
+    if (command == "get" && args.size() == 2)
+    {
+        return GetBrightness(monitor);
+    }
+    if (command == "set" && args.size() == 3 && ParseInt(args[2], number))
+    {
+        return SetBrightness(monitor, number);
+    }
+    if (command == "bench" && args.size() <= 3)
+    {
+        number = DEFAULT_BENCH_COUNT;
+        if ((args.size() == 3 && !ParseInt(args[2], number)) || number <= 0)
+        {
+            PrintUsage();
+            return 2;
+        }
+        return Benchmark(monitor, number);
+    }
+
+    PrintUsage();
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    bool useMock = false;
+    std::vector<std::string> args;
+    NativeLog::SetLevel(LogLevel::Warn);
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--mock")
+        {
+            useMock = true;
+        }
+        else if (arg == "--verbose")
+        {
+            NativeLog::SetLevel(LogLevel::Debug);
+        }
+        else
+        {
+            args.push_back(arg);
+        }
+    }
+
+    if (args.empty())
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    int result = 1;
+    try
+    {
+        result = Run(useMock, args);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+    }
+
+    // Join the hardware lanes before statics are destroyed
+    HardwareExecutor::Instance().Shutdown();
+    NativeLog::Flush();
+    return result;
+}
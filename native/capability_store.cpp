@@ -0,0 +1,326 @@
+/**
+ * BrightSync - Capability Store Implementation
+ */
+
+#include "capability_store.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static const char *FILE_HEADER = "BrightSyncCapabilities";
+static const char *DISPLAY_TAG = "display";
+
+// ============================================================================
+// File Helpers
+// ============================================================================
+
+#ifdef _WIN32
+/**
+ * Convert a UTF-8 path to UTF-16 so non-ASCII profile paths work
+ */
+static std::wstring ToWidePath(const std::string &path)
+{
+    if (path.empty())
+        return std::wstring();
+
+    int size = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), NULL, 0);
+    std::wstring wide(size, 0);
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), (int)path.size(), &wide[0], size);
+    return wide;
+}
+#endif
+
+template <typename Stream>
+static void OpenFile(Stream &stream, const std::string &path)
+{
+#ifdef _WIN32
+    stream.open(ToWidePath(path).c_str());
+#else
+    stream.open(path);
+#endif
+}
+
+/**
+ * Replace target with source
+ */
+static bool ReplaceFile(const std::string &source, const std::string &target)
+{
+#ifdef _WIN32
+    return MoveFileExW(ToWidePath(source).c_str(), ToWidePath(target).c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
+#else
+    return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool KnownDisplay::operator==(const KnownDisplay &other) const
+{
+    return id == other.id && name == other.name && type == other.type && brightness == other.brightness;
+}
+
+CapabilityStore::CapabilityStore()
+{
+}
+
+bool CapabilityStore::Load(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_path = path;
+    m_entries.clear();
+    m_displays.clear();
+
+    if (path.empty())
+    {
+        return false;
+    }
+
+    std::ifstream file;
+    OpenFile(file, path);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string header;
+    int version = 0;
+    if (!(file >> header >> version) || header != FILE_HEADER || version < 1 || version > FORMAT_VERSION)
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string id;
+        int method = 0;
+        int maxValue = 0;
+
+        if (!(fields >> id))
+        {
+            continue;
+        }
+
+        if (id == DISPLAY_TAG)
+        {
+            KnownDisplay display;
+            std::string type;
+            if ((fields >> display.id >> type >> display.brightness) && fields.get() == '\t' && std::getline(fields, display.name))
+            {
+                display.type = ParseMonitorType(type);
+                m_displays.push_back(display);
+            }
+            continue;
+        }
+
+        if (!(fields >> method >> maxValue))
+        {
+            continue;
+        }
+        if (method <= static_cast<int>(DdcMethod::Unknown) || method > static_cast<int>(DdcMethod::Unsupported) || maxValue < 0)
+        {
+            continue;
+        }
+
+        MonitorCapabilities capabilities;
+        capabilities.method = static_cast<DdcMethod>(method);
+        capabilities.maxValue = maxValue;
+        m_entries[id] = capabilities;
+    }
+
+    return !m_entries.empty() || !m_displays.empty();
+}
+
+bool CapabilityStore::Lookup(const std::string &id, MonitorCapabilities &capabilities) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    capabilities = it->second;
+    return true;
+}
+
+void CapabilityStore::Update(const std::string &id, const MonitorCapabilities &capabilities)
+{
+    if (capabilities.method == DdcMethod::Unknown)
+    {
+        Forget(id);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(id);
+    if (it != m_entries.end() && it->second.method == capabilities.method && it->second.maxValue == capabilities.maxValue)
+    {
+        return;
+    }
+
+    m_entries[id] = capabilities;
+    SaveLocked();
+}
+
+void CapabilityStore::Forget(const std::string &id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_entries.erase(id) > 0)
+    {
+        SaveLocked();
+    }
+}
+
+size_t CapabilityStore::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+std::vector<KnownDisplay> CapabilityStore::GetDisplays() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_displays;
+}
+
+void CapabilityStore::SetDisplays(const std::vector<KnownDisplay> &displays)
+{
+    // Names end the line; keep the separators out of them
+    std::vector<KnownDisplay> sanitized = displays;
+    for (auto &display : sanitized)
+    {
+        std::replace(display.name.begin(), display.name.end(), '\t', ' ');
+        std::replace(display.name.begin(), display.name.end(), '\n', ' ');
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (sanitized == m_displays)
+    {
+        return;
+    }
+
+    m_displays.swap(sanitized);
+    SaveLocked();
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+bool CapabilityStore::SaveLocked() const
+{
+    if (m_path.empty())
+    {
+        return false;
+    }
+
+    std::string tempPath = m_path + ".tmp";
+    {
+        std::ofstream file;
+        OpenFile(file, tempPath);
+        if (!file)
+        {
+            return false;
+        }
+
+        file << FILE_HEADER << " " << FORMAT_VERSION << "\n";
+        for (const auto &entry : m_entries)
+        {
+            file << entry.first << "\t" << static_cast<int>(entry.second.method) << "\t" << entry.second.maxValue << "\n";
+        }
+        for (const auto &display : m_displays)
+        {
+            file << DISPLAY_TAG << "\t" << display.id << "\t" << MonitorTypeName(display.type) << "\t"
+                 << display.brightness << "\t" << display.name << "\n";
+        }
+
+        if (!file.flush())
+        {
+            return false;
+        }
+    }
+
+    return ReplaceFile(tempPath, m_path);
+}
+
+// ============================================================================
+// CapabilityTracker
+// ============================================================================
+
+/**
+ * Whether the method is one a monitor answered with
+ */
+static bool IsWorkingMethod(DdcMethod method)
+{
+    return method == DdcMethod::HighLevel || method == DdcMethod::Vcp;
+}
+
+CapabilityTracker::CapabilityTracker()
+    : m_answered(false)
+{
+}
+
+void CapabilityTracker::Restore(const MonitorCapabilities &stored)
+{
+    m_current = stored;
+    m_stored = stored;
+    m_answered = m_answered || IsWorkingMethod(stored.method);
+}
+
+const MonitorCapabilities &CapabilityTracker::Current() const
+{
+    return m_current;
+}
+
+bool CapabilityTracker::HasAnswered() const
+{
+    return m_answered;
+}
+
+bool CapabilityTracker::Answered(const MonitorCapabilities &detected, MonitorCapabilities &persist)
+{
+    m_current = detected;
+    m_answered = true;
+
+    if (detected.method == m_stored.method && detected.maxValue == m_stored.maxValue)
+    {
+        return false;
+    }
+
+    m_stored = detected;
+    persist = detected;
+    return true;
+}
+
+bool CapabilityTracker::ReadFailed(MonitorCapabilities &persist)
+{
+    m_current = MonitorCapabilities();
+
+    if (m_answered || m_stored.method == DdcMethod::Unsupported)
+    {
+        return false;
+    }
+
+    m_stored = MonitorCapabilities();
+    m_stored.method = DdcMethod::Unsupported;
+    persist = m_stored;
+    return true;
+}
+
+void CapabilityTracker::Reset()
+{
+    m_current = MonitorCapabilities();
+}
@@ -0,0 +1,180 @@
+/**
+ * BrightSync - Capability Store
+ *
+ * Persists per-monitor DDC/CI capabilities and the last topology across launches
+ */
+
+#ifndef CAPABILITY_STORE_H
+#define CAPABILITY_STORE_H
+
+#include "monitor_interface.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+/**
+ * How a monitor's brightness is reached over DDC/CI
+ */
+enum class DdcMethod
+{
+    Unknown = 0,     // not detected yet
+    HighLevel = 1,   // GetMonitorBrightness / SetMonitorBrightness
+    Vcp = 2,         // GetVCPFeatureAndVCPFeatureReply / SetVCPFeature (code 0x10)
+    Unsupported = 3  // monitor does not answer DDC/CI
+};
+
+/**
+ * Capabilities remembered for one monitor
+ */
+struct MonitorCapabilities
+{
+    DdcMethod method = DdcMethod::Unknown;
+    int maxValue = 0; // raw brightness maximum reported for that method (0 = unknown)
+};
+
+/**
+ * A display seen in the last session
+ */
+struct KnownDisplay
+{
+    std::string id;
+    std::string name;
+    MonitorType type = MonitorType::External;
+    int brightness = -1; // last known value (-1 = unknown)
+
+    bool operator==(const KnownDisplay &other) const;
+};
+
+/**
+ * Small versioned capability file keyed by monitor ID
+ *
+ * Monitor IDs are derived from the EDID hardware ID and device path, so an
+ * entry follows the physical monitor across reboots and replugs. The file is
+ * a header line followed by one tab-separated line per monitor, and one
+ * "display" line per monitor of the last known topology (in order, name
+ * last since it may contain spaces):
+ *
+ *   BrightSyncCapabilities 2
+ *   monitor_del40f0_3f2a9c1e	2	100
+ *   display	monitor_del40f0_3f2a9c1e	external	65	DELL U2720Q
+ *
+ * Version 1 files (capabilities only) are still read. A missing file, an
+ * unknown version or malformed lines are ignored; the affected monitors are
+ * simply probed again. All methods are thread-safe.
+ */
+class CapabilityStore
+{
+public:
+    static const int FORMAT_VERSION = 2;
+
+    CapabilityStore();
+
+    /**
+     * Load the file and remember its path for later saves
+     * @param path UTF-8 file path; empty disables persistence
+     * @return true if entries were loaded
+     */
+    bool Load(const std::string &path);
+
+    /**
+     * Get remembered capabilities
+     * @return true if the monitor has an entry
+     */
+    bool Lookup(const std::string &id, MonitorCapabilities &capabilities) const;
+
+    /**
+     * Remember capabilities and save the file if anything changed
+     */
+    void Update(const std::string &id, const MonitorCapabilities &capabilities);
+
+    /**
+     * Drop the entry of a monitor and save the file
+     */
+    void Forget(const std::string &id);
+
+    /**
+     * Number of remembered monitors
+     */
+    size_t Size() const;
+
+    /**
+     * Get the topology of the last session
+     * @return Displays in enumeration order (empty if none was saved)
+     */
+    std::vector<KnownDisplay> GetDisplays() const;
+
+    /**
+     * Remember the current topology and save the file if anything changed
+     */
+    void SetDisplays(const std::vector<KnownDisplay> &displays);
+
+private:
+    /**
+     * Write all entries (caller holds m_mutex)
+     * Writes a temporary file and renames it over the old one
+     */
+    bool SaveLocked() const;
+
+    mutable std::mutex m_mutex;
+    std::string m_path;
+    std::map<std::string, MonitorCapabilities> m_entries;
+    std::vector<KnownDisplay> m_displays;
+};
+
+/**
+ * DDC/CI capabilities of one monitor during a session
+ *
+ * Decides what is written back to the store. Only a monitor that never
+ * answered, in this session or (per the store) an earlier one, is
+ * remembered as unsupported. One that answered and then stops (asleep,
+ * power cycled, KVM switched away) is detected again on the next call and
+ * keeps its entry. Not thread-safe; DdcMonitor guards it with its DDC mutex.
+ */
+class CapabilityTracker
+{
+public:
+    CapabilityTracker();
+
+    /**
+     * Start from the entry the store has for this monitor
+     */
+    void Restore(const MonitorCapabilities &stored);
+
+    /**
+     * Capabilities to use for the next transaction
+     */
+    const MonitorCapabilities &Current() const;
+
+    /**
+     * Whether the monitor ever returned a value (here or in an earlier session)
+     */
+    bool HasAnswered() const;
+
+    /**
+     * Record a transaction that worked
+     * @param detected Method and range that worked
+     * @param persist Receives the entry to store
+     * @return true if the store entry has to change
+     */
+    bool Answered(const MonitorCapabilities &detected, MonitorCapabilities &persist);
+
+    /**
+     * Record a read that got no answer; the method is detected again next time
+     * @param persist Receives the entry to store
+     * @return true if the store entry has to change (the monitor never answered)
+     */
+    bool ReadFailed(MonitorCapabilities &persist);
+
+    /**
+     * Detect the method again on the next transaction; the store is untouched
+     */
+    void Reset();
+
+private:
+    MonitorCapabilities m_current;
+    MonitorCapabilities m_stored; // entry of the store as far as we know
+    bool m_answered;
+};
+
+#endif // CAPABILITY_STORE_H
@@ -0,0 +1,81 @@
+/**
+ * BrightSync - Circuit Breaker Implementation
+ */
+
+#include "circuit_breaker.h"
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, int initialBackoffMs, int maxBackoffMs)
+    : m_failureThreshold(failureThreshold > 0 ? failureThreshold : 1),
+      m_initialBackoffMs(initialBackoffMs > 0 ? initialBackoffMs : 1),
+      m_maxBackoffMs(maxBackoffMs > m_initialBackoffMs ? maxBackoffMs : m_initialBackoffMs),
+      m_open(false),
+      m_failures(0),
+      m_backoffMs(0)
+{
+}
+
+bool CircuitBreaker::Allow() const
+{
+    return !m_open.load();
+}
+
+bool CircuitBreaker::IsProbeDue() const
+{
+    if (!m_open.load())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::chrono::steady_clock::now() >= m_retryAt;
+}
+
+bool CircuitBreaker::Complete(bool success)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (success)
+    {
+        bool wasOpen = m_open.load();
+        m_failures = 0;
+        m_backoffMs = 0;
+        m_open = false;
+        return wasOpen;
+    }
+
+    m_failures++;
+    if (m_open.load())
+    {
+        // A failed probe: wait twice as long before the next one
+        m_backoffMs = m_backoffMs * 2 < m_maxBackoffMs ? m_backoffMs * 2 : m_maxBackoffMs;
+        m_retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_backoffMs);
+        return false;
+    }
+
+    if (m_failures < m_failureThreshold)
+    {
+        return false;
+    }
+
+    m_backoffMs = m_initialBackoffMs;
+    m_retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_backoffMs);
+    m_open = true;
+    return true;
+}
+
+bool CircuitBreaker::IsOpen() const
+{
+    return m_open.load();
+}
+
+int CircuitBreaker::GetConsecutiveFailures() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failures;
+}
+
+int CircuitBreaker::GetBackoffMs() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_backoffMs;
+}
@@ -0,0 +1,87 @@
+/**
+ * BrightSync - Circuit Breaker
+ *
+ * Stops sending commands to a monitor that no longer answers
+ */
+
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+/**
+ * Health of one monitor
+ *
+ * A monitor that sleeps, sits behind a KVM switch or shows another input
+ * still costs a full bus timeout per command. After a run of consecutive
+ * failures the breaker opens and callers fail fast without touching the
+ * hardware. While it is open only the health probe may try the hardware,
+ * once per backoff period; the backoff doubles after every failed probe up
+ * to a ceiling. The first success - probe or a command that was already in
+ * flight - closes the breaker and resets the backoff.
+ *
+ * All methods are thread-safe; Allow() is a single atomic load.
+ */
+class CircuitBreaker
+{
+public:
+    static const int FAILURE_THRESHOLD = 3;
+    static const int INITIAL_BACKOFF_MS = 1000;
+    static const int MAX_BACKOFF_MS = 60000;
+
+    /**
+     * Constructor
+     * @param failureThreshold Consecutive failures that open the breaker
+     * @param initialBackoffMs Wait before the first probe of an open breaker
+     * @param maxBackoffMs Upper bound for the doubled backoff
+     */
+    explicit CircuitBreaker(int failureThreshold = FAILURE_THRESHOLD,
+                            int initialBackoffMs = INITIAL_BACKOFF_MS,
+                            int maxBackoffMs = MAX_BACKOFF_MS);
+
+    /**
+     * Check whether a command may be sent
+     * @return false while the breaker is open
+     */
+    bool Allow() const;
+
+    /**
+     * Check whether the breaker is open and its backoff has passed
+     */
+    bool IsProbeDue() const;
+
+    /**
+     * Report the outcome of a command or probe
+     * @return true if this changed the state (opened or closed the breaker)
+     */
+    bool Complete(bool success);
+
+    /**
+     * Check if the breaker is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * Number of failures since the last success
+     */
+    int GetConsecutiveFailures() const;
+
+    /**
+     * Current wait between probes in milliseconds (0 while closed)
+     */
+    int GetBackoffMs() const;
+
+private:
+    mutable std::mutex m_mutex;
+    const int m_failureThreshold;
+    const int m_initialBackoffMs;
+    const int m_maxBackoffMs;
+    std::atomic<bool> m_open;
+    int m_failures;
+    int m_backoffMs;
+    std::chrono::steady_clock::time_point m_retryAt;
+};
+
+#endif // CIRCUIT_BREAKER_H
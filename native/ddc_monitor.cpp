@@ -0,0 +1,418 @@
+/**
+ * BrightSync - DDC/CI Monitor Implementation
+ */
+
+#include "ddc_monitor.h"
+#include <windows.h>
+#include <physicalmonitorenumerationapi.h>
+#include <highlevelmonitorconfigurationapi.h>
+#include <lowlevelmonitorconfigurationapi.h>
+#include <vector>
+#include <utility>
+
+#pragma comment(lib, "Dxva2.lib")
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+DdcMonitor::DdcMonitor(const std::string &id, const std::string &name, HMONITOR hMonitor)
+    : RealMonitor(id, name, MonitorType::External, "ddc:" + id, -1),
+      m_hMonitor(hMonitor),
+      m_supportsDDC(true),
+      m_capabilityStore(nullptr),
+      m_unsupportedFromStore(false)
+{
+}
+
+DdcMonitor::~DdcMonitor()
+{
+    // HMONITOR is system-owned; physical monitor handles are ours. No command
+    // can be running once the last reference is gone, so release them here
+    std::lock_guard<std::mutex> lock(m_ddcMutex);
+    ReleasePhysicalMonitors();
+}
+
+void DdcMonitor::UpdateMonitorHandle(HMONITOR hMonitor)
+{
+    RunOnHardwareThread([&]()
+                        {
+        std::lock_guard<std::mutex> lock(m_ddcMutex);
+
+        if (hMonitor != m_hMonitor)
+        {
+            ReleasePhysicalMonitors();
+            m_hMonitor = hMonitor;
+        } });
+}
+
+void DdcMonitor::AttachCapabilityStore(CapabilityStore *store)
+{
+    m_capabilityStore = store;
+
+    MonitorCapabilities capabilities;
+    if (!store || !store->Lookup(GetId(), capabilities))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_ddcMutex);
+    m_capabilities.Restore(capabilities);
+    m_unsupportedFromStore = capabilities.method == DdcMethod::Unsupported;
+}
+
+MonitorCapabilities DdcMonitor::GetCapabilities() const
+{
+    std::lock_guard<std::mutex> lock(m_ddcMutex);
+    return m_capabilities.Current();
+}
+
+void DdcMonitor::PersistCapabilities(const MonitorCapabilities &capabilities) const
+{
+    if (m_capabilityStore)
+    {
+        m_capabilityStore->Update(GetId(), capabilities);
+    }
+}
+
+// ============================================================================
+// Backend
+// ============================================================================
+
+int DdcMonitor::GetBrightness() const
+{
+    RecheckRememberedSupport();
+    return RealMonitor::GetBrightness();
+}
+
+bool DdcMonitor::SetBrightness(int value)
+{
+    RecheckRememberedSupport();
+    return RealMonitor::SetBrightness(value);
+}
+
+void DdcMonitor::RecheckRememberedSupport() const
+{
+    // "No DDC/CI" remembered from an earlier session may be outdated (e.g.
+    // DDC/CI was switched on in the OSD since); check once when it matters,
+    // keeping the check for later while the breaker would refuse it
+    if (m_supportsDDC || !IsResponding() || !m_unsupportedFromStore.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_ddcMutex);
+        m_capabilities.Reset();
+    }
+    m_supportsDDC = ReadHardwareBrightness(true) >= 0;
+}
+
+bool DdcMonitor::IsControllable() const
+{
+    return m_supportsDDC;
+}
+
+int DdcMonitor::ReadHardware() const
+{
+    return GetBrightnessDDC();
+}
+
+bool DdcMonitor::WriteHardware(int value)
+{
+    return SetBrightnessDDC(value);
+}
+
+int DdcMonitor::ProbeHardware()
+{
+    if (GetCapabilities().method == DdcMethod::Unsupported)
+    {
+        // Known not to answer DDC/CI; do not wait for it again
+        m_supportsDDC = false;
+        return -1;
+    }
+
+    int brightness = ReadHardwareBrightness();
+    m_supportsDDC = brightness >= 0;
+    return brightness;
+}
+
+// ============================================================================
+// DDC/CI Transactions
+// ============================================================================
+
+bool DdcMonitor::AcquirePhysicalMonitors() const
+{
+    if (!m_physicalMonitors.empty())
+    {
+        return true;
+    }
+
+    DWORD numPhysicalMonitors;
+    if (!GetNumberOfPhysicalMonitorsFromHMONITOR(m_hMonitor, &numPhysicalMonitors))
+    {
+        return false;
+    }
+
+    if (numPhysicalMonitors == 0)
+    {
+        return false;
+    }
+
+    std::vector<PHYSICAL_MONITOR> physicalMonitors(numPhysicalMonitors);
+
+    if (!GetPhysicalMonitorsFromHMONITOR(m_hMonitor, numPhysicalMonitors, &physicalMonitors[0]))
+    {
+        return false;
+    }
+
+    m_physicalMonitors.swap(physicalMonitors);
+    return true;
+}
+
+void DdcMonitor::ReleasePhysicalMonitors() const
+{
+    if (m_physicalMonitors.empty())
+    {
+        return;
+    }
+
+    DestroyPhysicalMonitors((DWORD)m_physicalMonitors.size(), &m_physicalMonitors[0]);
+    m_physicalMonitors.clear();
+}
+
+/**
+ * Convert a raw value in [0, maxValue] to a percentage (rounded)
+ */
+static int RawToPercent(DWORD value, DWORD maxValue)
+{
+    if (value > maxValue)
+        value = maxValue;
+
+    return (int)((value * 100 + maxValue / 2) / maxValue);
+}
+
+/**
+ * Convert a percentage to a raw value in [0, maxValue] (rounded)
+ */
+static DWORD PercentToRaw(int percent, int maxValue)
+{
+    return (DWORD)((percent * maxValue + 50) / 100);
+}
+
+/**
+ * Read brightness with the high-level monitor configuration API
+ * @param maxValue Receives the maximum reported by the monitor
+ * @return Brightness value (0-100) or -1 on error
+ */
+static int ReadBrightnessHighLevel(HANDLE hPhysicalMonitor, DdcPacer &pacer, int &maxValue)
+{
+    DWORD minBrightness, currentBrightness, maxBrightness;
+
+    if (pacer.Run([&]()
+                  { return GetMonitorBrightness(hPhysicalMonitor, &minBrightness, &currentBrightness, &maxBrightness); }))
+    {
+        if (maxBrightness > 0)
+        {
+            maxValue = (int)maxBrightness;
+            return RawToPercent(currentBrightness, maxBrightness);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Read brightness with low-level VCP code 0x10
+ * @param maxValue Receives the maximum reported by the monitor
+ * @return Brightness value (0-100) or -1 on error
+ */
+static int ReadBrightnessVcp(HANDLE hPhysicalMonitor, DdcPacer &pacer, int &maxValue)
+{
+    DWORD currentValue = 0;
+    DWORD vcpMax = 0;
+    MC_VCP_CODE_TYPE codeType;
+
+    if (pacer.Run([&]()
+                  { return GetVCPFeatureAndVCPFeatureReply(hPhysicalMonitor, 0x10, &codeType, &currentValue, &vcpMax); }))
+    {
+        if (vcpMax > 0)
+        {
+            maxValue = (int)vcpMax;
+            return RawToPercent(currentValue, vcpMax);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Read brightness (0-100) from a physical monitor handle
+ * Uses the recorded method; the other one is tried only if it fails
+ * @param capabilities Method to use; updated with the method that worked
+ * @return Brightness value or -1 on error
+ */
+static int ReadBrightnessDDC(HANDLE hPhysicalMonitor, DdcPacer &pacer, MonitorCapabilities &capabilities)
+{
+    DdcMethod order[2] = {DdcMethod::HighLevel, DdcMethod::Vcp};
+    if (capabilities.method == DdcMethod::Vcp)
+    {
+        std::swap(order[0], order[1]);
+    }
+
+    for (DdcMethod method : order)
+    {
+        int maxValue = 0;
+        int brightness = method == DdcMethod::HighLevel
+                             ? ReadBrightnessHighLevel(hPhysicalMonitor, pacer, maxValue)
+                             : ReadBrightnessVcp(hPhysicalMonitor, pacer, maxValue);
+        if (brightness >= 0)
+        {
+            capabilities.method = method;
+            capabilities.maxValue = maxValue;
+            return brightness;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Write brightness (0-100) to a physical monitor handle
+ * Uses the recorded method; the other one is tried only if it fails
+ * @param capabilities Method to use; updated with the method that worked
+ * @return true on success, false on failure
+ */
+static bool WriteBrightnessDDC(HANDLE hPhysicalMonitor, DdcPacer &pacer, int brightness, MonitorCapabilities &capabilities)
+{
+    DdcMethod order[2] = {DdcMethod::HighLevel, DdcMethod::Vcp};
+    if (capabilities.method == DdcMethod::Vcp)
+    {
+        std::swap(order[0], order[1]);
+    }
+
+    for (DdcMethod method : order)
+    {
+        // Range of the method; read it first if it was never recorded
+        int maxValue = capabilities.method == method ? capabilities.maxValue : 0;
+        if (maxValue <= 0)
+        {
+            int current = method == DdcMethod::HighLevel
+                              ? ReadBrightnessHighLevel(hPhysicalMonitor, pacer, maxValue)
+                              : ReadBrightnessVcp(hPhysicalMonitor, pacer, maxValue);
+            if (current < 0)
+            {
+                continue;
+            }
+        }
+
+        DWORD value = PercentToRaw(brightness, maxValue);
+        bool success = pacer.Run([&]()
+                                 { return method == DdcMethod::HighLevel
+                                              ? SetMonitorBrightness(hPhysicalMonitor, value) != FALSE
+                                              : SetVCPFeature(hPhysicalMonitor, 0x10, value) != FALSE; }); // VCP code 0x10 is brightness
+        if (success)
+        {
+            capabilities.method = method;
+            capabilities.maxValue = maxValue;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int DdcMonitor::GetBrightnessDDC() const
+{
+    MonitorCapabilities detected;
+    MonitorCapabilities persist;
+    bool changed = false;
+    int brightness = -1;
+
+    {
+        std::lock_guard<std::mutex> lock(m_ddcMutex);
+        detected = m_capabilities.Current();
+
+        if (AcquirePhysicalMonitors())
+        {
+            brightness = ReadBrightnessDDC(m_physicalMonitors[0].hPhysicalMonitor, m_ddcPacer, detected);
+
+            if (brightness < 0)
+            {
+                // Handle may have gone stale (monitor power cycle, input switch);
+                // re-acquire once and retry
+                m_stats.retries.fetch_add(1, std::memory_order_relaxed);
+                ReleasePhysicalMonitors();
+                if (AcquirePhysicalMonitors())
+                {
+                    brightness = ReadBrightnessDDC(m_physicalMonitors[0].hPhysicalMonitor, m_ddcPacer, detected);
+                }
+            }
+        }
+
+        // A monitor that never answered is remembered as unsupported; one
+        // that stopped answering is detected again next time
+        changed = brightness >= 0 ? m_capabilities.Answered(detected, persist)
+                                  : m_capabilities.ReadFailed(persist);
+    }
+
+    if (changed)
+    {
+        PersistCapabilities(persist);
+    }
+
+    return brightness;
+}
+
+bool DdcMonitor::SetBrightnessDDC(int brightness)
+{
+    // Clamp brightness
+    if (brightness < 0)
+        brightness = 0;
+    if (brightness > 100)
+        brightness = 100;
+
+    MonitorCapabilities detected;
+    MonitorCapabilities persist;
+    bool changed = false;
+    bool success = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_ddcMutex);
+        detected = m_capabilities.Current();
+
+        if (AcquirePhysicalMonitors())
+        {
+            success = WriteBrightnessDDC(m_physicalMonitors[0].hPhysicalMonitor, m_ddcPacer, brightness, detected);
+
+            if (!success)
+            {
+                // Handle may have gone stale (monitor power cycle, input switch);
+                // re-acquire once and retry
+                m_stats.retries.fetch_add(1, std::memory_order_relaxed);
+                ReleasePhysicalMonitors();
+                if (AcquirePhysicalMonitors())
+                {
+                    success = WriteBrightnessDDC(m_physicalMonitors[0].hPhysicalMonitor, m_ddcPacer, brightness, detected);
+                }
+            }
+        }
+
+        // On failure the method is detected again on the next read
+        if (success)
+        {
+            changed = m_capabilities.Answered(detected, persist);
+        }
+        else
+        {
+            m_capabilities.Reset();
+        }
+    }
+
+    if (changed)
+    {
+        PersistCapabilities(persist);
+    }
+
+    return success;
+}
@@ -0,0 +1,148 @@
+/**
+ * BrightSync - DDC/CI Monitor
+ *
+ * External monitor controlled over DDC/CI (Display Data Channel Command Interface)
+ */
+
+#ifndef DDC_MONITOR_H
+#define DDC_MONITOR_H
+
+#include "real_monitor.h"
+#include "capability_store.h"
+#include "ddc_pacer.h"
+#include <windows.h>
+#include <physicalmonitorenumerationapi.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+/**
+ * External monitor backend
+ *
+ * The DDC/CI method that answers first (high-level API or VCP code 0x10) is
+ * recorded together with the raw maximum the monitor reports, and used
+ * directly afterwards; the other method is only tried when it fails. Values
+ * are scaled between 0-100 and that raw range in both directions.
+ * Commands are spaced by a DdcPacer, so callers may issue them back to back.
+ * Each monitor has its own hardware lane ("ddc:<id>"), which acquires and
+ * uses the physical monitor handles.
+ */
+class DdcMonitor : public RealMonitor
+{
+public:
+    /**
+     * Constructor
+     * @param id Unique monitor identifier
+     * @param name Human-readable monitor name
+     * @param hMonitor Windows monitor handle
+     *
+     * DDC/CI support is assumed until Probe() says otherwise.
+     */
+    DdcMonitor(const std::string &id, const std::string &name, HMONITOR hMonitor);
+
+    /**
+     * Destructor - destroys held physical monitor handles
+     */
+    virtual ~DdcMonitor();
+
+    /**
+     * Point this monitor at a new HMONITOR after a display change
+     * Drops cached physical monitor handles if the handle changed
+     * @param hMonitor Current Windows monitor handle
+     */
+    void UpdateMonitorHandle(HMONITOR hMonitor);
+
+    /**
+     * Use a capability store for this monitor (call before Probe())
+     * Remembered capabilities replace detection: a monitor known not to
+     * answer DDC/CI is not probed, a working one is asked the way that
+     * worked last time. Capabilities found or lost later are written back.
+     * @param store Store keyed by monitor ID; must outlive the monitor
+     */
+    void AttachCapabilityStore(CapabilityStore *store);
+
+    /**
+     * Get the DDC/CI capabilities detected so far
+     */
+    MonitorCapabilities GetCapabilities() const;
+
+    // IMonitor interface implementation
+    virtual int GetBrightness() const override;
+    virtual bool SetBrightness(int value) override;
+    virtual bool IsControllable() const override;
+
+protected:
+    virtual int ReadHardware() const override;
+    virtual bool WriteHardware(int value) override;
+
+    /**
+     * Read the current value in one transaction, which also detects DDC/CI
+     * support; the physical monitor handles it acquires are kept
+     */
+    virtual int ProbeHardware() override;
+
+private:
+    HMONITOR m_hMonitor;
+    mutable std::atomic<bool> m_supportsDDC; // optimistic until Probe() says otherwise
+
+    // Physical monitor handles for DDC/CI, acquired once on the lane and kept
+    // for the lifetime of the monitor (re-acquired only after a failed transaction)
+    mutable std::vector<PHYSICAL_MONITOR> m_physicalMonitors;
+
+    // Serializes DDC/CI transactions and access to the handle pool
+    mutable std::mutex m_ddcMutex;
+
+    // Keeps the MCCS gap between commands on this monitor's bus
+    mutable DdcPacer m_ddcPacer;
+
+    // How DDC/CI brightness was reached last time, and whether it ever was
+    // (guarded by m_ddcMutex)
+    mutable CapabilityTracker m_capabilities;
+
+    // Where capabilities are persisted (may be null)
+    CapabilityStore *m_capabilityStore;
+
+    // Set while "no DDC/CI" comes from the store rather than from this session
+    mutable std::atomic<bool> m_unsupportedFromStore;
+
+    /**
+     * Check "no DDC/CI" remembered from an earlier session once, when a
+     * read or write would fail because of it
+     * Detects the method again through the normal read path, so the circuit
+     * breaker and the read counters see the transaction.
+     */
+    void RecheckRememberedSupport() const;
+
+    /**
+     * Write capabilities to the store (must not hold m_ddcMutex)
+     */
+    void PersistCapabilities(const MonitorCapabilities &capabilities) const;
+
+    /**
+     * Acquire physical monitor handles if not already held
+     * Caller must hold m_ddcMutex
+     * @return true if at least one handle is available
+     */
+    bool AcquirePhysicalMonitors() const;
+
+    /**
+     * Destroy held physical monitor handles
+     * Caller must hold m_ddcMutex
+     */
+    void ReleasePhysicalMonitors() const;
+
+    /**
+     * Get brightness over DDC/CI
+     * @return Brightness value or -1 on error
+     */
+    int GetBrightnessDDC() const;
+
+    /**
+     * Set brightness over DDC/CI
+     * @param brightness Brightness value
+     * @return true on success, false on failure
+     */
+    bool SetBrightnessDDC(int brightness);
+};
+
+#endif // DDC_MONITOR_H
@@ -0,0 +1,77 @@
+/**
+ * BrightSync - DDC/CI Pacer Implementation
+ */
+
+#include "ddc_pacer.h"
+#include <thread>
+
+DdcPacer::DdcPacer(int safeIntervalMs, int minIntervalMs, int stepMs, int successesPerStep)
+    : m_safeIntervalMs(safeIntervalMs),
+      m_minIntervalMs(minIntervalMs < safeIntervalMs ? minIntervalMs : safeIntervalMs),
+      m_stepMs(stepMs > 0 ? stepMs : 1),
+      m_successesPerStep(successesPerStep > 0 ? successesPerStep : 1),
+      m_intervalMs(safeIntervalMs),
+      m_failedIntervalMs(0),
+      m_successes(0),
+      m_hasLast(false)
+{
+}
+
+void DdcPacer::WaitForSlot()
+{
+    std::chrono::steady_clock::time_point next;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_hasLast)
+        {
+            return;
+        }
+        next = m_last + std::chrono::milliseconds(m_intervalMs);
+    }
+
+    std::this_thread::sleep_until(next);
+}
+
+void DdcPacer::Complete(bool success)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_last = std::chrono::steady_clock::now();
+    m_hasLast = true;
+
+    if (!success)
+    {
+        if (m_intervalMs < m_safeIntervalMs)
+        {
+            // Too fast for this monitor; go back and never try this gap again
+            if (m_intervalMs > m_failedIntervalMs)
+            {
+                m_failedIntervalMs = m_intervalMs;
+            }
+            m_intervalMs = m_safeIntervalMs;
+        }
+        m_successes = 0;
+        return;
+    }
+
+    if (++m_successes < m_successesPerStep)
+    {
+        return;
+    }
+    m_successes = 0;
+
+    int next = m_intervalMs - m_stepMs;
+    if (next < m_minIntervalMs)
+    {
+        next = m_minIntervalMs;
+    }
+    if (next > m_failedIntervalMs)
+    {
+        m_intervalMs = next;
+    }
+}
+
+int DdcPacer::GetIntervalMs() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_intervalMs;
+}
@@ -0,0 +1,91 @@
+/**
+ * BrightSync - DDC/CI Pacer
+ *
+ * Spaces DDC/CI commands sent to one monitor
+ */
+
+#ifndef DDC_PACER_H
+#define DDC_PACER_H
+
+#include <mutex>
+#include <chrono>
+
+/**
+ * Minimum gap between commands on one DDC/CI bus
+ *
+ * MCCS asks hosts to leave about 50 ms between two commands; monitors may
+ * drop commands sent faster, and some firmwares stop answering until they
+ * are power cycled. Every transaction waits until the gap since the end of
+ * the previous one has passed.
+ *
+ * Monitors that tolerate faster timing are allowed to earn it: after a run
+ * of successful transactions the gap shrinks by one step, down to a floor.
+ * A failure at a shortened gap restores the safe gap and the failed gap is
+ * never used again. Failures at the safe gap do not change the pacing
+ * (the monitor may not support the command, or may be off).
+ *
+ * All methods are thread-safe.
+ */
+class DdcPacer
+{
+public:
+    static const int SAFE_INTERVAL_MS = 50;
+    static const int MIN_INTERVAL_MS = 10;
+    static const int INTERVAL_STEP_MS = 5;
+    static const int SUCCESSES_PER_STEP = 8;
+
+    /**
+     * Constructor
+     * @param safeIntervalMs Gap used until the monitor proved it is faster
+     * @param minIntervalMs Lower bound for the learned gap
+     * @param stepMs Amount the gap shrinks on each step
+     * @param successesPerStep Consecutive successes needed for a step
+     */
+    explicit DdcPacer(int safeIntervalMs = SAFE_INTERVAL_MS,
+                      int minIntervalMs = MIN_INTERVAL_MS,
+                      int stepMs = INTERVAL_STEP_MS,
+                      int successesPerStep = SUCCESSES_PER_STEP);
+
+    /**
+     * Block until the next command may be sent
+     */
+    void WaitForSlot();
+
+    /**
+     * Report the end of a transaction
+     * @param success Whether the monitor answered
+     */
+    void Complete(bool success);
+
+    /**
+     * Current gap between commands in milliseconds
+     */
+    int GetIntervalMs() const;
+
+    /**
+     * Run one transaction: wait for a slot, call, report the result
+     * @return Result of the call
+     */
+    template <typename Call>
+    auto Run(Call call) -> decltype(call())
+    {
+        WaitForSlot();
+        auto result = call();
+        Complete(result ? true : false);
+        return result;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    const int m_safeIntervalMs;
+    const int m_minIntervalMs;
+    const int m_stepMs;
+    const int m_successesPerStep;
+    int m_intervalMs;
+    int m_failedIntervalMs; // largest shortened gap that failed (0 = none)
+    int m_successes;
+    bool m_hasLast;
+    std::chrono::steady_clock::time_point m_last;
+};
+
+#endif // DDC_PACER_H
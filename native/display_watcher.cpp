@@ -0,0 +1,204 @@
+/**
+ * BrightSync - Display Watcher
+ *
+ * Hidden message window that reports display topology changes
+ */
+
+#include "display_watcher.h"
+#include "native_log.h"
+#include <dbt.h>
+
+#pragma comment(lib, "User32.lib")
+
+// GUID_DEVINTERFACE_MONITOR {E6F07B5F-EE97-4a90-B076-33F57BF4EAA7}
+static const GUID kMonitorInterfaceGuid =
+    {0xe6f07b5f, 0xee97, 0x4a90, {0xb0, 0x76, 0x33, 0xf5, 0x7b, 0xf4, 0xea, 0xa7}};
+
+static const wchar_t *kWindowClassName = L"BrightSyncDisplayWatcher";
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+DisplayWatcher::DisplayWatcher()
+    : m_hwnd(NULL),
+      m_hDevNotify(NULL),
+      m_startDone(false),
+      m_running(false)
+{
+}
+
+DisplayWatcher::~DisplayWatcher()
+{
+    Stop();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool DisplayWatcher::Start(ChangeCallback onChange)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_running)
+    {
+        return true;
+    }
+
+    // Join a thread left over from a failed start
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    m_onChange = onChange;
+    m_startDone = false;
+    m_thread = std::thread(&DisplayWatcher::Run, this);
+
+    m_started.wait(lock, [this]()
+                   { return m_startDone; });
+
+    return m_running;
+}
+
+void DisplayWatcher::Stop()
+{
+    HWND hwnd = NULL;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        hwnd = m_hwnd;
+    }
+
+    if (hwnd)
+    {
+        PostMessage(hwnd, WM_CLOSE, 0, 0);
+    }
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool DisplayWatcher::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+// ============================================================================
+// Watcher Thread
+// ============================================================================
+
+void DisplayWatcher::Run()
+{
+    HINSTANCE hInstance = GetModuleHandle(NULL);
+
+    WNDCLASSEXW wc = {};
+    wc.cbSize = sizeof(WNDCLASSEXW);
+    wc.lpfnWndProc = WindowProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = kWindowClassName;
+
+    // Fails harmlessly with ERROR_CLASS_ALREADY_EXISTS on restart
+    RegisterClassExW(&wc);
+
+    // Hidden top-level window (never shown)
+    HWND hwnd = CreateWindowExW(0, kWindowClassName, L"", 0, 0, 0, 0, 0,
+                                NULL, NULL, hInstance, this);
+
+    HDEVNOTIFY hDevNotify = NULL;
+    if (hwnd)
+    {
+        DEV_BROADCAST_DEVICEINTERFACE_W filter = {};
+        filter.dbcc_size = sizeof(filter);
+        filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+        filter.dbcc_classguid = kMonitorInterfaceGuid;
+
+        hDevNotify = RegisterDeviceNotificationW(hwnd, &filter, DEVICE_NOTIFY_WINDOW_HANDLE);
+        if (!hDevNotify)
+        {
+            // WM_DISPLAYCHANGE still arrives; only hotplug without a mode change is missed
+            BS_LOG_WARN("[DisplayWatcher] WARNING: RegisterDeviceNotification failed (error "
+                        << GetLastError() << ")");
+        }
+    }
+    else
+    {
+        BS_LOG_ERROR("[DisplayWatcher] ERROR: Failed to create watcher window (error "
+                     << GetLastError() << ")");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hwnd = hwnd;
+        m_hDevNotify = hDevNotify;
+        m_running = (hwnd != NULL);
+        m_startDone = true;
+    }
+    m_started.notify_all();
+
+    if (!hwnd)
+    {
+        return;
+    }
+
+    MSG msg;
+    while (GetMessage(&msg, NULL, 0, 0) > 0)
+    {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_hDevNotify)
+    {
+        UnregisterDeviceNotification(m_hDevNotify);
+        m_hDevNotify = NULL;
+    }
+    m_hwnd = NULL;
+    m_running = false;
+}
+
+LRESULT CALLBACK DisplayWatcher::WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    if (msg == WM_NCCREATE)
+    {
+        CREATESTRUCTW *cs = reinterpret_cast<CREATESTRUCTW *>(lParam);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(cs->lpCreateParams));
+    }
+
+    DisplayWatcher *self = reinterpret_cast<DisplayWatcher *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+
+    switch (msg)
+    {
+    case WM_DISPLAYCHANGE:
+        if (self && self->m_onChange)
+        {
+            self->m_onChange();
+        }
+        return 0;
+
+    case WM_DEVICECHANGE:
+        if (wParam == DBT_DEVICEARRIVAL || wParam == DBT_DEVICEREMOVECOMPLETE ||
+            wParam == DBT_DEVNODES_CHANGED)
+        {
+            if (self && self->m_onChange)
+            {
+                self->m_onChange();
+            }
+        }
+        return TRUE;
+
+    case WM_CLOSE:
+        DestroyWindow(hwnd);
+        return 0;
+
+    case WM_DESTROY:
+        PostQuitMessage(0);
+        return 0;
+    }
+
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
@@ -0,0 +1,81 @@
+/**
+ * BrightSync - Display Watcher
+ *
+ * Hidden message window that reports display topology changes
+ */
+
+#ifndef DISPLAY_WATCHER_H
+#define DISPLAY_WATCHER_H
+
+#include <windows.h>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Watches for display configuration changes
+ *
+ * Runs a hidden top-level window on its own thread (message-only windows do
+ * not receive broadcasts such as WM_DISPLAYCHANGE) and registers for monitor
+ * device interface notifications. The callback runs on the watcher thread
+ * whenever displays are added, removed or reconfigured.
+ *
+ * This thread uses neither COM nor WMI, so it is not one of the
+ * HardwareExecutor lanes: it has to block in GetMessage for the lifetime
+ * of the window, which would stall every command queued behind it. The
+ * enumeration it triggers runs its WMI query on the WMI lane.
+ */
+class DisplayWatcher
+{
+public:
+    typedef std::function<void()> ChangeCallback;
+
+    DisplayWatcher();
+
+    /**
+     * Destructor - stops the watcher thread
+     */
+    ~DisplayWatcher();
+
+    DisplayWatcher(const DisplayWatcher &) = delete;
+    DisplayWatcher &operator=(const DisplayWatcher &) = delete;
+
+    /**
+     * Start watching (no-op if already running)
+     * @param onChange Called on the watcher thread for every topology change
+     * @return true if the window was created and notifications registered
+     */
+    bool Start(ChangeCallback onChange);
+
+    /**
+     * Stop watching and join the watcher thread
+     */
+    void Stop();
+
+    /**
+     * Check if the watcher is running
+     */
+    bool IsRunning() const;
+
+private:
+    static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+    /**
+     * Watcher thread body: create window, pump messages, clean up
+     */
+    void Run();
+
+    ChangeCallback m_onChange;
+    std::thread m_thread;
+    HWND m_hwnd;
+    HDEVNOTIFY m_hDevNotify;
+
+    // Start() waits until Run() has created (or failed to create) the window
+    mutable std::mutex m_mutex;
+    std::condition_variable m_started;
+    bool m_startDone;
+    bool m_running;
+};
+
+#endif // DISPLAY_WATCHER_H
@@ -0,0 +1,221 @@
+/**
+ * BrightSync - Hardware Executor Implementation
+ */
+
+#include "hardware_executor.h"
+#include "trace_recorder.h"
+#include "native_log.h"
+#include <deque>
+#include <thread>
+#include <future>
+#include <condition_variable>
+#include <system_error>
+
+const char *const HardwareExecutor::WMI_LANE = "wmi";
+
+/**
+ * One lane: a thread and its command queue
+ */
+struct HardwareExecutor::Lane
+{
+    std::string name;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::packaged_task<void()>> commands;
+    bool stopping = false;
+};
+
+// Lane whose thread is the calling thread (null elsewhere)
+static thread_local const void *t_currentLane = nullptr;
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+HardwareExecutor &HardwareExecutor::Instance()
+{
+    // Leaked on purpose: monitors may be used during static destruction
+    static HardwareExecutor *executor = new HardwareExecutor();
+    return *executor;
+}
+
+HardwareExecutor::HardwareExecutor()
+    : m_shutdown(false)
+{
+}
+
+HardwareExecutor::~HardwareExecutor()
+{
+    Shutdown();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+bool HardwareExecutor::Run(const std::string &lane, const Task &task)
+{
+    std::shared_ptr<Lane> target = GetLane(lane);
+    if (!target)
+    {
+        return false;
+    }
+    if (t_currentLane == target.get())
+    {
+        task();
+        return true;
+    }
+
+    // The caller's trace request continues on the lane thread
+    TraceHandoff handoff;
+    std::packaged_task<void()> command([&task, &handoff]()
+                                       {
+        TraceRequestScope request(handoff, "lane wait", "queue");
+        task(); });
+    std::future<void> done = command.get_future();
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(target->mutex);
+        if (!target->stopping)
+        {
+            target->commands.push_back(std::move(command));
+            queued = true;
+        }
+    }
+
+    if (!queued)
+    {
+        // Stopped after the lane was looked up
+        return false;
+    }
+
+    target->wake.notify_one();
+
+    // Rethrows what the command threw
+    done.get();
+    return true;
+}
+
+bool HardwareExecutor::IsLaneThread(const std::string &lane) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_lanes.find(lane);
+    return it != m_lanes.end() && t_currentLane == it->second.get();
+}
+
+size_t HardwareExecutor::GetLaneCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lanes.size();
+}
+
+void HardwareExecutor::StopLane(const std::string &name)
+{
+    std::shared_ptr<Lane> lane;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_lanes.find(name);
+        if (it == m_lanes.end() || t_currentLane == it->second.get())
+        {
+            return;
+        }
+        lane = it->second;
+        m_lanes.erase(it);
+    }
+
+    JoinLane(*lane);
+}
+
+void HardwareExecutor::Shutdown()
+{
+    std::map<std::string, std::shared_ptr<Lane>> lanes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        lanes.swap(m_lanes);
+    }
+
+    for (auto &entry : lanes)
+    {
+        JoinLane(*entry.second);
+    }
+}
+
+// ============================================================================
+// Lanes
+// ============================================================================
+
+std::shared_ptr<HardwareExecutor::Lane> HardwareExecutor::GetLane(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_shutdown)
+    {
+        return nullptr;
+    }
+
+    auto it = m_lanes.find(name);
+    if (it != m_lanes.end())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<Lane> lane = std::make_shared<Lane>();
+    lane->name = name;
+    try
+    {
+        lane->thread = std::thread(&HardwareExecutor::RunLane, lane.get());
+    }
+    catch (const std::system_error &)
+    {
+        // Could not spawn a thread; the command fails
+        BS_LOG_ERROR("Could not start hardware lane '" << name << "'");
+        return nullptr;
+    }
+
+    m_lanes[name] = lane;
+    return lane;
+}
+
+void HardwareExecutor::JoinLane(Lane &lane)
+{
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        lane.stopping = true;
+    }
+    lane.wake.notify_all();
+
+    if (lane.thread.joinable())
+    {
+        lane.thread.join();
+    }
+}
+
+void HardwareExecutor::RunLane(Lane *lane)
+{
+    t_currentLane = lane;
+    TraceRecorder::NameThread("lane " + lane->name);
+
+    std::unique_lock<std::mutex> lock(lane->mutex);
+    for (;;)
+    {
+        lane->wake.wait(lock, [lane]()
+                        { return lane->stopping || !lane->commands.empty(); });
+
+        if (lane->commands.empty())
+        {
+            // Stopping and drained
+            return;
+        }
+
+        std::packaged_task<void()> command = std::move(lane->commands.front());
+        lane->commands.pop_front();
+
+        // Run without the lock so callers can queue the next command
+        lock.unlock();
+        command();
+        lock.lock();
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * BrightSync - Hardware Executor
+ *
+ * Dedicated threads that perform all monitor I/O
+ */
+
+#ifndef HARDWARE_EXECUTOR_H
+#define HARDWARE_EXECUTOR_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <functional>
+
+/**
+ * Marshals hardware commands to one thread per bus ("lane")
+ *
+ * Every lane is a long-lived thread with a FIFO command queue, started the
+ * first time a command is sent to it. Whatever runs on a lane thread - COM
+ * apartments, WMI sessions, physical monitor handles - is created there once
+ * and is never touched by another thread, so callers on the JS thread or
+ * the libuv pool need no per-call setup and cannot race each other. Real
+ * monitors use the WMI_LANE for internal panels and one lane per DDC/CI bus.
+ *
+ * Run() blocks until the command has finished on its lane and rethrows any
+ * exception it threw. Commands sent from the lane's own thread run inline,
+ * so a command may call other operations of the same monitor. A command is
+ * never run on any other thread: after Shutdown(), while its lane is being
+ * stopped, or if the lane thread cannot be started, Run() returns false
+ * without running it and the caller fails the operation.
+ *
+ * All methods are thread-safe.
+ */
+class HardwareExecutor
+{
+public:
+    typedef std::function<void()> Task;
+
+    // Lane shared by all internal panels (one WMI provider, one COM apartment)
+    static const char *const WMI_LANE;
+
+    /**
+     * Get the process-wide executor
+     */
+    static HardwareExecutor &Instance();
+
+    HardwareExecutor();
+
+    /**
+     * Destructor - stops all lanes
+     */
+    ~HardwareExecutor();
+
+    HardwareExecutor(const HardwareExecutor &) = delete;
+    HardwareExecutor &operator=(const HardwareExecutor &) = delete;
+
+    /**
+     * Run a command on a lane and wait for it
+     * @param lane Lane name (started on first use)
+     * @param task Command to run
+     * @return false if the command was not run (no lane thread for it)
+     */
+    bool Run(const std::string &lane, const Task &task);
+
+    /**
+     * Check if the calling thread is the thread of a lane
+     */
+    bool IsLaneThread(const std::string &lane) const;
+
+    /**
+     * Number of running lanes
+     */
+    size_t GetLaneCount() const;
+
+    /**
+     * Finish queued commands of a lane and join its thread
+     * For lanes of a single monitor, once that monitor is gone. A later
+     * command starts the lane again. Ignored on the lane's own thread.
+     */
+    void StopLane(const std::string &lane);
+
+    /**
+     * Finish queued commands and join all lanes
+     * Later commands are not run.
+     */
+    void Shutdown();
+
+private:
+    struct Lane;
+
+    /**
+     * Get a lane, starting it if needed
+     * @return Lane, or nullptr after Shutdown() or if no thread could be started
+     */
+    std::shared_ptr<Lane> GetLane(const std::string &name);
+
+    /**
+     * Lane thread body: run commands until stopped and drained
+     */
+    static void RunLane(Lane *lane);
+
+    /**
+     * Let a lane drain its queue and join it
+     */
+    static void JoinLane(Lane &lane);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<Lane>> m_lanes;
+    bool m_shutdown;
+};
+
+#endif // HARDWARE_EXECUTOR_H
@@ -0,0 +1,99 @@
+/**
+ * BrightSync - Health Watcher Implementation
+ */
+
+#include "health_watcher.h"
+#include <exception>
+
+HealthWatcher::HealthWatcher()
+    : m_stopRequested(false)
+{
+}
+
+HealthWatcher::~HealthWatcher()
+{
+    Stop();
+}
+
+void HealthWatcher::Start(MonitorSource source, RecoveryCallback onRecovered, std::chrono::milliseconds interval)
+{
+    Stop();
+
+    m_stopRequested = false;
+    m_thread = std::thread(&HealthWatcher::Run, this, std::move(source), std::move(onRecovered), interval);
+}
+
+void HealthWatcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool HealthWatcher::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_thread.joinable() && !m_stopRequested;
+}
+
+size_t HealthWatcher::Check(const std::vector<std::shared_ptr<IMonitor>> &monitors, const RecoveryCallback &onRecovered)
+{
+    size_t recovered = 0;
+
+    for (const auto &monitor : monitors)
+    {
+        if (!monitor || monitor->IsResponding())
+        {
+            continue;
+        }
+
+        bool responding = false;
+        try
+        {
+            responding = monitor->CheckHealth();
+        }
+        catch (const std::exception &)
+        {
+            // Treated like a failed probe
+        }
+
+        if (!responding)
+        {
+            continue;
+        }
+
+        recovered++;
+        if (onRecovered)
+        {
+            onRecovered(monitor);
+        }
+    }
+
+    return recovered;
+}
+
+void HealthWatcher::Run(MonitorSource source, RecoveryCallback onRecovered, std::chrono::milliseconds interval)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        if (m_wake.wait_for(lock, interval, [this]()
+                            { return m_stopRequested; }))
+        {
+            return;
+        }
+
+        // Probe without the lock so Stop() only waits for a running probe
+        lock.unlock();
+        Check(source ? source() : std::vector<std::shared_ptr<IMonitor>>(), onRecovered);
+        lock.lock();
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * BrightSync - Health Watcher
+ *
+ * Brings monitors that stopped answering back into service
+ */
+
+#ifndef HEALTH_WATCHER_H
+#define HEALTH_WATCHER_H
+
+#include "monitor_interface.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * Background recovery probing
+ *
+ * A monitor whose circuit breaker is open fails every call fast (see
+ * IMonitor::IsResponding). This thread calls IMonitor::CheckHealth() on
+ * those monitors; each monitor decides from its own backoff whether the
+ * hardware is tried, so a round is free while nothing is due. The probe of
+ * a dead monitor only delays this thread: the monitors that still answer
+ * keep running on their own hardware threads.
+ */
+class HealthWatcher
+{
+public:
+    /**
+     * Monitors to check; called on the watcher thread before every round
+     */
+    typedef std::function<std::vector<std::shared_ptr<IMonitor>>()> MonitorSource;
+
+    /**
+     * Invoked on the watcher thread when a monitor answers again
+     */
+    typedef std::function<void(const std::shared_ptr<IMonitor> &monitor)> RecoveryCallback;
+
+    HealthWatcher();
+
+    /**
+     * Destructor - stops the watcher thread
+     */
+    ~HealthWatcher();
+
+    HealthWatcher(const HealthWatcher &) = delete;
+    HealthWatcher &operator=(const HealthWatcher &) = delete;
+
+    /**
+     * Start checking every interval (replaces a running watcher)
+     * @param source Monitors to check in each round
+     * @param onRecovered Called for every monitor that answers again
+     * @param interval Time between rounds
+     */
+    void Start(MonitorSource source, RecoveryCallback onRecovered, std::chrono::milliseconds interval);
+
+    /**
+     * Stop and join the watcher thread (waits for a running probe)
+     */
+    void Stop();
+
+    /**
+     * Check if the watcher thread is running
+     */
+    bool IsRunning() const;
+
+    /**
+     * Check monitors once on the calling thread
+     * @return Number of monitors that answer again
+     */
+    static size_t Check(const std::vector<std::shared_ptr<IMonitor>> &monitors, const RecoveryCallback &onRecovered);
+
+private:
+    void Run(MonitorSource source, RecoveryCallback onRecovered, std::chrono::milliseconds interval);
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopRequested;
+};
+
+#endif // HEALTH_WATCHER_H
@@ -0,0 +1,67 @@
+/**
+ * BrightSync - Internal WMI Monitor Implementation
+ */
+
+#include "internal_wmi_monitor.h"
+#include "wmi_session.h"
+#include "hardware_executor.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+InternalWmiMonitor::InternalWmiMonitor(
+    const std::string &id,
+    const std::string &name,
+    const std::wstring &wmiInstance,
+    int initialBrightness)
+    : RealMonitor(id, name, MonitorType::Internal, HardwareExecutor::WMI_LANE, initialBrightness),
+      m_wmiInstance(wmiInstance)
+{
+}
+
+const std::wstring &InternalWmiMonitor::GetWmiInstance() const
+{
+    return m_wmiInstance;
+}
+
+// ============================================================================
+// Backend
+// ============================================================================
+
+bool InternalWmiMonitor::IsControllable() const
+{
+    // Internal panels are always driven through WMI; failures surface per call
+    return true;
+}
+
+int InternalWmiMonitor::GetHardwareRampResolutionMs() const
+{
+    return 1000;
+}
+
+int InternalWmiMonitor::ReadHardware() const
+{
+    return WmiSession::ForCurrentThread().GetBrightness(m_wmiInstance);
+}
+
+bool InternalWmiMonitor::WriteHardware(int value)
+{
+    return WmiSession::ForCurrentThread().SetBrightness(value, m_wmiInstance);
+}
+
+bool InternalWmiMonitor::WriteHardwareRamped(int value, int durationMs)
+{
+    return WmiSession::ForCurrentThread().SetBrightness(value, m_wmiInstance, durationMs / 1000);
+}
+
+int InternalWmiMonitor::ProbeHardware()
+{
+    // Read together with every other panel during enumeration
+    if (IsInitialBrightnessKnown())
+    {
+        return GetLastKnownBrightness();
+    }
+
+    return ReadHardwareBrightness();
+}
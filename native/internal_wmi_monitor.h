@@ -0,0 +1,60 @@
+/**
+ * BrightSync - Internal WMI Monitor
+ *
+ * Laptop panel controlled through WmiMonitorBrightness(Methods)
+ */
+
+#ifndef INTERNAL_WMI_MONITOR_H
+#define INTERNAL_WMI_MONITOR_H
+
+#include "real_monitor.h"
+#include <string>
+
+/**
+ * Internal panel backend
+ *
+ * Reads and writes go through the calling thread's WmiSession to the panel
+ * named by its WMI InstanceName, so devices with several panels address
+ * each one directly.
+ */
+class InternalWmiMonitor : public RealMonitor
+{
+public:
+    /**
+     * Constructor
+     * @param id Unique monitor identifier
+     * @param name Human-readable monitor name
+     * @param wmiInstance WmiMonitorBrightness InstanceName (empty = the first
+     *                    active panel)
+     * @param initialBrightness Brightness read by the enumeration query, or -1;
+     *                          a known value is not read again by Probe()
+     */
+    InternalWmiMonitor(
+        const std::string &id,
+        const std::string &name,
+        const std::wstring &wmiInstance,
+        int initialBrightness = -1);
+
+    /**
+     * Get the WMI panel this monitor writes to
+     */
+    const std::wstring &GetWmiInstance() const;
+
+    virtual bool IsControllable() const override;
+
+    /**
+     * WmiSetBrightness fades the panel over its Timeout, given in seconds
+     */
+    virtual int GetHardwareRampResolutionMs() const override;
+
+protected:
+    virtual int ReadHardware() const override;
+    virtual bool WriteHardware(int value) override;
+    virtual bool WriteHardwareRamped(int value, int durationMs) override;
+    virtual int ProbeHardware() override;
+
+private:
+    std::wstring m_wmiInstance; // immutable
+};
+
+#endif // INTERNAL_WMI_MONITOR_H
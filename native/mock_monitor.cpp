@@ -5,9 +5,35 @@
  */
 
 #include "mock_monitor.h"
-#include <iostream>
-#include <sstream>
+#include "native_log.h"
+#include "trace_recorder.h"
 #include <algorithm>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+// ============================================================================
+// Timing Presets
+// ============================================================================
+
+MockTiming MockTiming::Ddc()
+{
+    MockTiming timing;
+    timing.readLatencyUs = 40000;
+    timing.writeLatencyUs = 50000;
+    timing.jitterUs = 10000;
+    timing.failureRate = 0.02;
+    return timing;
+}
+
+MockTiming MockTiming::Wmi()
+{
+    MockTiming timing;
+    timing.readLatencyUs = 5000;
+    timing.writeLatencyUs = 8000;
+    timing.jitterUs = 2000;
+    return timing;
+}
 
 // ============================================================================
 // Constructor / Destructor
@@ -17,100 +43,203 @@ MockMonitor::MockMonitor(
     const std::string &id,
     const std::string &name,
     const std::string &type,
-    int initialBrightness)
-    : m_id(id),
-      m_name(name),
-      m_type(type),
-      m_minBrightness(0),
-      m_maxBrightness(100),
-      m_currentBrightness(initialBrightness)
+    int initialBrightness,
+    const MockTiming &timing,
+    int maxValue)
+    : m_descriptor{id, name, ParseMonitorType(type), 0, 100},
+      m_maxValue(maxValue > 0 ? maxValue : 100),
+      m_currentBrightness(initialBrightness),
+      m_lastKnownBrightness(initialBrightness),
+      m_timing(timing),
+      m_random(static_cast<std::mt19937::result_type>(std::hash<std::string>()(id)))
 {
     // Clamp initial brightness to valid range
-    m_currentBrightness = std::max(m_minBrightness, std::min(m_maxBrightness, m_currentBrightness));
+    m_currentBrightness = Quantize(std::max(m_descriptor.minBrightness, std::min(m_descriptor.maxBrightness, initialBrightness)));
+    m_lastKnownBrightness = m_currentBrightness.load();
 
-    std::ostringstream oss;
-    oss << "Monitor '" << m_name << "' (ID: " << m_id << ", Type: " << m_type << ") initialized with brightness " << m_currentBrightness;
-    Log(oss.str());
+    BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' (ID: " << m_descriptor.id << ", Type: " << MonitorTypeName(m_descriptor.type) << ") initialized with brightness " << m_currentBrightness);
 }
 
 MockMonitor::~MockMonitor()
 {
-    std::ostringstream oss;
-    oss << "Monitor '" << m_name << "' (ID: " << m_id << ") destroyed";
-    Log(oss.str());
+    BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' (ID: " << m_descriptor.id << ") destroyed");
 }
 
 // ============================================================================
 // IMonitor Interface Implementation
 // ============================================================================
 
-std::string MockMonitor::GetId() const
+const MonitorDescriptor &MockMonitor::GetDescriptor() const
 {
-    return m_id;
+    return m_descriptor;
 }
 
-std::string MockMonitor::GetName() const
+int MockMonitor::GetBrightness() const
 {
-    return m_name;
-}
+    // Like RealMonitor, a failed read answers with the last known value
+    if (!m_breaker.Allow() || !SimulateCall(false))
+    {
+        return m_lastKnownBrightness;
+    }
 
-std::string MockMonitor::GetType() const
-{
-    return m_type;
-}
+    m_lastKnownBrightness = m_currentBrightness.load();
 
-int MockMonitor::GetMinBrightness() const
-{
-    return m_minBrightness;
-}
+    BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' brightness read: " << m_lastKnownBrightness);
 
-int MockMonitor::GetMaxBrightness() const
-{
-    return m_maxBrightness;
+    return m_lastKnownBrightness;
 }
 
-int MockMonitor::GetBrightness() const
+int MockMonitor::GetLastKnownBrightness() const
 {
-    std::ostringstream oss;
-    oss << "Monitor '" << m_name << "' brightness read: " << m_currentBrightness;
-    Log(oss.str());
-
-    return m_currentBrightness;
+    return m_lastKnownBrightness;
 }
 
 bool MockMonitor::SetBrightness(int value)
 {
+    if (!m_breaker.Allow())
+    {
+        BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' not responding; write failed fast");
+        return false;
+    }
+
+    if (!SimulateCall(true))
+    {
+        BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' simulated write failure");
+        return false;
+    }
+
     // Clamp value to valid range
-    int clampedValue = std::max(m_minBrightness, std::min(m_maxBrightness, value));
+    int clampedValue = std::max(m_descriptor.minBrightness, std::min(m_descriptor.maxBrightness, value));
 
     // Check if value was clamped
     if (clampedValue != value)
     {
-        std::ostringstream oss;
-        oss << "Monitor '" << m_name << "' brightness value " << value << " clamped to " << clampedValue;
-        Log(oss.str());
+        BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' brightness value " << value << " clamped to " << clampedValue);
     }
 
-    m_currentBrightness = clampedValue;
+    m_currentBrightness = Quantize(clampedValue);
+    m_lastKnownBrightness = m_currentBrightness.load();
 
-    std::ostringstream oss;
-    oss << "Monitor '" << m_name << "' brightness set to " << m_currentBrightness;
-    Log(oss.str());
+    BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' brightness set to " << m_currentBrightness);
 
     return true;
 }
 
+int MockMonitor::GetHardwareRampResolutionMs() const
+{
+    std::lock_guard<std::mutex> lock(m_timingMutex);
+    return m_timing.rampResolutionMs;
+}
+
+bool MockMonitor::SetBrightnessRamped(int value, int durationMs)
+{
+    if (GetHardwareRampResolutionMs() > 0 && durationMs > 0)
+    {
+        // One command; the simulated panel takes the target value at once
+        BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' fading to " << value << " over " << durationMs << " ms");
+    }
+
+    return SetBrightness(value);
+}
+
 bool MockMonitor::IsControllable() const
 {
     // Mock monitors are always controllable
     return true;
 }
 
+bool MockMonitor::Probe()
+{
+    // Simulated monitors are known from construction
+    return true;
+}
+
+bool MockMonitor::IsProbed() const
+{
+    return true;
+}
+
+bool MockMonitor::IsResponding() const
+{
+    return m_breaker.Allow();
+}
+
+bool MockMonitor::CheckHealth()
+{
+    if (!m_breaker.IsProbeDue())
+    {
+        return m_breaker.Allow();
+    }
+
+    if (!SimulateCall(false))
+    {
+        return false;
+    }
+
+    m_lastKnownBrightness = m_currentBrightness.load();
+    return true;
+}
+
+void MockMonitor::Retire()
+{
+    // Mocks run on the calling thread
+}
+
 // ============================================================================
-// Private Methods
+// Simulated Timing
 // ============================================================================
 
-void MockMonitor::Log(const std::string &message) const
+void MockMonitor::SetTiming(const MockTiming &timing)
+{
+    std::lock_guard<std::mutex> lock(m_timingMutex);
+    m_timing = timing;
+}
+
+MockTiming MockMonitor::GetTiming() const
 {
-    std::cout << "[MOCK MODE] " << message << std::endl;
+    std::lock_guard<std::mutex> lock(m_timingMutex);
+    return m_timing;
 }
+
+void MockMonitor::SimulateExternalChange(int value)
+{
+    m_currentBrightness = Quantize(std::max(m_descriptor.minBrightness, std::min(m_descriptor.maxBrightness, value)));
+
+    BS_LOG_DEBUG("[MOCK MODE] Monitor '" << m_descriptor.name << "' changed externally to " << m_currentBrightness);
+}
+
+int MockMonitor::Quantize(int percent) const
+{
+    int raw = (percent * m_maxValue + 50) / 100;
+    return (raw * 100 + m_maxValue / 2) / m_maxValue;
+}
+
+bool MockMonitor::SimulateCall(bool write) const
+{
+    TraceSpan span(write ? "hardware write" : "hardware read", "mock", m_descriptor.id);
+
+    int delayUs;
+    bool success;
+    {
+        std::lock_guard<std::mutex> lock(m_timingMutex);
+        delayUs = write ? m_timing.writeLatencyUs : m_timing.readLatencyUs;
+        if (m_timing.jitterUs > 0)
+        {
+            delayUs += std::uniform_int_distribution<int>(-m_timing.jitterUs, m_timing.jitterUs)(m_random);
+        }
+        success = m_timing.failureRate <= 0 ||
+                  std::uniform_real_distribution<double>(0, 1)(m_random) >= m_timing.failureRate;
+    }
+
+    if (delayUs > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+    }
+
+    if (m_breaker.Complete(success))
+    {
+        BS_LOG_INFO("[MOCK MODE] Monitor '" << m_descriptor.name << "' " << (success ? "is responding again" : "stopped responding"));
+    }
+    return success;
+}
+
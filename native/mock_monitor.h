@@ -9,14 +9,45 @@
 #define MOCK_MONITOR_H
 
 #include "monitor_interface.h"
+#include "circuit_breaker.h"
 #include <string>
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#include <random>
+
+/**
+ * Simulated hardware timing of a mock monitor
+ *
+ * The default completes instantly and never fails. Ddc() and Wmi() follow
+ * the timings seen on real hardware, for benchmarks and stress tests.
+ */
+struct MockTiming
+{
+    int readLatencyUs = 0;
+    int writeLatencyUs = 0;
+    int jitterUs = 0;       // each call takes latency +/- up to this much
+    double failureRate = 0; // chance (0-1) that a call fails
+    int rampResolutionMs = 0; // hardware fade granularity (0 = no hardware fade)
+
+    /**
+     * External monitor on DDC/CI: the VESA spec asks hosts to wait 40 ms
+     * after a VCP read and 50 ms after a write; some monitors NAK now and then
+     */
+    static MockTiming Ddc();
+
+    /**
+     * Internal panel through WMI: a few milliseconds per query, reliable
+     */
+    static MockTiming Wmi();
+};
 
 /**
  * Mock monitor implementation for testing
  *
  * Simulates monitor behavior without any hardware calls
  * Stores brightness state in memory and logs all operations
+ * Optionally waits and fails like real hardware (see MockTiming)
  */
 class MockMonitor : public IMonitor
 {
@@ -27,12 +58,17 @@ public:
      * @param name Human-readable monitor name
      * @param type Monitor type ("internal" or "external")
      * @param initialBrightness Initial brightness value (default 50)
+     * @param timing Simulated hardware timing (default: instant)
+     * @param maxValue Raw range of the simulated VCP control (0-maxValue);
+     *                 brightness is quantized to it like on real hardware
      */
     MockMonitor(
         const std::string &id,
         const std::string &name,
         const std::string &type,
-        int initialBrightness = 50);
+        int initialBrightness = 50,
+        const MockTiming &timing = MockTiming(),
+        int maxValue = 100);
 
     /**
      * Destructor
@@ -40,28 +76,56 @@ public:
     virtual ~MockMonitor();
 
     // IMonitor interface implementation
-    virtual std::string GetId() const override;
-    virtual std::string GetName() const override;
-    virtual std::string GetType() const override;
-    virtual int GetMinBrightness() const override;
-    virtual int GetMaxBrightness() const override;
+    virtual const MonitorDescriptor &GetDescriptor() const override;
     virtual int GetBrightness() const override;
+    virtual int GetLastKnownBrightness() const override;
     virtual bool SetBrightness(int value) override;
+    virtual int GetHardwareRampResolutionMs() const override;
+    virtual bool SetBrightnessRamped(int value, int durationMs) override;
     virtual bool IsControllable() const override;
+    virtual bool Probe() override;
+    virtual bool IsProbed() const override;
+    virtual bool IsResponding() const override;
+    virtual bool CheckHealth() override;
+    virtual void Retire() override;
+
+    /**
+     * Replace the simulated timing (thread-safe)
+     */
+    void SetTiming(const MockTiming &timing);
+    MockTiming GetTiming() const;
+
+    /**
+     * Change the simulated panel without going through SetBrightness
+     * Stands in for the OS or the monitor's OSD: the new value is seen by
+     * the next successful GetBrightness, not by GetLastKnownBrightness.
+     */
+    void SimulateExternalChange(int value);
 
 private:
-    std::string m_id;
-    std::string m_name;
-    std::string m_type;
-    int m_minBrightness;
-    int m_maxBrightness;
-    int m_currentBrightness;
+    /**
+     * Wait like the hardware would
+     * @return false if this call is simulated as failing
+     */
+    bool SimulateCall(bool write) const;
 
     /**
-     * Log operation to console
-     * @param message Log message
+     * Round a percentage to the nearest value the raw range can hold
      */
-    void Log(const std::string &message) const;
+    int Quantize(int percent) const;
+
+    MonitorDescriptor m_descriptor;
+    int m_maxValue;
+    std::atomic<int> m_currentBrightness;           // value of the simulated panel
+    mutable std::atomic<int> m_lastKnownBrightness; // last value read or written
+
+    // Guards the timing and its random source
+    mutable std::mutex m_timingMutex;
+    MockTiming m_timing;
+    mutable std::mt19937 m_random;
+
+    // Simulated failures open it like on real hardware
+    mutable CircuitBreaker m_breaker;
 };
 
 #endif // MOCK_MONITOR_H
@@ -0,0 +1,194 @@
+/**
+ * BrightSync - Mock Topology Implementation
+ */
+
+#include "mock_topology.h"
+#include <algorithm>
+
+// ============================================================================
+// MockDisplay
+// ============================================================================
+
+bool MockDisplay::IsConnectedAt(long long elapsedMs) const
+{
+    return elapsedMs >= connectAtMs && (disconnectAtMs < 0 || elapsedMs < disconnectAtMs);
+}
+
+// ============================================================================
+// MockTopology
+// ============================================================================
+
+MockTopology::MockTopology()
+    : m_start(std::chrono::steady_clock::now()),
+      m_internalCount(0),
+      m_externalCount(0)
+{
+}
+
+MockTopology MockTopology::Default()
+{
+    MockTopology topology;
+
+    MockDisplay internal;
+    internal.type = "internal";
+    topology.Add(internal);
+
+    MockDisplay external;
+    external.type = "external";
+    topology.Add(external, 2);
+
+    return topology;
+}
+
+void MockTopology::Add(const MockDisplay &display, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        MockDisplay copy = display;
+        bool internal = copy.type == "internal";
+        int index = internal ? m_internalCount++ : m_externalCount++;
+
+        if (copy.id.empty())
+        {
+            copy.id = std::string(internal ? "mock_internal_" : "mock_external_") + std::to_string(index);
+        }
+        else if (count > 1)
+        {
+            copy.id += "_" + std::to_string(i);
+        }
+
+        if (copy.name.empty())
+        {
+            copy.name = internal ? "Mock Internal Display" : "Mock External Display";
+            if (!internal || index > 0)
+            {
+                copy.name += " " + std::to_string(index + 1);
+            }
+        }
+        else if (count > 1)
+        {
+            copy.name += " " + std::to_string(i + 1);
+        }
+
+        m_displays.push_back(copy);
+    }
+}
+
+const std::vector<MockDisplay> &MockTopology::GetDisplays() const
+{
+    return m_displays;
+}
+
+std::vector<MockDisplay> MockTopology::GetConnected(long long elapsedMs) const
+{
+    std::vector<MockDisplay> connected;
+    for (const auto &display : m_displays)
+    {
+        if (display.IsConnectedAt(elapsedMs))
+        {
+            connected.push_back(display);
+        }
+    }
+    return connected;
+}
+
+long long MockTopology::GetNextChangeMs(long long elapsedMs) const
+{
+    long long next = -1;
+    auto consider = [&](long long time)
+    {
+        if (time > elapsedMs && (next < 0 || time < next))
+        {
+            next = time;
+        }
+    };
+
+    for (const auto &display : m_displays)
+    {
+        consider(display.connectAtMs);
+        if (display.disconnectAtMs >= 0)
+        {
+            consider(display.disconnectAtMs);
+        }
+    }
+    return next;
+}
+
+long long MockTopology::GetElapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - m_start)
+        .count();
+}
+
+std::chrono::steady_clock::time_point MockTopology::GetStartTime() const
+{
+    return m_start;
+}
+
+// ============================================================================
+// MockHotplugTimer
+// ============================================================================
+
+MockHotplugTimer::MockHotplugTimer()
+    : m_stopRequested(false)
+{
+}
+
+MockHotplugTimer::~MockHotplugTimer()
+{
+    Stop();
+}
+
+void MockHotplugTimer::Start(const std::shared_ptr<const MockTopology> &topology, ChangeCallback onChange)
+{
+    Stop();
+
+    if (!topology || topology->GetNextChangeMs(topology->GetElapsedMs()) < 0)
+    {
+        return;
+    }
+
+    m_stopRequested = false;
+    m_thread = std::thread(&MockHotplugTimer::Run, this, topology, std::move(onChange));
+}
+
+void MockHotplugTimer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void MockHotplugTimer::Run(std::shared_ptr<const MockTopology> topology, ChangeCallback onChange)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        long long next = topology->GetNextChangeMs(topology->GetElapsedMs());
+        if (next < 0)
+        {
+            return;
+        }
+
+        auto due = topology->GetStartTime() + std::chrono::milliseconds(next);
+        if (m_wake.wait_until(lock, due, [this]()
+                              { return m_stopRequested; }))
+        {
+            return;
+        }
+
+        // Report without the lock so Stop() is never blocked by the callback
+        lock.unlock();
+        onChange();
+        lock.lock();
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * BrightSync - Mock Topology
+ *
+ * Describes the simulated displays of mock mode, including hotplug events
+ */
+
+#ifndef MOCK_TOPOLOGY_H
+#define MOCK_TOPOLOGY_H
+
+#include "mock_monitor.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+
+/**
+ * One simulated display
+ */
+struct MockDisplay
+{
+    std::string id;   // generated by MockTopology::Add() when empty
+    std::string name; // generated by MockTopology::Add() when empty
+    std::string type = "external";
+    int brightness = 50;
+    int maxValue = 100;      // raw VCP range (0-maxValue)
+    MockTiming timing;       // default: instant and reliable
+    int connectAtMs = 0;     // plugged in at this time
+    int disconnectAtMs = -1; // unplugged at this time (-1 = never)
+
+    /**
+     * Check whether the display is plugged in
+     * @param elapsedMs Time since the topology was created
+     */
+    bool IsConnectedAt(long long elapsedMs) const;
+};
+
+/**
+ * Set of simulated displays
+ *
+ * Hotplug times are relative to the construction of the topology, so a
+ * topology applied by initialize() starts its event timeline there. The
+ * topology is immutable once in use; share it as a const pointer.
+ */
+class MockTopology
+{
+public:
+    /**
+     * Empty topology (no displays)
+     */
+    MockTopology();
+
+    /**
+     * The classic mock setup: one internal panel and two external monitors
+     */
+    static MockTopology Default();
+
+    /**
+     * Add copies of a display
+     * Missing IDs and names are generated per type ("mock_external_3",
+     * "Mock External Display 4"); given ones get a "_<n>" suffix if count > 1
+     */
+    void Add(const MockDisplay &display, int count = 1);
+
+    /**
+     * All displays, connected or not
+     */
+    const std::vector<MockDisplay> &GetDisplays() const;
+
+    /**
+     * Displays plugged in at the given time
+     */
+    std::vector<MockDisplay> GetConnected(long long elapsedMs) const;
+
+    /**
+     * Time of the first hotplug event after the given time
+     * @return Milliseconds since creation, or -1 if nothing changes any more
+     */
+    long long GetNextChangeMs(long long elapsedMs) const;
+
+    /**
+     * Milliseconds since the topology was created
+     */
+    long long GetElapsedMs() const;
+
+    /**
+     * Point in time hotplug offsets are measured from
+     */
+    std::chrono::steady_clock::time_point GetStartTime() const;
+
+private:
+    std::vector<MockDisplay> m_displays;
+    std::chrono::steady_clock::time_point m_start;
+    int m_internalCount;
+    int m_externalCount;
+};
+
+/**
+ * Plays back the hotplug events of a topology
+ *
+ * Calls the callback (on its own thread) at each time a simulated display
+ * is plugged in or out, the way DisplayWatcher reports real changes.
+ */
+class MockHotplugTimer
+{
+public:
+    typedef std::function<void()> ChangeCallback;
+
+    MockHotplugTimer();
+
+    /**
+     * Destructor - stops the timer thread
+     */
+    ~MockHotplugTimer();
+
+    MockHotplugTimer(const MockHotplugTimer &) = delete;
+    MockHotplugTimer &operator=(const MockHotplugTimer &) = delete;
+
+    /**
+     * Start playing back a topology (replaces a running one)
+     * Does nothing if the topology has no hotplug events
+     */
+    void Start(const std::shared_ptr<const MockTopology> &topology, ChangeCallback onChange);
+
+    /**
+     * Stop and join the timer thread
+     */
+    void Stop();
+
+private:
+    void Run(std::shared_ptr<const MockTopology> topology, ChangeCallback onChange);
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopRequested;
+};
+
+#endif // MOCK_TOPOLOGY_H
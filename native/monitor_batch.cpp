@@ -0,0 +1,105 @@
+/**
+ * BrightSync - Batched Brightness Writes
+ *
+ * Programs several monitors at once, one thread per physical bus
+ */
+
+#include "monitor_batch.h"
+#include "trace_recorder.h"
+#include <map>
+#include <thread>
+#include <exception>
+#include <system_error>
+
+/**
+ * Apply a list of batch entries in order
+ */
+static void RunBusQueue(
+    const std::vector<BatchItem> &items,
+    const std::vector<size_t> &indices,
+    const BrightnessWriter &write,
+    std::vector<BatchResult> &results)
+{
+    for (size_t index : indices)
+    {
+        const BatchItem &item = items[index];
+        BatchResult &result = results[index];
+
+        try
+        {
+            result.success = write ? write(item.monitor, item.value) : item.monitor->SetBrightness(item.value);
+            if (!result.success)
+            {
+                result.error = (item.monitor->IsResponding() ? "Failed to set brightness: " : "Monitor not responding: ") + item.id;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            result.success = false;
+            result.error = std::string("Failed to set brightness: ") + e.what();
+        }
+    }
+}
+
+std::vector<BatchResult> ExecuteBrightnessBatch(const std::vector<BatchItem> &items,
+                                                const BrightnessWriter &write)
+{
+    std::vector<BatchResult> results(items.size());
+
+    // Group entries by bus: internal panels share one queue,
+    // every external monitor gets its own
+    std::vector<size_t> internalQueue;
+    std::map<std::string, std::vector<size_t>> busQueues;
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        results[i].id = items[i].id;
+        results[i].success = false;
+
+        if (!items[i].monitor)
+        {
+            results[i].error = "Monitor not found: " + items[i].id;
+            continue;
+        }
+
+        if (items[i].monitor->GetType() == MonitorType::Internal)
+        {
+            internalQueue.push_back(i);
+        }
+        else
+        {
+            busQueues[items[i].monitor->GetId()].push_back(i);
+        }
+    }
+
+    // Each thread writes only its own result slots
+    std::vector<std::thread> threads;
+    TraceHandoff handoff;
+    threads.reserve(busQueues.size());
+
+    for (const auto &bus : busQueues)
+    {
+        const std::vector<size_t> &indices = bus.second;
+        try
+        {
+            threads.emplace_back([&items, &indices, &write, &results, &handoff]()
+                                 {
+                TraceRequestScope request(handoff, "batch thread start", "queue");
+                RunBusQueue(items, indices, write, results); });
+        }
+        catch (const std::system_error &)
+        {
+            // Could not spawn a thread; program this bus inline instead
+            RunBusQueue(items, indices, write, results);
+        }
+    }
+
+    RunBusQueue(items, internalQueue, write, results);
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    return results;
+}
@@ -0,0 +1,53 @@
+/**
+ * BrightSync - Batched Brightness Writes
+ *
+ * Programs several monitors at once, one thread per physical bus
+ */
+
+#ifndef MONITOR_BATCH_H
+#define MONITOR_BATCH_H
+
+#include "monitor_interface.h"
+#include "write_queue.h"
+#include <vector>
+#include <memory>
+#include <string>
+
+/**
+ * One entry of a brightness batch
+ */
+struct BatchItem
+{
+    std::string id;
+    std::shared_ptr<IMonitor> monitor; // nullptr if the ID was not found
+    int value;
+};
+
+/**
+ * Outcome of one batch entry
+ */
+struct BatchResult
+{
+    std::string id;
+    bool success;
+    std::string error; // empty on success
+};
+
+/**
+ * Write brightness to several monitors concurrently
+ *
+ * Each external monitor sits on its own DDC/CI (I2C) bus and gets its own
+ * thread, so total latency is that of the slowest monitor rather than the
+ * sum. Internal panels share the WMI provider and are written in order on
+ * the calling thread (their writes are queued on the WMI lane anyway, see
+ * HardwareExecutor). Entries for the same monitor are applied in the order
+ * given.
+ *
+ * @param items Monitors and target values
+ * @param write Function used for each write (defaults to IMonitor::SetBrightness)
+ * @return One result per item, in the same order
+ */
+std::vector<BatchResult> ExecuteBrightnessBatch(const std::vector<BatchItem> &items,
+                                                const BrightnessWriter &write = BrightnessWriter());
+
+#endif // MONITOR_BATCH_H
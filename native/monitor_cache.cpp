@@ -0,0 +1,268 @@
+/**
+ * BrightSync - Monitor Cache
+ *
+ * Holds the current monitor topology and rebuilds it only when invalidated
+ */
+
+#include "monitor_cache.h"
+#include <chrono>
+
+// Wait before the rebuild thread retries a failed rebuild
+static const std::chrono::milliseconds REBUILD_RETRY_DELAY(1000);
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+std::shared_ptr<IMonitor> MonitorCache::Snapshot::Find(const std::string &id) const
+{
+    auto it = index.find(id);
+    if (it == index.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+MonitorCache::MonitorCache(Factory factory)
+    : m_factory(factory),
+      m_built(false),
+      m_rebuildRequested(false),
+      m_stopRebuilder(false),
+      m_dirty(true),
+      m_rebuilding(false),
+      m_buildCount(0),
+      m_version(0),
+      m_snapshot(std::make_shared<Snapshot>())
+{
+}
+
+MonitorCache::~MonitorCache()
+{
+    StopRebuilder();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+MonitorCache::SnapshotPtr MonitorCache::GetSnapshot()
+{
+    // A rebuild that is running has already cleared m_dirty
+    if (m_dirty || m_rebuilding)
+    {
+        std::lock_guard<std::mutex> lock(m_rebuildMutex);
+        RefreshLocked();
+    }
+
+    return std::atomic_load(&m_snapshot);
+}
+
+MonitorCache::SnapshotPtr MonitorCache::TryGetSnapshot() const
+{
+    if (m_dirty || m_rebuilding)
+    {
+        return nullptr;
+    }
+
+    SnapshotPtr snapshot = std::atomic_load(&m_snapshot);
+
+    // An invalidation may have arrived while loading; the caller retries later
+    if (m_dirty || m_rebuilding)
+    {
+        return nullptr;
+    }
+
+    return snapshot;
+}
+
+std::vector<std::shared_ptr<IMonitor>> MonitorCache::GetMonitors(unsigned long *version)
+{
+    SnapshotPtr snapshot = GetSnapshot();
+    if (version)
+    {
+        *version = snapshot->version;
+    }
+    return snapshot->monitors;
+}
+
+bool MonitorCache::TryGetMonitors(std::vector<std::shared_ptr<IMonitor>> &monitors, unsigned long *version)
+{
+    SnapshotPtr snapshot = TryGetSnapshot();
+    if (!snapshot)
+    {
+        return false;
+    }
+
+    monitors = snapshot->monitors;
+    if (version)
+    {
+        *version = snapshot->version;
+    }
+    return true;
+}
+
+std::shared_ptr<IMonitor> MonitorCache::Find(const std::string &id)
+{
+    return GetSnapshot()->Find(id);
+}
+
+void MonitorCache::Invalidate()
+{
+    m_dirty = true;
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_rebuildRequested = true;
+    }
+    m_wake.notify_one();
+}
+
+void MonitorCache::StartRebuilder()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+
+    if (m_rebuilder.joinable())
+    {
+        return;
+    }
+
+    m_stopRebuilder = false;
+    m_rebuilder = std::thread(&MonitorCache::RunRebuilder, this);
+}
+
+void MonitorCache::StopRebuilder()
+{
+    std::thread rebuilder;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopRebuilder = true;
+        rebuilder.swap(m_rebuilder);
+    }
+    m_wake.notify_all();
+
+    if (rebuilder.joinable())
+    {
+        rebuilder.join();
+    }
+}
+
+void MonitorCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_rebuildMutex);
+
+    std::shared_ptr<Snapshot> empty = std::make_shared<Snapshot>();
+    empty->version = ++m_version;
+    m_dirty = true;
+    m_built = false;
+    Publish(empty);
+}
+
+unsigned long MonitorCache::GetBuildCount() const
+{
+    return m_buildCount;
+}
+
+unsigned long MonitorCache::GetVersion() const
+{
+    return m_version;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void MonitorCache::RefreshLocked()
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    // Raised before the dirty flag is cleared, so readers always see one of
+    // them until the new list is published. Clearing it before building
+    // makes an invalidation that arrives mid-build trigger another rebuild.
+    m_rebuilding = true;
+    m_dirty = false;
+    try
+    {
+        SnapshotPtr current = std::atomic_load(&m_snapshot);
+        std::shared_ptr<Snapshot> next = std::make_shared<Snapshot>();
+        next->monitors = m_factory(current->monitors);
+        m_buildCount++;
+
+        // Reused monitors keep their identity, so an unchanged topology
+        // keeps its version
+        next->version = next->monitors != current->monitors ? ++m_version : current->version;
+
+        next->index.reserve(next->monitors.size());
+        for (const auto &m : next->monitors)
+        {
+            next->index.emplace(m->GetId(), m);
+        }
+
+        Publish(next);
+        m_built = true;
+        m_rebuilding = false;
+    }
+    catch (...)
+    {
+        // Retry on the next access
+        m_dirty = true;
+        m_rebuilding = false;
+        throw;
+    }
+}
+
+void MonitorCache::Publish(SnapshotPtr snapshot)
+{
+    // The previous snapshot lives on in the readers still holding it
+    std::atomic_store(&m_snapshot, std::move(snapshot));
+}
+
+void MonitorCache::RunRebuilder()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this]()
+                    { return m_stopRebuilder || m_rebuildRequested; });
+        if (m_stopRebuilder)
+        {
+            return;
+        }
+        m_rebuildRequested = false;
+
+        // Rebuild without the wake lock so Invalidate() never waits for it
+        lock.unlock();
+        bool failed = false;
+        try
+        {
+            std::lock_guard<std::mutex> rebuild(m_rebuildMutex);
+
+            // The first build after Clear() is left to the first reader
+            if (m_built)
+            {
+                RefreshLocked();
+            }
+        }
+        catch (...)
+        {
+            // The list stays dirty; the next reader or retry builds it
+            failed = true;
+        }
+        lock.lock();
+
+        if (failed)
+        {
+            m_rebuildRequested = true;
+            m_wake.wait_for(lock, REBUILD_RETRY_DELAY, [this]()
+                            { return m_stopRebuilder; });
+        }
+    }
+}
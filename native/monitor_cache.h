@@ -0,0 +1,194 @@
+/**
+ * BrightSync - Monitor Cache
+ *
+ * Holds the current monitor topology and rebuilds it only when invalidated
+ */
+
+#ifndef MONITOR_CACHE_H
+#define MONITOR_CACHE_H
+
+#include "monitor_interface.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * Event-driven monitor cache
+ *
+ * The monitor list is built on first use and then kept until Invalidate() is
+ * called (display change / device arrival) or Clear() resets it. Rebuilds hand
+ * the previous list to the factory so monitors that still exist are reused
+ * instead of being re-created and re-probed.
+ *
+ * Each build is published as an immutable Snapshot swapped in atomically
+ * (read-copy-update): readers load the current snapshot and keep it, and
+ * the monitors in it, alive for as long as they hold it, so a rebuild never
+ * destroys a monitor that is still in use. Loading the shared_ptr is not
+ * lock-free, though: libstdc++ and MSVC guard std::atomic_load on a
+ * shared_ptr with a short internal lock (a pool of spinlocks or mutexes),
+ * held only while the reference count is taken.
+ *
+ * While the list is current, no reader waits for anything else. After an
+ * invalidation the blocking accessors (GetSnapshot, GetMonitors, Find)
+ * always return the new list: the first of them rebuilds it on its own
+ * thread, and every other one blocks until that rebuild is done. The
+ * Try* accessors never block or enumerate; they return nothing until the
+ * rebuild is done. With StartRebuilder() the rebuild starts on a thread of
+ * the cache as soon as the list is invalidated, so it does not wait for a
+ * blocking reader to come along and Try* callers get the new list after one
+ * enumeration.
+ *
+ * All methods are thread-safe.
+ */
+class MonitorCache
+{
+public:
+    /**
+     * Builds a monitor list; receives the previous list for reuse
+     */
+    typedef std::function<std::vector<std::shared_ptr<IMonitor>>(
+        const std::vector<std::shared_ptr<IMonitor>> &existing)>
+        Factory;
+
+    /**
+     * One published monitor list (never modified after publication)
+     */
+    struct Snapshot
+    {
+        std::vector<std::shared_ptr<IMonitor>> monitors;
+        std::unordered_map<std::string, std::shared_ptr<IMonitor>> index; // by ID
+        unsigned long version = 0;
+
+        /**
+         * Find a monitor by ID (O(1), does not allocate)
+         * @return Monitor instance, or nullptr if not found
+         */
+        std::shared_ptr<IMonitor> Find(const std::string &id) const;
+    };
+
+    typedef std::shared_ptr<const Snapshot> SnapshotPtr;
+
+    /**
+     * Constructor
+     * @param factory Function used to (re)build the monitor list
+     */
+    explicit MonitorCache(Factory factory);
+
+    /**
+     * Destructor - stops the rebuild thread
+     */
+    ~MonitorCache();
+
+    MonitorCache(const MonitorCache &) = delete;
+    MonitorCache &operator=(const MonitorCache &) = delete;
+
+    /**
+     * Get the current snapshot, rebuilding it if invalidated
+     * Blocks for the rebuild if one is needed or running (see the class comment)
+     */
+    SnapshotPtr GetSnapshot();
+
+    /**
+     * Get the current snapshot without ever enumerating or waiting for a rebuild
+     * @return Snapshot, or nullptr if a rebuild is pending or in progress
+     */
+    SnapshotPtr TryGetSnapshot() const;
+
+    /**
+     * Get the current monitor list, rebuilding it if invalidated
+     * @param version Optional; receives the topology version of the list
+     */
+    std::vector<std::shared_ptr<IMonitor>> GetMonitors(unsigned long *version = nullptr);
+
+    /**
+     * Get the current monitor list without ever enumerating
+     * @param monitors Receives the list (its capacity is reused)
+     * @param version Optional; receives the topology version of the list
+     * @return false if a rebuild is pending or in progress
+     */
+    bool TryGetMonitors(std::vector<std::shared_ptr<IMonitor>> &monitors, unsigned long *version = nullptr);
+
+    /**
+     * Find a monitor by ID, rebuilding the list if invalidated
+     * O(1) hash lookup; does not allocate
+     * @return Monitor instance, or nullptr if not found
+     */
+    std::shared_ptr<IMonitor> Find(const std::string &id);
+
+    /**
+     * Mark the topology as changed; the next access rebuilds the list, or
+     * the rebuild thread does right away (see StartRebuilder())
+     * Cheap and safe to call from any thread (e.g. a window procedure)
+     */
+    void Invalidate();
+
+    /**
+     * Start the rebuild thread (no-op if running)
+     * From now on an invalidated list is rebuilt on that thread at once. A
+     * list that was never built, or was cleared, is still built by its
+     * first blocking reader.
+     */
+    void StartRebuilder();
+
+    /**
+     * Stop and join the rebuild thread (waits for a running rebuild)
+     */
+    void StopRebuilder();
+
+    /**
+     * Drop all monitors; the next access builds a fresh list with no reuse
+     */
+    void Clear();
+
+    /**
+     * Number of times the monitor list has been built
+     */
+    unsigned long GetBuildCount() const;
+
+    /**
+     * Topology version
+     * Changes only when a rebuild yields a different set of monitors (or on
+     * Clear()), so callers can keep per-topology data such as descriptors
+     * until it moves
+     */
+    unsigned long GetVersion() const;
+
+private:
+    /**
+     * Rebuild the list if needed and publish it
+     * Caller must hold m_rebuildMutex
+     */
+    void RefreshLocked();
+
+    /**
+     * Publish a snapshot (caller holds m_rebuildMutex)
+     */
+    void Publish(SnapshotPtr snapshot);
+
+    /**
+     * Rebuild thread body: rebuild on every Invalidate() until stopped
+     */
+    void RunRebuilder();
+
+    Factory m_factory;
+    std::mutex m_rebuildMutex; // serializes rebuilds and Clear()
+    bool m_built;              // a list was built since the last Clear() (m_rebuildMutex)
+    std::thread m_rebuilder;
+    std::mutex m_wakeMutex; // guards the two flags below
+    std::condition_variable m_wake;
+    bool m_rebuildRequested;
+    bool m_stopRebuilder;
+    std::atomic<bool> m_dirty;
+    std::atomic<bool> m_rebuilding;
+    std::atomic<unsigned long> m_buildCount;
+    std::atomic<unsigned long> m_version;
+    SnapshotPtr m_snapshot; // accessed only through std::atomic_load / atomic_store
+};
+
+#endif // MONITOR_CACHE_H
@@ -5,9 +5,13 @@
  */
 
 #include "monitor_interface.h"
-#include "real_monitor.h"
+#include "internal_wmi_monitor.h"
+#include "ddc_monitor.h"
 #include "mock_monitor.h"
 #include "monitor_factory.h"
+#include "wmi_session.h"
+#include "hardware_executor.h"
+#include "native_log.h"
 #include <windows.h>
 #include <physicalmonitorenumerationapi.h>
 #include <highlevelmonitorconfigurationapi.h>
@@ -17,7 +21,9 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
-#include <iostream>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
 
 #pragma comment(lib, "Dxva2.lib")
 #pragma comment(lib, "User32.lib")
@@ -26,52 +32,108 @@
 struct MonitorEnumContext
 {
     std::vector<std::shared_ptr<IMonitor>> monitors;
+    const std::vector<std::shared_ptr<IMonitor>> *existing;
+    CapabilityStore *capabilities;
     int internalCount;
     int externalCount;
+
+    // Internal panels from the one WMI query of this enumeration
+    std::vector<WmiPanel> panels;
+    std::vector<bool> panelClaimed;
+    bool wmiAvailable; // false if WMI could not be asked at all
 };
 
 // Forward declarations
 static std::string WideToUtf8(const std::wstring &wstr);
-static std::string GenerateMonitorId(HMONITOR hMonitor, int index);
-static bool IsInternalMonitor(HMONITOR hMonitor);
-static int GetInternalBrightnessForInit();
-static int GetExternalBrightnessForInit(HMONITOR hMonitor);
+static std::wstring GetMonitorDevicePath(const MONITORINFOEX &mi);
+static std::string GenerateMonitorId(const std::wstring &devicePath, HMONITOR hMonitor, int index);
+static int FindWmiPanel(MonitorEnumContext *context, const std::wstring &devicePath);
+static bool IsInternalMonitor(const MONITORINFOEX &mi, bool allowPrimaryFallback);
 static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData);
 
+/**
+ * Find a monitor with the given ID in a previous enumeration
+ */
+static std::shared_ptr<IMonitor> FindExisting(
+    const std::vector<std::shared_ptr<IMonitor>> &existing,
+    const std::string &id)
+{
+    for (const auto &m : existing)
+    {
+        if (m->GetId() == id)
+        {
+            return m;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Reuse an internal panel from a previous enumeration
+ * A monitor bound to another WMI panel is not reused
+ */
+static std::shared_ptr<IMonitor> ReuseInternalMonitor(
+    const MonitorEnumContext *context,
+    const std::string &id,
+    const std::wstring &wmiInstance)
+{
+    std::shared_ptr<InternalWmiMonitor> monitor =
+        std::dynamic_pointer_cast<InternalWmiMonitor>(FindExisting(*context->existing, id));
+
+    if (monitor && monitor->GetWmiInstance() != wmiInstance)
+    {
+        return nullptr;
+    }
+
+    return monitor;
+}
+
+/**
+ * Reuse an external monitor from a previous enumeration, updating its handle
+ */
+static std::shared_ptr<IMonitor> ReuseDdcMonitor(
+    const MonitorEnumContext *context,
+    const std::string &id,
+    HMONITOR hMonitor)
+{
+    std::shared_ptr<DdcMonitor> monitor =
+        std::dynamic_pointer_cast<DdcMonitor>(FindExisting(*context->existing, id));
+
+    if (monitor)
+    {
+        monitor->UpdateMonitorHandle(hMonitor);
+    }
+
+    return monitor;
+}
+
 /**
  * Create mock monitors for testing
  *
- * Creates a simulated monitor setup:
- * - 1 internal laptop display
- * - 2 external monitors
+ * Creates the displays of the topology that are plugged in right now
+ * (by default 1 internal laptop display and 2 external monitors)
  */
-static std::vector<std::shared_ptr<IMonitor>> CreateMockMonitors()
+static std::vector<std::shared_ptr<IMonitor>> CreateMockMonitors(
+    const std::vector<std::shared_ptr<IMonitor>> &existing,
+    const MockTopology &topology)
 {
-    std::cout << "[MOCK MODE] Creating simulated monitors..." << std::endl;
+    BS_LOG_DEBUG("[MOCK MODE] Creating simulated monitors...");
 
     std::vector<std::shared_ptr<IMonitor>> monitors;
 
-    // Create 1 internal monitor
-    monitors.push_back(std::make_shared<MockMonitor>(
-        "mock_internal_0",
-        "Mock Internal Display",
-        "internal",
-        50));
-
-    // Create 2 external monitors
-    monitors.push_back(std::make_shared<MockMonitor>(
-        "mock_external_0",
-        "Mock External Display 1",
-        "external",
-        50));
-
-    monitors.push_back(std::make_shared<MockMonitor>(
-        "mock_external_1",
-        "Mock External Display 2",
-        "external",
-        50));
+    for (const auto &display : topology.GetConnected(topology.GetElapsedMs()))
+    {
+        // Reuse a simulated monitor (and its state) if it already exists
+        std::shared_ptr<IMonitor> monitor = FindExisting(existing, display.id);
+        if (!monitor)
+        {
+            monitor = std::make_shared<MockMonitor>(
+                display.id, display.name, display.type, display.brightness, display.timing, display.maxValue);
+        }
+        monitors.push_back(monitor);
+    }
 
-    std::cout << "[MOCK MODE] Created " << monitors.size() << " mock monitors" << std::endl;
+    BS_LOG_INFO("[MOCK MODE] Created " << monitors.size() << " mock monitors");
 
     return monitors;
 }
@@ -79,20 +141,32 @@ static std::vector<std::shared_ptr<IMonitor>> CreateMockMonitors()
 /**
  * Create real monitors using Windows APIs
  *
- * Enumerates physical monitors and creates RealMonitor instances
+ * Enumerates physical monitors and creates one backend per display:
+ * InternalWmiMonitor for panels, DdcMonitor for external monitors
  */
-static std::vector<std::shared_ptr<IMonitor>> CreateRealMonitors()
+static std::vector<std::shared_ptr<IMonitor>> CreateRealMonitors(
+    const std::vector<std::shared_ptr<IMonitor>> &existing,
+    CapabilityStore *capabilities)
 {
-    std::cout << "Creating real monitors..." << std::endl;
+    BS_LOG_DEBUG("Creating real monitors...");
 
     MonitorEnumContext context;
+    context.existing = &existing;
+    context.capabilities = capabilities;
     context.internalCount = 0;
     context.externalCount = 0;
 
+    // One round trip reads every internal panel and its brightness, in the
+    // WMI session the internal monitors use afterwards
+    context.wmiAvailable = false;
+    HardwareExecutor::Instance().Run(HardwareExecutor::WMI_LANE, [&]()
+                                     { context.wmiAvailable = WmiSession::ForCurrentThread().QueryPanels(context.panels); });
+    context.panelClaimed.assign(context.panels.size(), false);
+
     // Enumerate all monitors
     EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, reinterpret_cast<LPARAM>(&context));
 
-    std::cout << "Found " << context.monitors.size() << " real monitors" << std::endl;
+    BS_LOG_INFO("Found " << context.monitors.size() << " real monitors");
 
     return context.monitors;
 }
@@ -101,17 +175,29 @@ static std::vector<std::shared_ptr<IMonitor>> CreateRealMonitors()
  * Main factory function - creates monitors based on mode
  *
  * @param useMock If true, creates mock monitors; if false, creates real monitors
+ * @param existing Monitors from a previous enumeration, reused when still present
+ * @param capabilities Capability store for new real monitors (may be null)
+ * @param topology Simulated displays for mock mode (null = default setup)
  * @return Vector of monitor instances
  */
-std::vector<std::shared_ptr<IMonitor>> CreateMonitors(bool useMock)
+std::vector<std::shared_ptr<IMonitor>> CreateMonitors(
+    bool useMock,
+    const std::vector<std::shared_ptr<IMonitor>> &existing,
+    CapabilityStore *capabilities,
+    const MockTopology *topology)
 {
     if (useMock)
     {
-        return CreateMockMonitors();
+        if (topology)
+        {
+            return CreateMockMonitors(existing, *topology);
+        }
+        static const MockTopology defaultTopology = MockTopology::Default();
+        return CreateMockMonitors(existing, defaultTopology);
     }
     else
     {
-        return CreateRealMonitors();
+        return CreateRealMonitors(existing, capabilities);
     }
 }
 
@@ -134,31 +220,141 @@ static std::string WideToUtf8(const std::wstring &wstr)
     return strTo;
 }
 
+/**
+ * Get the device interface path of the monitor attached to a display
+ * e.g. \\?\DISPLAY#DEL40F0#5&1a2b3c4&0&UID4352#{e6f07b5f-...}
+ * The path encodes the EDID hardware ID and connector, so it survives replugging
+ */
+static std::wstring GetMonitorDevicePath(const MONITORINFOEX &mi)
+{
+    DISPLAY_DEVICE dd;
+    dd.cb = sizeof(DISPLAY_DEVICE);
+
+    if (EnumDisplayDevices(mi.szDevice, 0, &dd, EDD_GET_DEVICE_INTERFACE_NAME))
+    {
+        return std::wstring(dd.DeviceID);
+    }
+
+    return std::wstring();
+}
+
 /**
  * Generate unique monitor ID
+ *
+ * Derived from the device interface path: monitor_<hardware id>_<path hash>,
+ * e.g. "monitor_del40f0_3f2a9c1e". Falls back to the HMONITOR value (which
+ * changes on replug) only when no device path is available.
  */
-static std::string GenerateMonitorId(HMONITOR hMonitor, int index)
+static std::string GenerateMonitorId(const std::wstring &devicePath, HMONITOR hMonitor, int index)
 {
     std::stringstream ss;
-    ss << "monitor_" << std::hex << std::setfill('0') << std::setw(8)
-       << reinterpret_cast<uintptr_t>(hMonitor) << "_" << std::dec << index;
+
+    if (devicePath.empty())
+    {
+        ss << "monitor_" << std::hex << std::setfill('0') << std::setw(8)
+           << reinterpret_cast<uintptr_t>(hMonitor) << "_" << std::dec << index;
+        return ss.str();
+    }
+
+    std::string path = WideToUtf8(devicePath);
+
+    // Hardware ID is the second '#'-separated segment (EDID vendor + product)
+    std::string hardwareId;
+    size_t first = path.find('#');
+    if (first != std::string::npos)
+    {
+        size_t second = path.find('#', first + 1);
+        std::string segment = path.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1);
+        for (char c : segment)
+        {
+            if (std::isalnum(static_cast<unsigned char>(c)))
+            {
+                hardwareId += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+
+    // FNV-1a over the case-folded path distinguishes identical models
+    uint32_t hash = 2166136261u;
+    for (char c : path)
+    {
+        hash ^= static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(c)));
+        hash *= 16777619u;
+    }
+
+    ss << "monitor_" << (hardwareId.empty() ? "unknown" : hardwareId) << "_"
+       << std::hex << std::setfill('0') << std::setw(8) << hash;
     return ss.str();
 }
 
 /**
- * Check if monitor is internal (laptop display)
+ * Find the WMI panel driving a display and mark it as taken
+ *
+ * WMI names panels by PnP instance ID plus an index, e.g.
+ * DISPLAY\BOE0812\4&2d4b2c3&0&UID8388688_0; the device interface path of
+ * the same display is \\?\DISPLAY#BOE0812#4&2d4b2c3&0&UID8388688#{guid}
+ * @return Index into context->panels, or -1 if no panel matches
  */
-static bool IsInternalMonitor(HMONITOR hMonitor)
+static int FindWmiPanel(MonitorEnumContext *context, const std::wstring &devicePath)
 {
-    MONITORINFOEX mi;
-    mi.cbSize = sizeof(MONITORINFOEX);
+    if (devicePath.empty())
+    {
+        return -1;
+    }
 
-    if (!GetMonitorInfo(hMonitor, &mi))
+    std::wstring instanceId = devicePath;
+    if (instanceId.compare(0, 4, L"\\\\?\\") == 0)
+    {
+        instanceId.erase(0, 4);
+    }
+    size_t guid = instanceId.rfind(L"#{");
+    if (guid != std::wstring::npos)
     {
-        return false;
+        instanceId.erase(guid);
     }
+    std::replace(instanceId.begin(), instanceId.end(), L'#', L'\\');
 
-    // Check if this is the primary monitor and might be internal
+    for (size_t i = 0; i < context->panels.size(); i++)
+    {
+        const std::wstring &name = context->panels[i].instanceName;
+        if (!context->panelClaimed[i] &&
+            name.size() >= instanceId.size() &&
+            _wcsnicmp(name.c_str(), instanceId.c_str(), instanceId.size()) == 0 &&
+            (name.size() == instanceId.size() || name[instanceId.size()] == L'_'))
+        {
+            context->panelClaimed[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Take the first WMI panel no display has matched by path
+ * @return Index into context->panels, or -1 if all are taken
+ */
+static int ClaimUnmatchedWmiPanel(MonitorEnumContext *context)
+{
+    for (size_t i = 0; i < context->panels.size(); i++)
+    {
+        if (!context->panelClaimed[i])
+        {
+            context->panelClaimed[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Check if monitor looks like an internal (laptop) display
+ * @param allowPrimaryFallback Treat the primary monitor as internal; only
+ *                             used when WMI could not list the panels, since
+ *                             on a docked laptop the primary is external
+ */
+static bool IsInternalMonitor(const MONITORINFOEX &mi, bool allowPrimaryFallback)
+{
     DISPLAY_DEVICE dd;
     dd.cb = sizeof(DISPLAY_DEVICE);
 
@@ -177,28 +373,7 @@ static bool IsInternalMonitor(HMONITOR hMonitor)
     }
 
     // Fallback: assume primary monitor on laptop is internal
-    return (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
-}
-
-/**
- * Get internal brightness for initialization
- */
-static int GetInternalBrightnessForInit()
-{
-    // Create a temporary real monitor to get the brightness
-    // This is a simplified approach - in production you might want to cache this
-    RealMonitor tempMonitor("temp", "temp", "internal", NULL, true, false);
-    return tempMonitor.GetBrightness();
-}
-
-/**
- * Get external brightness for initialization
- */
-static int GetExternalBrightnessForInit(HMONITOR hMonitor)
-{
-    // Create a temporary real monitor to get the brightness
-    RealMonitor tempMonitor("temp", "temp", "external", hMonitor, false, true);
-    return tempMonitor.GetBrightness();
+    return allowPrimaryFallback && (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
 }
 
 /**
@@ -217,28 +392,38 @@ static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT l
         return TRUE; // Continue enumeration
     }
 
-    // Determine if internal or external
-    bool isInternal = IsInternalMonitor(hMonitor);
+    std::wstring devicePath = GetMonitorDevicePath(mi);
+
+    // Internal if WMI lists a panel for it; displays that merely look
+    // internal take a panel whose path did not match (unusual drivers)
+    int panel = FindWmiPanel(context, devicePath);
+    bool isInternal = panel >= 0;
+    if (!isInternal && IsInternalMonitor(mi, !context->wmiAvailable))
+    {
+        panel = ClaimUnmatchedWmiPanel(context);
+        isInternal = panel >= 0 || !context->wmiAvailable;
+    }
 
     if (isInternal)
     {
-        // Internal monitor
-        std::string id = "internal_0";
-        std::string name = "Internal Display";
-        std::string type = "internal";
-
-        // Get current brightness
-        int currentBrightness = GetInternalBrightnessForInit();
-
-        // Create RealMonitor instance
-        auto monitor = std::make_shared<RealMonitor>(
-            id,
-            name,
-            type,
-            hMonitor,
-            true, // supportsWMI
-            false // supportsDDC
-        );
+        // Internal monitor, numbered by its WMI panel so IDs stay unique
+        int index = panel >= 0 ? panel : context->internalCount;
+        std::string id = "internal_" + std::to_string(index);
+        std::string name = index == 0 ? "Internal Display" : "Internal Display " + std::to_string(index + 1);
+        std::wstring wmiInstance = panel >= 0 ? context->panels[panel].instanceName : std::wstring();
+        int brightness = panel >= 0 ? context->panels[panel].brightness : -1;
+
+        // Keep the existing monitor if it is still present
+        std::shared_ptr<IMonitor> reused = ReuseInternalMonitor(context, id, wmiInstance);
+        if (reused)
+        {
+            context->monitors.push_back(reused);
+            context->internalCount++;
+            return TRUE;
+        }
+
+        // Probed later, off the enumeration
+        auto monitor = std::make_shared<InternalWmiMonitor>(id, name, wmiInstance, brightness);
 
         context->monitors.push_back(monitor);
         context->internalCount++;
@@ -246,7 +431,17 @@ static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT l
     else
     {
         // External monitor
-        std::string id = GenerateMonitorId(hMonitor, context->externalCount);
+        std::string id = GenerateMonitorId(devicePath, hMonitor, context->externalCount);
+
+        // Keep the existing monitor if it is still present (skips the DDC probe)
+        std::shared_ptr<IMonitor> reused = ReuseDdcMonitor(context, id, hMonitor);
+        if (reused)
+        {
+            context->monitors.push_back(reused);
+            context->externalCount++;
+            return TRUE;
+        }
+
         std::string name;
 
         // Get monitor name from device
@@ -262,24 +457,17 @@ static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT l
             name = "External Display " + std::to_string(context->externalCount + 1);
         }
 
-        // Test DDC/CI support
-        bool supportsDDC = false;
-        int currentBrightness = GetExternalBrightnessForInit(hMonitor);
-        if (currentBrightness >= 0)
+        // DDC/CI support is confirmed by Probe(), which runs after
+        // enumeration so a silent monitor cannot stall it
+        auto monitor = std::make_shared<DdcMonitor>(id, name, hMonitor);
+
+        // Remembered capabilities are only valid for IDs that survive a
+        // restart, i.e. those derived from the device path
+        if (!devicePath.empty())
         {
-            supportsDDC = true;
+            monitor->AttachCapabilityStore(context->capabilities);
         }
 
-        // Create RealMonitor instance
-        auto monitor = std::make_shared<RealMonitor>(
-            id,
-            name,
-            "external",
-            hMonitor,
-            false,      // supportsWMI
-            supportsDDC // supportsDDC
-        );
-
         context->monitors.push_back(monitor);
         context->externalCount++;
     }
@@ -8,6 +8,8 @@
 #define MONITOR_FACTORY_H
 
 #include "monitor_interface.h"
+#include "capability_store.h"
+#include "mock_topology.h"
 #include <vector>
 #include <memory>
 
@@ -16,8 +18,23 @@
  *
  * @param useMock If true, creates mock monitors for testing;
  *                if false, creates real monitors using Windows APIs
+ * @param existing Monitors from a previous enumeration; any that are still
+ *                 present (same ID) are reused instead of re-created
+ * @param capabilities Store of DDC/CI capabilities from earlier sessions,
+ *                     attached to new real monitors (may be null)
+ * @param topology Simulated displays for mock mode; the ones connected at
+ *                 the current time are created (null = MockTopology::Default())
+ *
+ * Enumeration does not touch DDC/CI or WMI: new monitors are returned
+ * unprobed (IsProbed() == false) and should be probed afterwards, e.g. with
+ * MonitorProber, so all displays are probed at once.
+ *
  * @return Vector of monitor instances (IMonitor shared pointers)
  */
-std::vector<std::shared_ptr<IMonitor>> CreateMonitors(bool useMock);
+std::vector<std::shared_ptr<IMonitor>> CreateMonitors(
+    bool useMock,
+    const std::vector<std::shared_ptr<IMonitor>> &existing = std::vector<std::shared_ptr<IMonitor>>(),
+    CapabilityStore *capabilities = nullptr,
+    const MockTopology *topology = nullptr);
 
 #endif // MONITOR_FACTORY_H
@@ -11,6 +11,44 @@
 #include <string>
 #include <memory>
 
+/**
+ * Kind of display; decides the backend (WMI or DDC/CI) of a real monitor
+ */
+enum class MonitorType
+{
+    Internal, // laptop panel
+    External
+};
+
+/**
+ * Name of a monitor type as used by the JS API
+ * @return "internal" or "external" (static storage)
+ */
+inline const char *MonitorTypeName(MonitorType type)
+{
+    return type == MonitorType::Internal ? "internal" : "external";
+}
+
+/**
+ * Parse a JS monitor type; anything but "internal" is external
+ */
+inline MonitorType ParseMonitorType(const std::string &name)
+{
+    return name == "internal" ? MonitorType::Internal : MonitorType::External;
+}
+
+/**
+ * Immutable identity of a monitor, fixed when the monitor is created
+ */
+struct MonitorDescriptor
+{
+    std::string id;   // stable across reconnects
+    std::string name; // human-readable
+    MonitorType type;
+    int minBrightness;
+    int maxBrightness;
+};
+
 /**
  * Monitor Hardware Abstraction Interface
  *
@@ -19,33 +57,39 @@
 class IMonitor
 {
 public:
+    /**
+     * Get the identity of the monitor
+     * Never changes; returned by reference so reading it does not allocate
+     */
+    virtual const MonitorDescriptor &GetDescriptor() const = 0;
+
     /**
      * Get unique monitor identifier
+     * Stable across reconnects; returned by reference so lookups don't allocate
      */
-    virtual std::string GetId() const = 0;
+    const std::string &GetId() const { return GetDescriptor().id; }
 
     /**
      * Get human-readable monitor name
      */
-    virtual std::string GetName() const = 0;
+    const std::string &GetName() const { return GetDescriptor().name; }
 
     /**
-     * Get monitor type
-     * @return "internal" for laptop displays, "external" for external monitors
+     * Get monitor type (see MonitorTypeName() for the string form)
      */
-    virtual std::string GetType() const = 0;
+    MonitorType GetType() const { return GetDescriptor().type; }
 
     /**
      * Get minimum brightness value
      * @return Minimum brightness (typically 0)
      */
-    virtual int GetMinBrightness() const = 0;
+    int GetMinBrightness() const { return GetDescriptor().minBrightness; }
 
     /**
      * Get maximum brightness value
      * @return Maximum brightness (typically 100)
      */
-    virtual int GetMaxBrightness() const = 0;
+    int GetMaxBrightness() const { return GetDescriptor().maxBrightness; }
 
     /**
      * Get current brightness value
@@ -53,6 +97,13 @@ public:
      */
     virtual int GetBrightness() const = 0;
 
+    /**
+     * Get the last brightness value read from or written to the hardware
+     * Never touches the hardware
+     * @return Last known brightness level, or -1 if unknown
+     */
+    virtual int GetLastKnownBrightness() const = 0;
+
     /**
      * Set brightness value
      * @param value Brightness level (will be clamped to min/max range)
@@ -60,12 +111,61 @@ public:
      */
     virtual bool SetBrightness(int value) = 0;
 
+    /**
+     * Granularity of fades the hardware runs by itself
+     * @return Milliseconds, or 0 if the hardware cannot fade
+     */
+    virtual int GetHardwareRampResolutionMs() const = 0;
+
+    /**
+     * Set brightness with one command and let the hardware fade to it
+     * Monitors without hardware fades set the value directly
+     * @param value Brightness level (will be clamped to min/max range)
+     * @param durationMs Fade time, rounded to the ramp resolution
+     * @return true on success, false on failure
+     */
+    virtual bool SetBrightnessRamped(int value, int durationMs) = 0;
+
     /**
      * Check if monitor supports brightness control
      * @return true if monitor can be controlled, false otherwise
      */
     virtual bool IsControllable() const = 0;
 
+    /**
+     * Check whether the monitor answers
+     * @return false while its circuit breaker is open; reads and writes then
+     *         fail fast without touching the hardware
+     */
+    virtual bool IsResponding() const = 0;
+
+    /**
+     * Try the hardware once if the monitor stopped answering and its backoff
+     * has passed; a success puts it back into service
+     * Called by the health watcher, so callers never wait on a dead monitor
+     * @return true if the monitor is responding afterwards
+     */
+    virtual bool CheckHealth() = 0;
+
+    /**
+     * Detect capabilities and read the initial brightness
+     * Called once after creation, possibly on a background thread; further
+     * calls wait for the first one and return its result
+     * @return true if the monitor can be controlled
+     */
+    virtual bool Probe() = 0;
+
+    /**
+     * Check whether Probe() has completed
+     */
+    virtual bool IsProbed() const = 0;
+
+    /**
+     * Join the hardware thread kept for this monitor alone, once the
+     * topology has dropped it; a later call starts it again
+     */
+    virtual void Retire() = 0;
+
     /**
      * Virtual destructor for proper cleanup
      */
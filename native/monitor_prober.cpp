@@ -0,0 +1,99 @@
+/**
+ * BrightSync - Monitor Prober Implementation
+ */
+
+#include "monitor_prober.h"
+#include <exception>
+#include <system_error>
+
+/**
+ * Probe one monitor and report it, never letting an exception escape
+ */
+static void RunProbe(const std::shared_ptr<IMonitor> &monitor, const MonitorProber::ProbeCallback &onProbed)
+{
+    try
+    {
+        monitor->Probe();
+    }
+    catch (const std::exception &)
+    {
+        // Treated like a monitor that did not answer
+    }
+
+    if (onProbed)
+    {
+        onProbed(monitor);
+    }
+}
+
+MonitorProber::~MonitorProber()
+{
+    Wait();
+}
+
+void MonitorProber::ProbeAsync(const std::vector<std::shared_ptr<IMonitor>> &monitors, ProbeCallback onProbed)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReapLocked();
+
+    for (const auto &monitor : monitors)
+    {
+        if (monitor->IsProbed())
+        {
+            continue;
+        }
+
+        Worker worker;
+        worker.done = std::make_shared<std::atomic<bool>>(false);
+        std::shared_ptr<std::atomic<bool>> done = worker.done;
+
+        try
+        {
+            worker.thread = std::thread([monitor, onProbed, done]()
+                                        {
+                RunProbe(monitor, onProbed);
+                *done = true; });
+        }
+        catch (const std::system_error &)
+        {
+            // Could not spawn a thread; probe inline instead
+            RunProbe(monitor, onProbed);
+            continue;
+        }
+
+        m_workers.push_back(std::move(worker));
+    }
+}
+
+void MonitorProber::Wait()
+{
+    std::vector<Worker> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        workers.swap(m_workers);
+    }
+
+    for (auto &worker : workers)
+    {
+        if (worker.thread.joinable())
+        {
+            worker.thread.join();
+        }
+    }
+}
+
+void MonitorProber::ReapLocked()
+{
+    for (auto it = m_workers.begin(); it != m_workers.end();)
+    {
+        if (*it->done)
+        {
+            it->thread.join();
+            it = m_workers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
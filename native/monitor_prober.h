@@ -0,0 +1,69 @@
+/**
+ * BrightSync - Monitor Prober
+ *
+ * Probes newly found monitors concurrently in the background
+ */
+
+#ifndef MONITOR_PROBER_H
+#define MONITOR_PROBER_H
+
+#include "monitor_interface.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+/**
+ * Background capability probing
+ *
+ * Each monitor is probed on its own thread, so a display that never answers
+ * DDC/CI only delays itself: the others report their brightness as soon as
+ * their own probe finishes. Enumeration can therefore return immediately
+ * and the UI shows monitors before any hardware transaction completed.
+ *
+ * All methods are thread-safe.
+ */
+class MonitorProber
+{
+public:
+    /**
+     * Invoked on the probe thread once a monitor has been probed
+     */
+    typedef std::function<void(const std::shared_ptr<IMonitor> &monitor)> ProbeCallback;
+
+    /**
+     * Destructor - waits for running probes
+     */
+    ~MonitorProber();
+
+    /**
+     * Start probing monitors that have not been probed yet
+     * @param monitors Monitors to probe (already probed ones are skipped)
+     * @param onProbed Called after each probe finishes
+     */
+    void ProbeAsync(const std::vector<std::shared_ptr<IMonitor>> &monitors, ProbeCallback onProbed);
+
+    /**
+     * Block until all started probes have finished
+     */
+    void Wait();
+
+private:
+    struct Worker
+    {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+
+    /**
+     * Join workers whose probe has finished (caller holds m_mutex)
+     */
+    void ReapLocked();
+
+    std::mutex m_mutex;
+    std::vector<Worker> m_workers;
+};
+
+#endif // MONITOR_PROBER_H
@@ -0,0 +1,240 @@
+/**
+ * BrightSync - Monitor Statistics Implementation
+ */
+
+#include "monitor_stats.h"
+
+// Bucket upper bounds in microseconds (the last bucket is open-ended)
+static const uint64_t BUCKET_UPPER_US[LatencyHistogram::BUCKETS - 1] = {
+    100, 200, 500,
+    1000, 2000, 5000,
+    10000, 20000, 50000,
+    100000, 200000, 500000,
+    1000000, 2000000, 5000000};
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+LatencyHistogram::LatencyHistogram()
+    : m_count(0),
+      m_totalUs(0),
+      m_maxUs(0)
+{
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::Record(std::chrono::steady_clock::duration elapsed)
+{
+    long long signedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    uint64_t us = signedUs > 0 ? static_cast<uint64_t>(signedUs) : 0;
+
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && us >= BUCKET_UPPER_US[bucket])
+    {
+        bucket++;
+    }
+
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+
+    uint64_t max = m_maxUs.load(std::memory_order_relaxed);
+    while (us > max && !m_maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Read() const
+{
+    Snapshot snapshot;
+    snapshot.count = m_count.load(std::memory_order_relaxed);
+    snapshot.totalMs = m_totalUs.load(std::memory_order_relaxed) / 1000.0;
+    snapshot.maxMs = m_maxUs.load(std::memory_order_relaxed) / 1000.0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void LatencyHistogram::Reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    m_totalUs.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+double LatencyHistogram::BucketUpperMs(int bucket)
+{
+    if (bucket < 0 || bucket >= BUCKETS - 1)
+    {
+        return -1;
+    }
+    return BUCKET_UPPER_US[bucket] / 1000.0;
+}
+
+double LatencyHistogram::Snapshot::MeanMs() const
+{
+    return count > 0 ? totalMs / count : 0;
+}
+
+double LatencyHistogram::Snapshot::PercentileMs(double percentile) const
+{
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        total += buckets[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    double rank = total * percentile / 100.0;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS - 1; i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0)
+        {
+            double upper = BucketUpperMs(i);
+            return upper < maxMs ? upper : maxMs;
+        }
+    }
+    return maxMs;
+}
+
+// ============================================================================
+// MonitorCounters
+// ============================================================================
+
+void MonitorCounters::RecordRead(std::chrono::steady_clock::duration elapsed, bool success)
+{
+    reads.fetch_add(1, std::memory_order_relaxed);
+    if (!success)
+    {
+        readFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+    readLatency.Record(elapsed);
+}
+
+void MonitorCounters::RecordWrite(std::chrono::steady_clock::duration elapsed, bool success)
+{
+    writes.fetch_add(1, std::memory_order_relaxed);
+    if (!success)
+    {
+        writeFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+    writeLatency.Record(elapsed);
+}
+
+void MonitorCounters::Reset()
+{
+    reads = 0;
+    readFailures = 0;
+    writes = 0;
+    writeFailures = 0;
+    retries = 0;
+    readLatency.Reset();
+    writeLatency.Reset();
+}
+
+// ============================================================================
+// MonitorStats
+// ============================================================================
+
+MonitorStats::MonitorStats()
+    : m_cacheHits(0),
+      m_cacheMisses(0),
+      m_writesCoalesced(0)
+{
+}
+
+MonitorStats &MonitorStats::Instance()
+{
+    // Leaked on purpose: monitors may record during static destruction
+    static MonitorStats *stats = new MonitorStats();
+    return *stats;
+}
+
+MonitorCounters &MonitorStats::ForMonitor(const std::string &id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unique_ptr<MonitorCounters> &counters = m_monitors[id];
+    if (!counters)
+    {
+        counters.reset(new MonitorCounters());
+    }
+    return *counters;
+}
+
+void MonitorStats::RecordEnumeration(std::chrono::steady_clock::duration elapsed)
+{
+    m_enumeration.Record(elapsed);
+}
+
+void MonitorStats::RecordCacheHit()
+{
+    m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MonitorStats::RecordCacheMiss()
+{
+    m_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MonitorStats::RecordWriteCoalesced()
+{
+    m_writesCoalesced.fetch_add(1, std::memory_order_relaxed);
+}
+
+StatsSnapshot MonitorStats::Read() const
+{
+    StatsSnapshot snapshot;
+    snapshot.enumeration = m_enumeration.Read();
+    snapshot.cacheHits = m_cacheHits.load(std::memory_order_relaxed);
+    snapshot.cacheMisses = m_cacheMisses.load(std::memory_order_relaxed);
+    snapshot.writesCoalesced = m_writesCoalesced.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : m_monitors)
+    {
+        const MonitorCounters &counters = *entry.second;
+
+        StatsSnapshot::Monitor monitor;
+        monitor.id = entry.first;
+        monitor.reads = counters.reads.load(std::memory_order_relaxed);
+        monitor.readFailures = counters.readFailures.load(std::memory_order_relaxed);
+        monitor.writes = counters.writes.load(std::memory_order_relaxed);
+        monitor.writeFailures = counters.writeFailures.load(std::memory_order_relaxed);
+        monitor.retries = counters.retries.load(std::memory_order_relaxed);
+        monitor.readLatency = counters.readLatency.Read();
+        monitor.writeLatency = counters.writeLatency.Read();
+        snapshot.monitors.push_back(monitor);
+    }
+
+    return snapshot;
+}
+
+void MonitorStats::Reset()
+{
+    m_enumeration.Reset();
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+    m_writesCoalesced = 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &entry : m_monitors)
+    {
+        entry.second->Reset();
+    }
+}
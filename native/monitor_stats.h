@@ -0,0 +1,177 @@
+/**
+ * BrightSync - Monitor Statistics
+ *
+ * Lock-free counters and latency histograms for native operations
+ */
+
+#ifndef MONITOR_STATS_H
+#define MONITOR_STATS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Latency distribution with fixed 1-2-5 buckets (0.1 ms to 5 s, plus overflow)
+ */
+class LatencyHistogram
+{
+public:
+    static const int BUCKETS = 16;
+
+    /**
+     * Plain copy of a histogram
+     */
+    struct Snapshot
+    {
+        uint64_t count = 0;
+        double totalMs = 0;
+        double maxMs = 0;
+        uint64_t buckets[BUCKETS] = {};
+
+        double MeanMs() const;
+
+        /**
+         * Upper bound of the bucket holding the given percentile
+         * @param percentile 0-100
+         * @return Milliseconds (the maximum for the overflow bucket), 0 if empty
+         */
+        double PercentileMs(double percentile) const;
+    };
+
+    LatencyHistogram();
+
+    /**
+     * Record one sample
+     */
+    void Record(std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * Read all buckets (not atomic as a whole; fine for monitoring)
+     */
+    Snapshot Read() const;
+
+    /**
+     * Set everything back to zero
+     */
+    void Reset();
+
+    /**
+     * Upper bound of a bucket in milliseconds (the last one has none)
+     */
+    static double BucketUpperMs(int bucket);
+
+private:
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_totalUs;
+    std::atomic<uint64_t> m_maxUs;
+    std::atomic<uint64_t> m_buckets[BUCKETS];
+};
+
+/**
+ * Hardware counters of one monitor
+ */
+struct MonitorCounters
+{
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> readFailures{0};
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> writeFailures{0};
+    std::atomic<uint64_t> retries{0}; // transactions repeated after re-acquiring handles
+    LatencyHistogram readLatency;
+    LatencyHistogram writeLatency;
+
+    /**
+     * Record one read or write and its latency
+     */
+    void RecordRead(std::chrono::steady_clock::duration elapsed, bool success);
+    void RecordWrite(std::chrono::steady_clock::duration elapsed, bool success);
+
+    void Reset();
+};
+
+/**
+ * Plain copy of all statistics
+ */
+struct StatsSnapshot
+{
+    struct Monitor
+    {
+        std::string id;
+        uint64_t reads;
+        uint64_t readFailures;
+        uint64_t writes;
+        uint64_t writeFailures;
+        uint64_t retries;
+        LatencyHistogram::Snapshot readLatency;
+        LatencyHistogram::Snapshot writeLatency;
+    };
+
+    std::vector<Monitor> monitors;
+    LatencyHistogram::Snapshot enumeration;
+    uint64_t cacheHits;
+    uint64_t cacheMisses;
+    uint64_t writesCoalesced;
+};
+
+/**
+ * Process-wide statistics registry
+ *
+ * Recording is a handful of relaxed atomic increments; only looking up a
+ * monitor's counters for the first time takes a lock. Counters are kept by
+ * monitor ID, so they survive a monitor being re-created after a display
+ * change. All methods are thread-safe.
+ */
+class MonitorStats
+{
+public:
+    static MonitorStats &Instance();
+
+    /**
+     * Counters of a monitor (created on first use; the reference stays valid)
+     */
+    MonitorCounters &ForMonitor(const std::string &id);
+
+    /**
+     * Record one monitor enumeration
+     */
+    void RecordEnumeration(std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * Record a brightness read answered from / missing the cache
+     */
+    void RecordCacheHit();
+    void RecordCacheMiss();
+
+    /**
+     * Record a write replaced by a newer value before it was sent
+     */
+    void RecordWriteCoalesced();
+
+    /**
+     * Copy everything
+     */
+    StatsSnapshot Read() const;
+
+    /**
+     * Set all counters back to zero
+     */
+    void Reset();
+
+private:
+    MonitorStats();
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<MonitorCounters>> m_monitors;
+    LatencyHistogram m_enumeration;
+    std::atomic<uint64_t> m_cacheHits;
+    std::atomic<uint64_t> m_cacheMisses;
+    std::atomic<uint64_t> m_writesCoalesced;
+};
+
+#endif // MONITOR_STATS_H
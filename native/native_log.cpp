@@ -0,0 +1,375 @@
+/**
+ * BrightSync - Native Logging Implementation
+ */
+
+#include "native_log.h"
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <system_error>
+
+std::atomic<int> g_nativeLogLevel(static_cast<int>(LogLevel::Info));
+
+// ============================================================================
+// Lock-free Ring
+// ============================================================================
+
+/**
+ * Bounded multi-producer ring with a single consumer (the log thread)
+ * Each slot carries a sequence number telling whose turn it is
+ */
+class LogRing
+{
+public:
+    LogRing() : m_enqueuePos(0), m_dequeuePos(0)
+    {
+        for (size_t i = 0; i < NativeLog::CAPACITY; i++)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Claim a slot and publish an entry
+     * @return false if the ring is full
+     */
+    bool Push(LogEntry &entry)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        for (;;)
+        {
+            slot = &m_slots[pos % NativeLog::CAPACITY];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->entry = std::move(entry);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Take the oldest published entry (consumer only)
+     * @return false if nothing is published
+     */
+    bool Pop(LogEntry &entry)
+    {
+        Slot *slot = &m_slots[m_dequeuePos % NativeLog::CAPACITY];
+        if (slot->sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        {
+            return false;
+        }
+
+        entry = std::move(slot->entry);
+        slot->sequence.store(m_dequeuePos + NativeLog::CAPACITY, std::memory_order_release);
+        m_dequeuePos++;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        LogEntry entry;
+    };
+
+    Slot m_slots[NativeLog::CAPACITY];
+    std::atomic<size_t> m_enqueuePos;
+    size_t m_dequeuePos;
+};
+
+// ============================================================================
+// Logger State
+// ============================================================================
+
+enum LogThreadState
+{
+    LOG_THREAD_IDLE = 0,
+    LOG_THREAD_RUNNING = 1,
+    LOG_THREAD_STOPPED = 2
+};
+
+struct LogState
+{
+    LogRing ring;
+    std::atomic<int> threadState{LOG_THREAD_IDLE};
+    std::atomic<bool> wakePending{false};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<int> flushWaiters{0};
+
+    // Guards the consumer side: draining, the sink and delivery counters
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable delivered;
+    uint64_t deliveredCount = 0;
+    bool stopRequested = false;
+    LogSink sink;
+    std::thread thread;
+};
+
+/**
+ * Leaked on purpose: messages may be logged during static destruction
+ */
+static LogState &State()
+{
+    static LogState *state = new LogState();
+    return *state;
+}
+
+/**
+ * Default sink: one stdout flush per batch
+ */
+static void WriteToStdout(const std::vector<LogEntry> &entries)
+{
+    for (const auto &entry : entries)
+    {
+        std::cout << entry.message << '\n';
+    }
+    std::cout.flush();
+}
+
+/**
+ * Hand all published entries to the sink (caller holds state.mutex)
+ */
+static void DrainLocked(LogState &state)
+{
+    std::vector<LogEntry> batch;
+    LogEntry entry;
+    while (state.ring.Pop(entry))
+    {
+        batch.push_back(std::move(entry));
+    }
+
+    if (batch.empty())
+    {
+        return;
+    }
+
+    if (state.sink)
+    {
+        state.sink(batch);
+    }
+    else
+    {
+        WriteToStdout(batch);
+    }
+
+    state.deliveredCount += batch.size();
+    state.delivered.notify_all();
+}
+
+static void RunLogThread()
+{
+    LogState &state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+
+    while (!state.stopRequested)
+    {
+        state.wakePending = false;
+        DrainLocked(state);
+
+        if (state.flushWaiters > 0)
+        {
+            // A producer may still be publishing a claimed slot
+            state.wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        else
+        {
+            // Producers notify without the lock, so a wakeup can be missed;
+            // the timeout bounds how long a message waits in that case
+            state.wake.wait_for(lock, std::chrono::milliseconds(100), [&state]()
+                                { return state.stopRequested || state.wakePending.load(); });
+        }
+    }
+
+    DrainLocked(state);
+}
+
+/**
+ * Start the log thread on first use
+ * @return false once the logger has been shut down
+ */
+static bool EnsureStarted(LogState &state)
+{
+    int current = state.threadState.load(std::memory_order_acquire);
+    if (current == LOG_THREAD_RUNNING)
+    {
+        return true;
+    }
+    if (current == LOG_THREAD_STOPPED)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.threadState == LOG_THREAD_IDLE)
+    {
+        try
+        {
+            state.thread = std::thread(RunLogThread);
+            state.threadState = LOG_THREAD_RUNNING;
+        }
+        catch (const std::system_error &)
+        {
+            state.threadState = LOG_THREAD_STOPPED;
+        }
+    }
+    return state.threadState == LOG_THREAD_RUNNING;
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void NativeLog::SetLevel(LogLevel level)
+{
+    g_nativeLogLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel NativeLog::GetLevel()
+{
+    return static_cast<LogLevel>(g_nativeLogLevel.load(std::memory_order_relaxed));
+}
+
+bool NativeLog::ParseLevel(const std::string &name, LogLevel &level)
+{
+    for (int i = static_cast<int>(LogLevel::Trace); i <= static_cast<int>(LogLevel::Off); i++)
+    {
+        if (name == LevelName(static_cast<LogLevel>(i)))
+        {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *NativeLog::LevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace:
+        return "trace";
+    case LogLevel::Debug:
+        return "debug";
+    case LogLevel::Info:
+        return "info";
+    case LogLevel::Warn:
+        return "warn";
+    case LogLevel::Error:
+        return "error";
+    default:
+        return "off";
+    }
+}
+
+void NativeLog::Write(LogLevel level, std::string message)
+{
+    LogState &state = State();
+
+    LogEntry entry;
+    entry.level = level;
+    entry.time = std::chrono::system_clock::now();
+    entry.message = std::move(message);
+
+    if (!EnsureStarted(state))
+    {
+        // No log thread (shut down): deliver in the caller
+        std::lock_guard<std::mutex> lock(state.mutex);
+        std::vector<LogEntry> batch(1, std::move(entry));
+        if (state.sink)
+            state.sink(batch);
+        else
+            WriteToStdout(batch);
+        return;
+    }
+
+    if (!state.ring.Push(entry))
+    {
+        state.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    state.accepted.fetch_add(1, std::memory_order_release);
+
+    // Only the first message after a drain wakes the log thread
+    if (!state.wakePending.exchange(true))
+    {
+        state.wake.notify_one();
+    }
+}
+
+void NativeLog::SetSink(LogSink sink)
+{
+    LogState &state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.sink = std::move(sink);
+}
+
+void NativeLog::Flush()
+{
+    LogState &state = State();
+    uint64_t target = state.accepted.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (state.threadState != LOG_THREAD_RUNNING || state.stopRequested)
+    {
+        DrainLocked(state);
+        return;
+    }
+
+    state.flushWaiters++;
+    state.wakePending = true;
+    state.wake.notify_one();
+    state.delivered.wait(lock, [&state, target]()
+                         { return state.deliveredCount >= target || state.stopRequested; });
+    state.flushWaiters--;
+}
+
+void NativeLog::Shutdown()
+{
+    LogState &state = State();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.threadState != LOG_THREAD_RUNNING)
+        {
+            state.threadState = LOG_THREAD_STOPPED;
+            DrainLocked(state);
+            return;
+        }
+        state.stopRequested = true;
+        state.threadState = LOG_THREAD_STOPPED;
+    }
+
+    state.wake.notify_one();
+    state.delivered.notify_all();
+    if (state.thread.joinable())
+    {
+        state.thread.join();
+    }
+}
+
+uint64_t NativeLog::GetDroppedCount()
+{
+    return State().dropped.load(std::memory_order_relaxed);
+}
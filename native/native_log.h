@@ -0,0 +1,147 @@
+/**
+ * BrightSync - Native Logging
+ *
+ * Leveled logging with lazy formatting and an asynchronous sink
+ */
+
+#ifndef NATIVE_LOG_H
+#define NATIVE_LOG_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+/**
+ * Severity of a log message
+ */
+enum class LogLevel : int
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * Lowest level compiled in; messages below it cost nothing at runtime
+ * e.g. -DBRIGHTSYNC_LOG_COMPILE_LEVEL=2 strips Trace and Debug
+ */
+#ifndef BRIGHTSYNC_LOG_COMPILE_LEVEL
+#define BRIGHTSYNC_LOG_COMPILE_LEVEL 0
+#endif
+
+/**
+ * One formatted message
+ */
+struct LogEntry
+{
+    LogLevel level;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+/**
+ * Receives drained messages in batches, on the log thread
+ */
+typedef std::function<void(const std::vector<LogEntry> &entries)> LogSink;
+
+// Runtime level; read inline by NativeLog::IsEnabled()
+extern std::atomic<int> g_nativeLogLevel;
+
+/**
+ * Process-wide logger
+ *
+ * Write() formats nothing and never blocks: messages go into a fixed-size
+ * lock-free ring (dropped when it is full) and a background thread hands
+ * them to the sink in batches. The default sink writes to stdout with one
+ * flush per batch instead of one per line.
+ *
+ * Use the BS_LOG_* macros, which skip formatting entirely when the level is
+ * disabled. All methods are thread-safe.
+ */
+class NativeLog
+{
+public:
+    static const size_t CAPACITY = 1024;
+
+    /**
+     * Check whether a level is enabled at runtime
+     */
+    static bool IsEnabled(LogLevel level)
+    {
+        return static_cast<int>(level) >= g_nativeLogLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the runtime level (default Info)
+     */
+    static void SetLevel(LogLevel level);
+
+    /**
+     * Get the runtime level
+     */
+    static LogLevel GetLevel();
+
+    /**
+     * Parse "trace", "debug", "info", "warn", "error" or "off"
+     * @return true if the name is known
+     */
+    static bool ParseLevel(const std::string &name, LogLevel &level);
+
+    /**
+     * Name of a level as accepted by ParseLevel()
+     */
+    static const char *LevelName(LogLevel level);
+
+    /**
+     * Queue a message (starts the log thread on first use)
+     */
+    static void Write(LogLevel level, std::string message);
+
+    /**
+     * Replace the sink; an empty sink restores stdout
+     * Returns once the previous sink is no longer running
+     */
+    static void SetSink(LogSink sink);
+
+    /**
+     * Block until every message queued so far has reached the sink
+     */
+    static void Flush();
+
+    /**
+     * Drain remaining messages and stop the log thread
+     * Later messages are delivered synchronously
+     */
+    static void Shutdown();
+
+    /**
+     * Number of messages dropped because the ring was full
+     */
+    static uint64_t GetDroppedCount();
+};
+
+#define BS_LOG(level, expr)                                                          \
+    do                                                                               \
+    {                                                                                \
+        if (static_cast<int>(level) >= BRIGHTSYNC_LOG_COMPILE_LEVEL && NativeLog::IsEnabled(level)) \
+        {                                                                            \
+            std::ostringstream bsLogStream;                                          \
+            bsLogStream << expr;                                                     \
+            NativeLog::Write(level, bsLogStream.str());                              \
+        }                                                                            \
+    } while (0)
+
+#define BS_LOG_TRACE(expr) BS_LOG(LogLevel::Trace, expr)
+#define BS_LOG_DEBUG(expr) BS_LOG(LogLevel::Debug, expr)
+#define BS_LOG_INFO(expr) BS_LOG(LogLevel::Info, expr)
+#define BS_LOG_WARN(expr) BS_LOG(LogLevel::Warn, expr)
+#define BS_LOG_ERROR(expr) BS_LOG(LogLevel::Error, expr)
+
+#endif // NATIVE_LOG_H
@@ -0,0 +1,112 @@
+/**
+ * BrightSync - Panel Event Watcher
+ *
+ * Reports internal panel brightness changes made by the OS
+ */
+
+#include "panel_event_watcher.h"
+#include "hardware_executor.h"
+#include "native_log.h"
+#include <chrono>
+#include <vector>
+
+// Delay before subscribing again after a failure
+static const std::chrono::seconds RETRY_DELAY(5);
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+PanelEventWatcher::PanelEventWatcher()
+    : m_stopRequested(false),
+      m_listening(false)
+{
+}
+
+PanelEventWatcher::~PanelEventWatcher()
+{
+    Stop();
+}
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void PanelEventWatcher::Start(EventCallback onEvent)
+{
+    Stop();
+
+    m_stopRequested = false;
+    m_thread = std::thread(&PanelEventWatcher::Run, this, std::move(onEvent));
+}
+
+void PanelEventWatcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool PanelEventWatcher::IsListening() const
+{
+    return m_listening;
+}
+
+// ============================================================================
+// Watcher Thread
+// ============================================================================
+
+void PanelEventWatcher::Run(EventCallback onEvent)
+{
+    bool warned = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopRequested)
+    {
+        // Poll without the lock so Stop() can request the exit
+        lock.unlock();
+        std::vector<WmiPanel> events;
+        int result = 0;
+        bool ran = HardwareExecutor::Instance().Run(HardwareExecutor::WMI_LANE, [&]()
+                                                    {
+            WmiSession &session = WmiSession::ForCurrentThread();
+            WmiPanel panel;
+            while ((result = session.WaitForBrightnessEvent(panel, 0)) > 0)
+            {
+                events.push_back(panel);
+            } });
+        if (!ran)
+        {
+            // Executor shut down; treated like a WMI failure until Stop()
+            result = -1;
+        }
+        m_listening = result >= 0;
+        for (const auto &panel : events)
+        {
+            if (onEvent)
+            {
+                onEvent(panel);
+            }
+        }
+        lock.lock();
+
+        if (result < 0 && !warned)
+        {
+            BS_LOG_INFO("Panel brightness events unavailable; internal displays will be sampled instead");
+            warned = true;
+        }
+
+        std::chrono::milliseconds delay = result < 0 ? RETRY_DELAY : std::chrono::milliseconds(EVENT_POLL_MS);
+        m_wake.wait_for(lock, delay, [this]()
+                        { return m_stopRequested; });
+    }
+
+    m_listening = false;
+}
@@ -0,0 +1,76 @@
+/**
+ * BrightSync - Panel Event Watcher
+ *
+ * Reports internal panel brightness changes made by the OS
+ */
+
+#ifndef PANEL_EVENT_WATCHER_H
+#define PANEL_EVENT_WATCHER_H
+
+#include "wmi_session.h"
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+/**
+ * Listens for WmiMonitorBrightnessEvent
+ *
+ * Windows raises the event whenever a panel's brightness changes (Fn keys,
+ * the quick settings slider, adaptive brightness), so internal panels need
+ * no sampling. The subscription lives in the WmiSession of the
+ * HardwareExecutor WMI lane, the one thread that owns COM and WMI. The
+ * watcher thread only paces: every EVENT_POLL_MS it has the lane take the
+ * events that arrived, without waiting, so panel reads and writes never
+ * queue behind it. If the subscription fails it is retried every few
+ * seconds and IsListening() reports false in the meantime.
+ */
+class PanelEventWatcher
+{
+public:
+    // Longest time between an event and its callback
+    static const int EVENT_POLL_MS = 100;
+
+    /**
+     * Invoked on the watcher thread for every event
+     */
+    typedef std::function<void(const WmiPanel &panel)> EventCallback;
+
+    PanelEventWatcher();
+
+    /**
+     * Destructor - stops the watcher thread
+     */
+    ~PanelEventWatcher();
+
+    PanelEventWatcher(const PanelEventWatcher &) = delete;
+    PanelEventWatcher &operator=(const PanelEventWatcher &) = delete;
+
+    /**
+     * Start listening (replaces a running watcher)
+     * @param onEvent Called with the panel and its new brightness
+     */
+    void Start(EventCallback onEvent);
+
+    /**
+     * Stop and join the watcher thread
+     */
+    void Stop();
+
+    /**
+     * Check if the event subscription is currently active
+     */
+    bool IsListening() const;
+
+private:
+    void Run(EventCallback onEvent);
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopRequested;
+    std::atomic<bool> m_listening;
+};
+
+#endif // PANEL_EVENT_WATCHER_H
@@ -1,94 +1,164 @@
 /**
  * BrightSync - Real Monitor Implementation
  *
- * Implements actual hardware communication for monitor brightness control
- * Uses Windows WMI for internal displays and DDC/CI for external monitors
+ * Common part of the monitors that talk to actual hardware
+ * Backends: InternalWmiMonitor (WMI) and DdcMonitor (DDC/CI)
  */
 
 #ifndef REAL_MONITOR_H
 #define REAL_MONITOR_H
 
 #include "monitor_interface.h"
-#include <windows.h>
+#include "monitor_stats.h"
+#include "circuit_breaker.h"
 #include <string>
+#include <functional>
+#include <mutex>
+#include <atomic>
 
 /**
- * Real monitor implementation using Windows APIs
+ * Base class of the real monitor backends
  *
- * Internal Display: Uses WMI (Windows Management Instrumentation)
- * External Display: Uses DDC/CI (Display Data Channel Command Interface)
+ * The backend is chosen by the factory when the monitor is created, so
+ * brightness calls go straight to WMI or DDC/CI without looking at the
+ * monitor type. This class keeps the last known value, runs Probe() once
+ * and records read / write statistics; a backend only implements the
+ * hardware transactions. Those always run on the backend's HardwareExecutor
+ * lane, whichever thread called into the monitor, and go through a
+ * CircuitBreaker: a monitor that stopped answering fails fast until
+ * CheckHealth() reaches it again.
  */
 class RealMonitor : public IMonitor
 {
 public:
     /**
-     * Constructor for real monitor
+     * Destructor - cleanup resources
+     */
+    virtual ~RealMonitor();
+
+    // Owns hardware handles in the backends - not copyable
+    RealMonitor(const RealMonitor &) = delete;
+    RealMonitor &operator=(const RealMonitor &) = delete;
+
+    // IMonitor interface implementation
+    virtual const MonitorDescriptor &GetDescriptor() const override;
+    virtual int GetBrightness() const override;
+    virtual int GetLastKnownBrightness() const override;
+    virtual bool SetBrightness(int value) override;
+    virtual int GetHardwareRampResolutionMs() const override;
+    virtual bool SetBrightnessRamped(int value, int durationMs) override;
+
+    /**
+     * Detect capabilities and read the current value (see ProbeHardware)
+     */
+    virtual bool Probe() override;
+    virtual bool IsProbed() const override;
+    virtual bool IsResponding() const override;
+    virtual bool CheckHealth() override;
+
+    /**
+     * Stop the lane of a monitor that has one to itself (DDC/CI); the
+     * WMI lane is shared by all internal panels and keeps running
+     */
+    virtual void Retire() override;
+
+protected:
+    /**
+     * Constructor
      * @param id Unique monitor identifier
      * @param name Human-readable monitor name
-     * @param type Monitor type ("internal" or "external")
-     * @param hMonitor Windows monitor handle
-     * @param supportsWMI Whether monitor supports WMI control
-     * @param supportsDDC Whether monitor supports DDC/CI control
+     * @param type Monitor type
+     * @param lane HardwareExecutor lane of the bus this monitor is on
+     * @param initialBrightness Brightness already read by the caller, or -1
+     *
+     * The constructor does not touch the hardware; call Probe() once to
+     * detect support and read the current value.
      */
     RealMonitor(
         const std::string &id,
         const std::string &name,
-        const std::string &type,
-        HMONITOR hMonitor,
-        bool supportsWMI,
-        bool supportsDDC);
+        MonitorType type,
+        const std::string &lane,
+        int initialBrightness);
 
     /**
-     * Destructor - cleanup resources
+     * Read the hardware once
+     * @return Brightness value (0-100) or -1 on error
      */
-    virtual ~RealMonitor();
+    virtual int ReadHardware() const = 0;
 
-    // IMonitor interface implementation
-    virtual std::string GetId() const override;
-    virtual std::string GetName() const override;
-    virtual std::string GetType() const override;
-    virtual int GetMinBrightness() const override;
-    virtual int GetMaxBrightness() const override;
-    virtual int GetBrightness() const override;
-    virtual bool SetBrightness(int value) override;
-    virtual bool IsControllable() const override;
+    /**
+     * Write the hardware once
+     * @param value Brightness value, already clamped to the monitor range
+     * @return true on success, false on failure
+     */
+    virtual bool WriteHardware(int value) = 0;
 
-private:
-    std::string m_id;
-    std::string m_name;
-    std::string m_type;
-    HMONITOR m_hMonitor;
-    bool m_supportsWMI;
-    bool m_supportsDDC;
-    int m_minBrightness;
-    int m_maxBrightness;
-    mutable int m_currentBrightness;
+    /**
+     * Write the hardware once, asking it to fade (see GetHardwareRampResolutionMs)
+     * Defaults to WriteHardware() for backends without hardware fades
+     * @param value Brightness value, already clamped to the monitor range
+     * @param durationMs Fade time
+     */
+    virtual bool WriteHardwareRamped(int value, int durationMs);
 
     /**
-     * Get brightness for internal display using WMI
-     * @return Brightness value or -1 on error
+     * Detect support and read the initial value; called once by Probe()
+     * @return Brightness value, or -1 if it could not be read
      */
-    int GetInternalBrightnessWMI() const;
+    virtual int ProbeHardware() = 0;
 
     /**
-     * Set brightness for internal display using WMI
-     * @param brightness Brightness value
-     * @return true on success, false on failure
+     * Read the hardware once and record the read
+     * @param recheck Read even if the monitor is not controllable, to find
+     *                out whether it is again (the circuit breaker still applies)
+     * @return Brightness value, or -1 on error or if not controllable
      */
-    bool SetInternalBrightnessWMI(int brightness);
+    int ReadHardwareBrightness(bool recheck = false) const;
 
     /**
-     * Get brightness for external display using DDC/CI
-     * @return Brightness value or -1 on error
+     * Run a command on this monitor's hardware thread and wait for it
+     * (inline when already on it); every hardware access goes through here
+     * @return false if it was not run (executor shut down or no lane thread);
+     *         the caller fails the operation
      */
-    int GetExternalBrightnessDDC() const;
+    bool RunOnHardwareThread(const std::function<void()> &task) const;
 
     /**
-     * Set brightness for external display using DDC/CI
-     * @param brightness Brightness value
-     * @return true on success, false on failure
+     * Whether initialBrightness was given to the constructor
      */
-    bool SetExternalBrightnessDDC(int brightness);
+    bool IsInitialBrightnessKnown() const;
+
+    // Read/write counters of this monitor ID (owned by MonitorStats)
+    MonitorCounters &m_stats;
+
+private:
+    /**
+     * Clamp, write on the hardware thread and record the write
+     * @param rampMs Fade time, or 0 for a plain write
+     */
+    bool WriteBrightness(int value, int rampMs);
+
+    /**
+     * Feed a hardware result to the breaker and log state changes
+     */
+    void RecordHealth(bool success) const;
+
+    /**
+     * Trace category of the hardware calls ("wmi" or "ddc")
+     */
+    const char *GetTraceCategory() const;
+
+    MonitorDescriptor m_descriptor;
+    std::string m_lane;
+    mutable std::atomic<int> m_currentBrightness;
+    bool m_brightnessKnown; // initialBrightness came from the caller
+    mutable CircuitBreaker m_breaker;
+
+    // Probe() runs once; m_probed is set when it has finished
+    std::once_flag m_probeOnce;
+    std::atomic<bool> m_probed;
+    bool m_controllable;
 };
 
 #endif // REAL_MONITOR_H
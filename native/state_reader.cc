@@ -0,0 +1,71 @@
+/**
+ * BrightSync Native Addon - Shared State Reader
+ *
+ * Minimal N-API module for renderer processes. It only maps the shared state
+ * segment the main process publishes (read-only) and exports readSharedState;
+ * none of the HAL (monitors, hardware lanes, logging, tracing) is linked in.
+ */
+
+#include <napi.h>
+#include "state_segment.h"
+
+// Segment of the main process (JS thread only)
+static StateSegmentReader g_stateReader;
+
+/**
+ * N-API: Read the shared state segment
+ * Returns: { version, monitors: [{ id, name, type, min, max, current, probing,
+ *          responding }] }, or null if no segment is published
+ */
+Napi::Value ReadSharedState(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (!g_stateReader.IsOpen() && !g_stateReader.Open(STATE_SEGMENT_NAME))
+    {
+        return env.Null();
+    }
+
+    SharedState state;
+    if (!g_stateReader.Read(state))
+    {
+        return env.Null();
+    }
+
+    Napi::Array monitors = Napi::Array::New(env, state.monitors.size());
+    for (size_t i = 0; i < state.monitors.size(); i++)
+    {
+        const SharedMonitorState &monitor = state.monitors[i];
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("id", Napi::String::New(env, monitor.descriptor.id));
+        obj.Set("name", Napi::String::New(env, monitor.descriptor.name));
+        obj.Set("type", Napi::String::New(env, MonitorTypeName(monitor.descriptor.type)));
+        obj.Set("min", Napi::Number::New(env, monitor.descriptor.minBrightness));
+        obj.Set("max", Napi::Number::New(env, monitor.descriptor.maxBrightness));
+        obj.Set("current", Napi::Number::New(env, monitor.brightness));
+        obj.Set("probing", Napi::Boolean::New(env, monitor.probing));
+        obj.Set("responding", Napi::Boolean::New(env, monitor.responding));
+        monitors[i] = obj;
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("version", Napi::Number::New(env, state.topologyVersion));
+    result.Set("monitors", monitors);
+    return result;
+}
+
+/**
+ * Initialize N-API module
+ */
+Napi::Object Init(Napi::Env env, Napi::Object exports)
+{
+    // Unmap before the module is unloaded
+    env.AddCleanupHook([]()
+                       { g_stateReader.Close(); });
+
+    exports.Set("readSharedState", Napi::Function::New(env, ReadSharedState));
+    return exports;
+}
+
+// Register N-API module
+NODE_API_MODULE(brightsync_state, Init)
@@ -0,0 +1,382 @@
+/**
+ * BrightSync - Shared State Segment Implementation
+ */
+
+#include "state_segment.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+typedef StateSegmentLayout Layout;
+
+// Reads beyond this many retries give up; a write takes microseconds
+static const int MAX_READ_ATTEMPTS = 1000;
+
+static const size_t SEGMENT_BYTES = Layout::TOTAL_WORDS * sizeof(uint32_t);
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "segment words must be plain 32-bit words");
+
+// ============================================================================
+// Word Helpers
+// ============================================================================
+
+/**
+ * Store a string as NUL padded bytes, four per little-endian word
+ * Longer strings are cut at a character boundary
+ */
+static void WriteString(std::atomic<uint32_t> *words, size_t bytes, const std::string &value)
+{
+    size_t length = std::min(value.size(), bytes - 1);
+    while (length > 0 && length < value.size() && (static_cast<unsigned char>(value[length]) & 0xC0) == 0x80)
+    {
+        length--;
+    }
+
+    for (size_t word = 0; word < bytes / 4; word++)
+    {
+        uint32_t packed = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            size_t index = word * 4 + i;
+            if (index < length)
+            {
+                packed |= static_cast<uint32_t>(static_cast<unsigned char>(value[index])) << (8 * i);
+            }
+        }
+        words[word].store(packed, std::memory_order_release);
+    }
+}
+
+/**
+ * Read a string written by WriteString from copied words
+ */
+static std::string ReadString(const uint32_t *words, size_t bytes)
+{
+    std::string value;
+    for (size_t index = 0; index < bytes; index++)
+    {
+        char c = static_cast<char>((words[index / 4] >> (8 * (index % 4))) & 0xFF);
+        if (c == '\0')
+        {
+            break;
+        }
+        value += c;
+    }
+    return value;
+}
+
+#ifdef _WIN32
+/**
+ * Map a view of a file mapping
+ */
+static std::atomic<uint32_t> *MapSegment(HANDLE mapping, DWORD access)
+{
+    return static_cast<std::atomic<uint32_t> *>(MapViewOfFile(mapping, access, 0, 0, SEGMENT_BYTES));
+}
+#endif
+
+// ============================================================================
+// StateSegment
+// ============================================================================
+
+StateSegment::StateSegment()
+    : m_words(nullptr),
+      m_mapping(nullptr),
+      m_topologyVersion(0)
+{
+}
+
+StateSegment::~StateSegment()
+{
+    Close();
+}
+
+bool StateSegment::Create(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_words)
+    {
+        return true;
+    }
+
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+                                        static_cast<DWORD>(SEGMENT_BYTES), name.c_str());
+    if (!mapping)
+    {
+        return false;
+    }
+
+    m_words = MapSegment(mapping, FILE_MAP_WRITE);
+    if (!m_words)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#else
+    (void)name;
+    m_local.reset(new std::atomic<uint32_t>[Layout::TOTAL_WORDS]);
+    m_words = m_local.get();
+#endif
+
+    // Readers check the magic, so it is written last
+    for (size_t i = 0; i < Layout::TOTAL_WORDS; i++)
+    {
+        m_words[i].store(0, std::memory_order_relaxed);
+    }
+    m_words[Layout::VERSION_WORD].store(Layout::VERSION, std::memory_order_relaxed);
+    m_words[Layout::RECORD_SIZE_WORD].store(static_cast<uint32_t>(Layout::RECORD_WORDS), std::memory_order_relaxed);
+    m_words[Layout::MAGIC_WORD].store(Layout::MAGIC, std::memory_order_release);
+
+    m_ids.clear();
+    m_topologyVersion = 0;
+    return true;
+}
+
+void StateSegment::Close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+#ifdef _WIN32
+    if (m_words)
+    {
+        UnmapViewOfFile(m_words);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+#endif
+
+    m_words = nullptr;
+    m_mapping = nullptr;
+    m_local.reset();
+    m_ids.clear();
+}
+
+bool StateSegment::IsOpen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_words != nullptr;
+}
+
+void StateSegment::Publish(const std::vector<std::shared_ptr<IMonitor>> &monitors)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_words)
+    {
+        return;
+    }
+
+    size_t count = std::min(monitors.size(), static_cast<size_t>(Layout::MAX_MONITORS));
+
+    BeginWrite();
+    m_ids.clear();
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        const IMonitor &monitor = *monitors[slot];
+        m_ids.push_back(monitor.GetId());
+        WriteRecord(slot, monitor, monitor.IsProbed() ? monitor.GetLastKnownBrightness() : -1);
+    }
+    m_words[Layout::COUNT_WORD].store(static_cast<uint32_t>(count), std::memory_order_release);
+    m_words[Layout::TOPOLOGY_WORD].store(++m_topologyVersion, std::memory_order_release);
+    EndWrite();
+}
+
+void StateSegment::Update(const IMonitor &monitor, int brightness)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_words)
+    {
+        return;
+    }
+
+    auto it = std::find(m_ids.begin(), m_ids.end(), monitor.GetId());
+    if (it == m_ids.end())
+    {
+        return;
+    }
+
+    size_t slot = static_cast<size_t>(it - m_ids.begin());
+    std::atomic<uint32_t> *record = m_words + Layout::HEADER_WORDS + slot * Layout::RECORD_WORDS;
+    if (brightness < 0)
+    {
+        brightness = static_cast<int32_t>(record[Layout::BRIGHTNESS_WORD].load(std::memory_order_relaxed));
+    }
+
+    BeginWrite();
+    WriteRecord(slot, monitor, brightness);
+    EndWrite();
+}
+
+const std::atomic<uint32_t> *StateSegment::GetWords() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_words;
+}
+
+void StateSegment::BeginWrite()
+{
+    // Odd: readers retry until EndWrite. Data words are stored with release,
+    // so a reader that sees one of them also sees the odd sequence
+    uint32_t sequence = m_words[Layout::SEQUENCE_WORD].load(std::memory_order_relaxed);
+    m_words[Layout::SEQUENCE_WORD].store(sequence + 1, std::memory_order_relaxed);
+}
+
+void StateSegment::EndWrite()
+{
+    uint32_t sequence = m_words[Layout::SEQUENCE_WORD].load(std::memory_order_relaxed);
+    m_words[Layout::SEQUENCE_WORD].store(sequence + 1, std::memory_order_release);
+}
+
+void StateSegment::WriteRecord(size_t slot, const IMonitor &monitor, int brightness)
+{
+    std::atomic<uint32_t> *record = m_words + Layout::HEADER_WORDS + slot * Layout::RECORD_WORDS;
+
+    uint32_t flags = 0;
+    if (!monitor.IsProbed())
+    {
+        flags |= STATE_FLAG_PROBING;
+    }
+    if (monitor.IsResponding())
+    {
+        flags |= STATE_FLAG_RESPONDING;
+    }
+
+    record[Layout::TYPE_WORD].store(monitor.GetType() == MonitorType::Internal ? 0 : 1, std::memory_order_release);
+    record[Layout::FLAGS_WORD].store(flags, std::memory_order_release);
+    record[Layout::MIN_WORD].store(static_cast<uint32_t>(monitor.GetMinBrightness()), std::memory_order_release);
+    record[Layout::MAX_WORD].store(static_cast<uint32_t>(monitor.GetMaxBrightness()), std::memory_order_release);
+    record[Layout::BRIGHTNESS_WORD].store(static_cast<uint32_t>(brightness), std::memory_order_release);
+    WriteString(record + Layout::ID_WORD, Layout::ID_BYTES, monitor.GetId());
+    WriteString(record + Layout::NAME_WORD, Layout::NAME_BYTES, monitor.GetName());
+}
+
+// ============================================================================
+// StateSegmentReader
+// ============================================================================
+
+StateSegmentReader::StateSegmentReader()
+    : m_words(nullptr),
+      m_mapping(nullptr)
+{
+}
+
+StateSegmentReader::~StateSegmentReader()
+{
+    Close();
+}
+
+bool StateSegmentReader::Open(const std::string &name)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    if (!mapping)
+    {
+        return false;
+    }
+
+    m_words = MapSegment(mapping, FILE_MAP_READ);
+    if (!m_words)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+void StateSegmentReader::Attach(const std::atomic<uint32_t> *words)
+{
+    Close();
+    m_words = words;
+}
+
+void StateSegmentReader::Close()
+{
+#ifdef _WIN32
+    if (m_mapping)
+    {
+        UnmapViewOfFile(m_words);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+#endif
+
+    m_words = nullptr;
+    m_mapping = nullptr;
+}
+
+bool StateSegmentReader::IsOpen() const
+{
+    return m_words != nullptr;
+}
+
+bool StateSegmentReader::Read(SharedState &state) const
+{
+    if (!m_words ||
+        m_words[Layout::MAGIC_WORD].load(std::memory_order_acquire) != Layout::MAGIC ||
+        m_words[Layout::VERSION_WORD].load(std::memory_order_relaxed) != Layout::VERSION)
+    {
+        return false;
+    }
+
+    uint32_t copy[Layout::TOTAL_WORDS];
+
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++)
+    {
+        uint32_t before = m_words[Layout::SEQUENCE_WORD].load(std::memory_order_acquire);
+        if (before % 2 != 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Acquire keeps the second sequence load after the copy (plain
+        // loads on x86)
+        for (size_t i = 0; i < Layout::TOTAL_WORDS; i++)
+        {
+            copy[i] = m_words[i].load(std::memory_order_acquire);
+        }
+
+        if (m_words[Layout::SEQUENCE_WORD].load(std::memory_order_relaxed) != before)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        size_t count = std::min(static_cast<size_t>(copy[Layout::COUNT_WORD]), static_cast<size_t>(Layout::MAX_MONITORS));
+        state.topologyVersion = copy[Layout::TOPOLOGY_WORD];
+        state.monitors.clear();
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            const uint32_t *record = copy + Layout::HEADER_WORDS + slot * Layout::RECORD_WORDS;
+
+            SharedMonitorState monitor;
+            monitor.descriptor.id = ReadString(record + Layout::ID_WORD, Layout::ID_BYTES);
+            monitor.descriptor.name = ReadString(record + Layout::NAME_WORD, Layout::NAME_BYTES);
+            monitor.descriptor.type = record[Layout::TYPE_WORD] == 0 ? MonitorType::Internal : MonitorType::External;
+            monitor.descriptor.minBrightness = static_cast<int32_t>(record[Layout::MIN_WORD]);
+            monitor.descriptor.maxBrightness = static_cast<int32_t>(record[Layout::MAX_WORD]);
+            monitor.brightness = static_cast<int32_t>(record[Layout::BRIGHTNESS_WORD]);
+            monitor.probing = (record[Layout::FLAGS_WORD] & STATE_FLAG_PROBING) != 0;
+            monitor.responding = (record[Layout::FLAGS_WORD] & STATE_FLAG_RESPONDING) != 0;
+            state.monitors.push_back(monitor);
+        }
+        return true;
+    }
+
+    return false;
+}
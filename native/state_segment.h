@@ -0,0 +1,186 @@
+/**
+ * BrightSync - Shared State Segment
+ *
+ * Publishes the monitor table and the last confirmed brightness of every
+ * monitor in a named shared-memory segment, so other processes (the
+ * renderer, brightsync_cli, ops scripts) can read it without IPC or
+ * hardware access
+ */
+
+#ifndef STATE_SEGMENT_H
+#define STATE_SEGMENT_H
+
+#include "monitor_interface.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Layout of the segment, in 32-bit little-endian words
+ *
+ * Header (HEADER_WORDS):
+ *   0 magic "BSYN"   1 layout version   2 sequence (seqlock)
+ *   3 topology version   4 monitor count   5 record words   6-7 reserved
+ * Monitor record (RECORD_WORDS) for each of MAX_MONITORS slots:
+ *   0 type (0 internal, 1 external)   1 flags (STATE_FLAG_*)
+ *   2 min   3 max   4 brightness (-1 unknown)   5-7 reserved
+ *   8 id (ID_BYTES, NUL padded UTF-8)   24 name (NAME_BYTES, NUL padded UTF-8)
+ *
+ * The sequence is odd while the writer is updating. A reader copies the
+ * words and retries if the sequence was odd or changed meanwhile (seqlock),
+ * so readers never block the writer.
+ */
+struct StateSegmentLayout
+{
+    static const uint32_t MAGIC = 0x4E595342; // "BSYN"
+    static const uint32_t VERSION = 1;
+
+    static const size_t HEADER_WORDS = 8;
+    static const size_t RECORD_WORDS = 56;
+    static const size_t MAX_MONITORS = 16;
+    static const size_t ID_BYTES = 64;
+    static const size_t NAME_BYTES = 128;
+    static const size_t TOTAL_WORDS = HEADER_WORDS + RECORD_WORDS * MAX_MONITORS;
+
+    // Header words
+    static const size_t MAGIC_WORD = 0;
+    static const size_t VERSION_WORD = 1;
+    static const size_t SEQUENCE_WORD = 2;
+    static const size_t TOPOLOGY_WORD = 3;
+    static const size_t COUNT_WORD = 4;
+    static const size_t RECORD_SIZE_WORD = 5;
+
+    // Record words
+    static const size_t TYPE_WORD = 0;
+    static const size_t FLAGS_WORD = 1;
+    static const size_t MIN_WORD = 2;
+    static const size_t MAX_WORD = 3;
+    static const size_t BRIGHTNESS_WORD = 4;
+    static const size_t ID_WORD = 8;
+    static const size_t NAME_WORD = ID_WORD + ID_BYTES / 4;
+};
+
+// Record flags
+static const uint32_t STATE_FLAG_PROBING = 1;
+static const uint32_t STATE_FLAG_RESPONDING = 2;
+
+// Name of the segment; the layout version is part of it
+static const char STATE_SEGMENT_NAME[] = "Local\\BrightSync.State.v1";
+
+/**
+ * One monitor as read from the segment
+ */
+struct SharedMonitorState
+{
+    MonitorDescriptor descriptor;
+    int brightness; // -1 until confirmed
+    bool probing;
+    bool responding;
+};
+
+/**
+ * Consistent copy of the segment
+ */
+struct SharedState
+{
+    uint32_t topologyVersion = 0; // changes whenever the monitor table does
+    std::vector<SharedMonitorState> monitors;
+};
+
+/**
+ * Writing side of the segment (the addon of the main process)
+ *
+ * Writers are serialized by a mutex, as the seqlock allows only one at a
+ * time; the values come from whichever thread confirmed them. Monitors
+ * beyond MAX_MONITORS are left out. All methods are thread-safe.
+ */
+class StateSegment
+{
+public:
+    StateSegment();
+    ~StateSegment();
+
+    /**
+     * Create the segment (or open it if it exists) and clear it
+     * Outside Windows the segment is private memory of this process.
+     * @param name Segment name (STATE_SEGMENT_NAME)
+     * @return false if it could not be mapped
+     */
+    bool Create(const std::string &name);
+
+    /**
+     * Unmap the segment
+     */
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * Replace the monitor table (after an enumeration)
+     */
+    void Publish(const std::vector<std::shared_ptr<IMonitor>> &monitors);
+
+    /**
+     * Update the brightness and flags of one monitor of the table
+     * @param brightness Confirmed value; negative keeps the previous one
+     */
+    void Update(const IMonitor &monitor, int brightness);
+
+    /**
+     * Words of the segment, for readers in this process (null if closed)
+     */
+    const std::atomic<uint32_t> *GetWords() const;
+
+private:
+    void BeginWrite();
+    void EndWrite();
+    void WriteRecord(size_t slot, const IMonitor &monitor, int brightness);
+
+    mutable std::mutex m_mutex;
+    std::atomic<uint32_t> *m_words;
+    void *m_mapping; // HANDLE of the file mapping (Windows)
+    std::unique_ptr<std::atomic<uint32_t>[]> m_local; // private segment elsewhere
+    std::vector<std::string> m_ids; // slot of each published monitor
+    uint32_t m_topologyVersion;
+};
+
+/**
+ * Reading side of the segment
+ */
+class StateSegmentReader
+{
+public:
+    StateSegmentReader();
+    ~StateSegmentReader();
+
+    /**
+     * Map an existing segment read-only (Windows only)
+     * @return false if no process has created it
+     */
+    bool Open(const std::string &name);
+
+    /**
+     * Read segment words of this process instead
+     */
+    void Attach(const std::atomic<uint32_t> *words);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * Copy the segment
+     * @return false if it is not mapped, has another layout, or a writer
+     *         kept it busy for all attempts
+     */
+    bool Read(SharedState &state) const;
+
+private:
+    const std::atomic<uint32_t> *m_words;
+    void *m_mapping; // HANDLE of the file mapping (Windows)
+};
+
+#endif // STATE_SEGMENT_H
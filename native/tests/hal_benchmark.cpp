@@ -0,0 +1,338 @@
+/**
+ * BrightSync - HAL Benchmarks
+ *
+ * Google Benchmark suite for the hardware abstraction layer
+ * Hardware-bound paths run against mock monitors with MockTiming, so
+ * changes to caching, batching and threading show up as numbers
+ *
+ * Every benchmark reports ops/sec (items_per_second) and the p50 / p99
+ * latency of a single operation in microseconds
+ */
+
+#include <benchmark/benchmark.h>
+#include "../monitor_interface.h"
+#include "../mock_monitor.h"
+#include "../mock_topology.h"
+#include "../monitor_factory.h"
+#include "../monitor_cache.h"
+#include "../monitor_batch.h"
+#include "../brightness_animator.h"
+#include "../write_queue.h"
+#include "../brightness_cache.h"
+#include "../native_log.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * Times each operation and reports ops/sec, p50 and p99 when destroyed
+ */
+class LatencyReport
+{
+public:
+    explicit LatencyReport(benchmark::State &state) : m_state(state) {}
+
+    ~LatencyReport()
+    {
+        m_state.SetItemsProcessed(static_cast<int64_t>(m_samples.size()));
+        m_state.counters["p50_us"] = benchmark::Counter(Percentile(50), benchmark::Counter::kAvgThreads);
+        m_state.counters["p99_us"] = benchmark::Counter(Percentile(99), benchmark::Counter::kAvgThreads);
+    }
+
+    template <typename Operation>
+    void Measure(Operation &&operation)
+    {
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        m_samples.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+
+private:
+    double Percentile(double percentile)
+    {
+        if (m_samples.empty())
+        {
+            return 0;
+        }
+        size_t index = static_cast<size_t>(percentile / 100.0 * (m_samples.size() - 1));
+        std::nth_element(m_samples.begin(), m_samples.begin() + index, m_samples.end());
+        return m_samples[index];
+    }
+
+    benchmark::State &m_state;
+    std::vector<double> m_samples;
+};
+
+/**
+ * Topology of external monitors with DDC/CI timing
+ */
+static MockTopology DdcTopology(int count, double failureRate = 0)
+{
+    MockDisplay display;
+    display.timing = MockTiming::Ddc();
+    display.timing.failureRate = failureRate;
+
+    MockTopology topology;
+    topology.Add(display, count);
+    return topology;
+}
+
+/**
+ * Simulated external monitors with DDC/CI timing
+ */
+static std::vector<std::shared_ptr<IMonitor>> CreateDdcMonitors(int count, double failureRate = 0)
+{
+    MockTopology topology = DdcTopology(count, failureRate);
+    return CreateMonitors(true, std::vector<std::shared_ptr<IMonitor>>(), nullptr, &topology);
+}
+
+/**
+ * Same cache-then-hardware read as brightness.cc
+ */
+static int ReadThroughCache(BrightnessCache &cache, const std::shared_ptr<IMonitor> &monitor)
+{
+    int brightness = -1;
+    if (cache.Lookup(monitor, brightness))
+    {
+        return brightness;
+    }
+    brightness = monitor->GetBrightness();
+    cache.Store(monitor, brightness);
+    return brightness;
+}
+
+// ============================================================================
+// Enumeration and Lookup
+// ============================================================================
+
+static void BM_CreateMonitors(benchmark::State &state)
+{
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(CreateMonitors(true)); });
+    }
+}
+BENCHMARK(BM_CreateMonitors);
+
+static void BM_CreateMonitorsReusingExisting(benchmark::State &state)
+{
+    std::vector<std::shared_ptr<IMonitor>> existing = CreateMonitors(true);
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(CreateMonitors(true, existing)); });
+    }
+}
+BENCHMARK(BM_CreateMonitorsReusingExisting);
+
+/**
+ * Arg: number of simulated displays (trading-floor setups drive 8-16)
+ */
+static void BM_CreateMonitorsLargeTopology(benchmark::State &state)
+{
+    MockTopology topology = DdcTopology(static_cast<int>(state.range(0)));
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(CreateMonitors(true, std::vector<std::shared_ptr<IMonitor>>(), nullptr, &topology)); });
+    }
+}
+BENCHMARK(BM_CreateMonitorsLargeTopology)->Arg(3)->Arg(8)->Arg(16);
+
+static void BM_MonitorCacheGetMonitors(benchmark::State &state)
+{
+    static MonitorCache cache([](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                              { return CreateMonitors(true, existing); });
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(cache.GetMonitors()); });
+    }
+}
+BENCHMARK(BM_MonitorCacheGetMonitors)->Threads(1)->Threads(4);
+
+static void BM_MonitorCacheFind(benchmark::State &state)
+{
+    static MonitorCache cache([](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                              { return CreateMonitors(true, existing); });
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(cache.Find("mock_external_1")); });
+    }
+}
+BENCHMARK(BM_MonitorCacheFind)->Threads(1)->Threads(4);
+
+// ============================================================================
+// Brightness Reads
+// ============================================================================
+
+/**
+ * Arg: cache window in ms (0 = every read goes to the simulated bus)
+ */
+static void BM_ReadBrightness(benchmark::State &state)
+{
+    BrightnessCache cache(std::chrono::milliseconds(state.range(0)));
+    std::shared_ptr<IMonitor> monitor = CreateDdcMonitors(1)[0];
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(ReadThroughCache(cache, monitor)); });
+    }
+}
+BENCHMARK(BM_ReadBrightness)->Arg(0)->Arg(5000)->UseRealTime();
+
+/**
+ * Steady-state poll the way readBrightnessSnapshot answers it: the shared
+ * topology snapshot and the brightness cache, no enumeration, lock or
+ * allocation
+ * Arg: number of simulated displays
+ */
+static void BM_BrightnessSnapshot(benchmark::State &state)
+{
+    MockTopology topology = DdcTopology(static_cast<int>(state.range(0)));
+    MonitorCache cache([&](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                       { return CreateMonitors(true, existing, nullptr, &topology); });
+    BrightnessCache brightness(std::chrono::milliseconds(60000));
+    for (const auto &monitor : cache.GetMonitors())
+    {
+        brightness.Store(monitor, monitor->GetLastKnownBrightness());
+    }
+
+    std::vector<int> values(static_cast<size_t>(state.range(0)));
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        report.Measure([&]()
+                       {
+            MonitorCache::SnapshotPtr snapshot = cache.TryGetSnapshot();
+            for (size_t i = 0; i < snapshot->monitors.size(); i++)
+            {
+                brightness.Lookup(snapshot->monitors[i], values[i]);
+            }
+            benchmark::DoNotOptimize(snapshot->version); });
+    }
+}
+BENCHMARK(BM_BrightnessSnapshot)->Arg(3)->Arg(16);
+
+// ============================================================================
+// Brightness Writes
+// ============================================================================
+
+/**
+ * Several callers writing one DDC/CI monitor; coalescing keeps the bus busy
+ * with at most one write while the rest are superseded
+ */
+static void BM_WriteQueueContention(benchmark::State &state)
+{
+    static WriteQueue queue;
+    static std::shared_ptr<IMonitor> monitor = CreateDdcMonitors(1)[0];
+    int value = static_cast<int>(state.thread_index());
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        value = (value + 7) % 101;
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(queue.Write(monitor, value)); });
+    }
+}
+BENCHMARK(BM_WriteQueueContention)->Threads(1)->Threads(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Arg: number of DDC/CI monitors written in one batch
+ * Buses run in parallel, so latency should stay near a single write
+ */
+static void BM_BatchWrite(benchmark::State &state)
+{
+    std::vector<std::shared_ptr<IMonitor>> monitors = CreateDdcMonitors(static_cast<int>(state.range(0)), 0.02);
+    int value = 0;
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        value = (value + 13) % 101;
+        std::vector<BatchItem> items;
+        for (const auto &monitor : monitors)
+        {
+            items.push_back({monitor->GetId(), monitor, value});
+        }
+        report.Measure([&]()
+                       { benchmark::DoNotOptimize(ExecuteBrightnessBatch(items)); });
+    }
+}
+BENCHMARK(BM_BatchWrite)->Arg(1)->Arg(3)->Arg(8)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Transitions
+// ============================================================================
+
+/**
+ * Full 0 <-> 100 transition on a DDC/CI monitor with a 250 ms budget
+ */
+static void BM_Transition(benchmark::State &state)
+{
+    std::shared_ptr<IMonitor> monitor = CreateDdcMonitors(1)[0];
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t finished = 0;
+
+    BrightnessAnimator animator(
+        [&](const std::string &)
+        { return monitor; },
+        [&](const AnimationResult &result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = result.token;
+            cv.notify_all();
+        });
+
+    int target = 0;
+    LatencyReport report(state);
+    for (auto _ : state)
+    {
+        target = target == 0 ? 100 : 0;
+        report.Measure([&]()
+                       {
+            uint64_t token = animator.SetTarget(monitor->GetId(), target, 250);
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]()
+                    { return finished == token; }); });
+    }
+}
+BENCHMARK(BM_Transition)->Iterations(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Main Entry Point
+// ============================================================================
+
+int main(int argc, char **argv)
+{
+    // Enumeration logs at Info; keep the benchmark output readable
+    NativeLog::SetLevel(LogLevel::Warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    NativeLog::Shutdown();
+    return 0;
+}
@@ -9,11 +9,36 @@
 #include "../monitor_interface.h"
 #include "../mock_monitor.h"
 #include "../monitor_factory.h"
+#include "../monitor_cache.h"
+#include "../monitor_batch.h"
+#include "../brightness_animator.h"
+#include "../write_queue.h"
+#include "../brightness_cache.h"
+#include "../monitor_prober.h"
+#include "../capability_store.h"
+#include "../ddc_pacer.h"
+#include "../native_log.h"
+#include "../monitor_stats.h"
+#include "../mock_topology.h"
+#include "../brightness_watcher.h"
+#include "../hardware_executor.h"
+#include "../circuit_breaker.h"
+#include "../health_watcher.h"
+#include "../trace_recorder.h"
+#include "../state_segment.h"
 #include <memory>
 #include <vector>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
 
 // ============================================================================
 // MockMonitor Basic Functionality Tests
@@ -39,6 +64,11 @@ TEST_F(MockMonitorTest, InitializesWithCorrectId)
     EXPECT_EQ(monitor->GetId(), "test_mock_0");
 }
 
+TEST_F(MockMonitorTest, GetIdReturnsStableReference)
+{
+    EXPECT_EQ(&monitor->GetId(), &monitor->GetId());
+}
+
 TEST_F(MockMonitorTest, InitializesWithCorrectName)
 {
     EXPECT_EQ(monitor->GetName(), "Test Mock Display");
@@ -46,7 +76,7 @@ TEST_F(MockMonitorTest, InitializesWithCorrectName)
 
 TEST_F(MockMonitorTest, InitializesWithCorrectType)
 {
-    EXPECT_EQ(monitor->GetType(), "internal");
+    EXPECT_EQ(monitor->GetType(), MonitorType::Internal);
 }
 
 TEST_F(MockMonitorTest, InitializesWithCorrectBrightness)
@@ -64,6 +94,27 @@ TEST_F(MockMonitorTest, HasCorrectMaxBrightness)
     EXPECT_EQ(monitor->GetMaxBrightness(), 100);
 }
 
+TEST_F(MockMonitorTest, DescriptorMatchesAccessors)
+{
+    const MonitorDescriptor &descriptor = monitor->GetDescriptor();
+
+    EXPECT_EQ(descriptor.id, "test_mock_0");
+    EXPECT_EQ(descriptor.name, "Test Mock Display");
+    EXPECT_EQ(descriptor.type, MonitorType::Internal);
+    EXPECT_EQ(descriptor.minBrightness, 0);
+    EXPECT_EQ(descriptor.maxBrightness, 100);
+    EXPECT_EQ(&monitor->GetName(), &descriptor.name);
+}
+
+TEST_F(MockMonitorTest, DescriptorSurvivesBrightnessChanges)
+{
+    const MonitorDescriptor *before = &monitor->GetDescriptor();
+    monitor->SetBrightness(80);
+
+    EXPECT_EQ(&monitor->GetDescriptor(), before);
+    EXPECT_EQ(monitor->GetDescriptor().id, "test_mock_0");
+}
+
 TEST_F(MockMonitorTest, IsControllable)
 {
     EXPECT_TRUE(monitor->IsControllable());
@@ -104,6 +155,13 @@ TEST_F(MockMonitorTest, GetBrightnessAfterMultipleSets)
     EXPECT_EQ(monitor->GetBrightness(), 75);
 }
 
+TEST_F(MockMonitorTest, LastKnownBrightnessTracksWrites)
+{
+    EXPECT_EQ(monitor->GetLastKnownBrightness(), 50);
+    monitor->SetBrightness(30);
+    EXPECT_EQ(monitor->GetLastKnownBrightness(), 30);
+}
+
 // ============================================================================
 // Clamping Tests
 // ============================================================================
@@ -132,6 +190,62 @@ TEST_F(MockMonitorTest, ClampsLargePositiveValue)
     EXPECT_EQ(monitor->GetBrightness(), 100);
 }
 
+// ============================================================================
+// Mock Timing Tests
+// ============================================================================
+
+TEST(MockTimingTest, DefaultTimingIsInstant)
+{
+    MockMonitor monitor("timing", "Timing", "external");
+    MockTiming timing = monitor.GetTiming();
+    EXPECT_EQ(timing.readLatencyUs, 0);
+    EXPECT_EQ(timing.writeLatencyUs, 0);
+    EXPECT_EQ(timing.failureRate, 0);
+}
+
+TEST(MockTimingTest, WritesTakeTheConfiguredLatency)
+{
+    MockTiming timing;
+    timing.writeLatencyUs = 20000;
+    MockMonitor monitor("timing", "Timing", "external", 50, timing);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(monitor.SetBrightness(70));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(monitor.GetBrightness(), 70);
+}
+
+TEST(MockTimingTest, FailedWriteKeepsBrightness)
+{
+    MockMonitor monitor("timing", "Timing", "external", 50);
+    MockTiming timing;
+    timing.failureRate = 1;
+    monitor.SetTiming(timing);
+
+    EXPECT_FALSE(monitor.SetBrightness(80));
+    EXPECT_EQ(monitor.GetBrightness(), 50);
+}
+
+TEST(MockTimingTest, BrightnessIsQuantizedToTheVcpRange)
+{
+    // Ten raw steps: every value lands on a multiple of ten percent
+    MockMonitor monitor("coarse", "Coarse", "external", 50, MockTiming(), 10);
+    EXPECT_TRUE(monitor.SetBrightness(34));
+    EXPECT_EQ(monitor.GetBrightness(), 30);
+    EXPECT_TRUE(monitor.SetBrightness(36));
+    EXPECT_EQ(monitor.GetBrightness(), 40);
+    EXPECT_TRUE(monitor.SetBrightness(100));
+    EXPECT_EQ(monitor.GetBrightness(), 100);
+}
+
+TEST(MockTimingTest, PresetsFollowHardwareTimings)
+{
+    // DDC/CI is an order of magnitude slower than WMI and not fully reliable
+    EXPECT_GT(MockTiming::Ddc().writeLatencyUs, 10 * 1000);
+    EXPECT_GT(MockTiming::Ddc().failureRate, 0);
+    EXPECT_LT(MockTiming::Wmi().writeLatencyUs, MockTiming::Ddc().writeLatencyUs);
+}
+
 // ============================================================================
 // Monitor Factory Tests
 // ============================================================================
@@ -155,19 +269,19 @@ TEST_F(MonitorFactoryTest, CreatesThreeMonitorsInMockMode)
 TEST_F(MonitorFactoryTest, FirstMonitorIsInternal)
 {
     ASSERT_GE(monitors.size(), 1);
-    EXPECT_EQ(monitors[0]->GetType(), "internal");
+    EXPECT_EQ(monitors[0]->GetType(), MonitorType::Internal);
 }
 
 TEST_F(MonitorFactoryTest, SecondMonitorIsExternal)
 {
     ASSERT_GE(monitors.size(), 2);
-    EXPECT_EQ(monitors[1]->GetType(), "external");
+    EXPECT_EQ(monitors[1]->GetType(), MonitorType::External);
 }
 
 TEST_F(MonitorFactoryTest, ThirdMonitorIsExternal)
 {
     ASSERT_GE(monitors.size(), 3);
-    EXPECT_EQ(monitors[2]->GetType(), "external");
+    EXPECT_EQ(monitors[2]->GetType(), MonitorType::External);
 }
 
 TEST_F(MonitorFactoryTest, AllMonitorsHaveUniqueIds)
@@ -443,13 +557,13 @@ TEST(InitializationTest, InitializeWithExcessiveBrightnessClamps)
 TEST(MonitorTypeTest, InternalMonitorType)
 {
     auto monitor = std::make_shared<MockMonitor>("test", "Test", "internal", 50);
-    EXPECT_EQ(monitor->GetType(), "internal");
+    EXPECT_EQ(monitor->GetType(), MonitorType::Internal);
 }
 
 TEST(MonitorTypeTest, ExternalMonitorType)
 {
     auto monitor = std::make_shared<MockMonitor>("test", "Test", "external", 50);
-    EXPECT_EQ(monitor->GetType(), "external");
+    EXPECT_EQ(monitor->GetType(), MonitorType::External);
 }
 
 // ============================================================================
@@ -508,6 +622,2397 @@ TEST(SequentialOperationsTest, IncrementalBrightnessDecrease)
     }
 }
 
+// ============================================================================
+// Factory Reuse Tests
+// ============================================================================
+
+TEST(FactoryReuseTest, ReusesExistingMonitorsById)
+{
+    auto first = CreateMonitors(true);
+    auto second = CreateMonitors(true, first);
+
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++)
+    {
+        EXPECT_EQ(first[i].get(), second[i].get());
+    }
+}
+
+TEST(FactoryReuseTest, ReusedMonitorsKeepState)
+{
+    auto first = CreateMonitors(true);
+    first[1]->SetBrightness(80);
+
+    auto second = CreateMonitors(true, first);
+    EXPECT_EQ(second[1]->GetBrightness(), 80);
+}
+
+// ============================================================================
+// Monitor Cache Tests
+// ============================================================================
+
+class MonitorCacheTest : public ::testing::Test
+{
+protected:
+    int factoryCalls = 0;
+    std::unique_ptr<MonitorCache> cache;
+
+    void SetUp() override
+    {
+        cache.reset(new MonitorCache(
+            [this](const std::vector<std::shared_ptr<IMonitor>> &existing)
+            {
+                factoryCalls++;
+                return CreateMonitors(true, existing);
+            }));
+    }
+};
+
+TEST_F(MonitorCacheTest, BuildsOnFirstAccess)
+{
+    EXPECT_EQ(factoryCalls, 0);
+    EXPECT_EQ(cache->GetMonitors().size(), 3);
+    EXPECT_EQ(factoryCalls, 1);
+}
+
+TEST_F(MonitorCacheTest, SteadyStateDoesNotRebuild)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        cache->GetMonitors();
+        cache->Find("mock_external_0");
+    }
+    EXPECT_EQ(factoryCalls, 1);
+    EXPECT_EQ(cache->GetBuildCount(), 1u);
+}
+
+TEST_F(MonitorCacheTest, InvalidateTriggersSingleRebuild)
+{
+    cache->GetMonitors();
+    cache->Invalidate();
+    cache->Invalidate();
+
+    cache->GetMonitors();
+    cache->GetMonitors();
+    EXPECT_EQ(factoryCalls, 2);
+}
+
+TEST_F(MonitorCacheTest, RebuildKeepsExistingMonitorObjects)
+{
+    auto before = cache->Find("mock_external_1");
+    ASSERT_NE(before, nullptr);
+    before->SetBrightness(30);
+
+    cache->Invalidate();
+    auto after = cache->Find("mock_external_1");
+
+    EXPECT_EQ(before.get(), after.get());
+    EXPECT_EQ(after->GetBrightness(), 30);
+}
+
+TEST_F(MonitorCacheTest, ClearDropsExistingMonitorObjects)
+{
+    auto before = cache->Find("mock_internal_0");
+    cache->Clear();
+    auto after = cache->Find("mock_internal_0");
+
+    ASSERT_NE(after, nullptr);
+    EXPECT_NE(before.get(), after.get());
+}
+
+TEST_F(MonitorCacheTest, IndexMatchesEveryMonitor)
+{
+    for (const auto &monitor : cache->GetMonitors())
+    {
+        EXPECT_EQ(cache->Find(monitor->GetId()).get(), monitor.get());
+    }
+
+    cache->Invalidate();
+    for (const auto &monitor : cache->GetMonitors())
+    {
+        EXPECT_EQ(cache->Find(monitor->GetId()).get(), monitor.get());
+    }
+}
+
+TEST_F(MonitorCacheTest, FindReturnsNullForUnknownId)
+{
+    EXPECT_EQ(cache->Find("does_not_exist"), nullptr);
+}
+
+TEST_F(MonitorCacheTest, TryGetMonitorsNeverEnumerates)
+{
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+
+    EXPECT_FALSE(cache->TryGetMonitors(monitors));
+    EXPECT_EQ(factoryCalls, 0);
+
+    cache->GetMonitors();
+    ASSERT_TRUE(cache->TryGetMonitors(monitors));
+    EXPECT_EQ(monitors.size(), 3u);
+
+    cache->Invalidate();
+    EXPECT_FALSE(cache->TryGetMonitors(monitors));
+    EXPECT_EQ(factoryCalls, 1);
+}
+
+TEST_F(MonitorCacheTest, VersionSurvivesRebuildWithSameMonitors)
+{
+    unsigned long before = 0;
+    cache->GetMonitors(&before);
+
+    cache->Invalidate();
+    unsigned long after = 0;
+    cache->GetMonitors(&after);
+
+    EXPECT_EQ(factoryCalls, 2);
+    EXPECT_EQ(before, after);
+}
+
+TEST_F(MonitorCacheTest, VersionChangesOnClear)
+{
+    unsigned long before = 0;
+    cache->GetMonitors(&before);
+
+    cache->Clear();
+    unsigned long after = 0;
+    cache->GetMonitors(&after);
+
+    EXPECT_NE(before, after);
+    EXPECT_EQ(cache->GetVersion(), after);
+}
+
+/**
+ * Poll the non-blocking accessor until the cache has been built count times
+ */
+static bool WaitForBuild(MonitorCache &cache, unsigned long count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!cache.TryGetSnapshot() || cache.GetBuildCount() < count)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST_F(MonitorCacheTest, RebuilderRebuildsOnInvalidate)
+{
+    cache->GetMonitors();
+    cache->StartRebuilder();
+
+    // No reader comes along; the non-blocking accessor gets the new list
+    cache->Invalidate();
+    ASSERT_TRUE(WaitForBuild(*cache, 2));
+    EXPECT_EQ(cache->TryGetSnapshot()->monitors.size(), 3u);
+
+    cache->StopRebuilder();
+    EXPECT_EQ(cache->GetBuildCount(), 2u);
+}
+
+TEST_F(MonitorCacheTest, RebuilderLeavesFirstBuildToReaders)
+{
+    cache->StartRebuilder();
+    cache->Invalidate();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(cache->GetBuildCount(), 0u);
+
+    // Nor after Clear(), which the caller may follow with more setup
+    cache->GetMonitors();
+    cache->Clear();
+    cache->Invalidate();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache->StopRebuilder();
+    EXPECT_EQ(cache->GetBuildCount(), 1u);
+}
+
+TEST(MonitorCacheRebuilderTest, BlockingReaderGetsTheListBeingBuilt)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool building = false;
+    bool release = true;
+    bool unplugged = false;
+
+    MonitorCache cache([&](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                       {
+        std::unique_lock<std::mutex> lock(mutex);
+        building = true;
+        cv.notify_all();
+        cv.wait(lock, [&]()
+                { return release; });
+        auto monitors = CreateMonitors(true, existing);
+        if (unplugged)
+        {
+            monitors.pop_back();
+        }
+        return monitors; });
+    cache.GetMonitors();
+    cache.StartRebuilder();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        building = false;
+        release = false;
+        unplugged = true;
+    }
+    cache.Invalidate();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]()
+                { return building; });
+    }
+
+    // The rebuild thread is enumerating: Try* give nothing, a blocking
+    // reader waits for the new list instead of returning the old one
+    EXPECT_EQ(cache.TryGetSnapshot(), nullptr);
+    std::thread releaser([&]()
+                         {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+        cv.notify_all(); });
+    EXPECT_EQ(cache.GetMonitors().size(), 2u);
+    releaser.join();
+
+    cache.StopRebuilder();
+    EXPECT_EQ(cache.GetBuildCount(), 2u);
+}
+
+TEST(MonitorCacheVersionTest, VersionChangesWhenMonitorsChange)
+{
+    bool unplugged = false;
+    MonitorCache cache([&](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                       {
+        auto monitors = CreateMonitors(true, existing);
+        if (unplugged)
+        {
+            monitors.pop_back();
+        }
+        return monitors; });
+
+    unsigned long before = 0;
+    cache.GetMonitors(&before);
+
+    unplugged = true;
+    cache.Invalidate();
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+    unsigned long after = 0;
+    cache.GetMonitors();
+    ASSERT_TRUE(cache.TryGetMonitors(monitors, &after));
+
+    EXPECT_EQ(monitors.size(), 2u);
+    EXPECT_NE(before, after);
+}
+
+// ============================================================================
+// Batched Write Tests
+// ============================================================================
+
+/**
+ * Mock monitor whose writes take a fixed time, like a slow DDC/CI bus
+ */
+class SlowMockMonitor : public MockMonitor
+{
+public:
+    SlowMockMonitor(const std::string &id, const std::string &type, int delayMs)
+        : MockMonitor(id, id, type, 50), m_delayMs(delayMs) {}
+
+    bool SetBrightness(int value) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_delayMs));
+        m_writes++;
+        return MockMonitor::SetBrightness(value);
+    }
+
+    int GetWriteCount() const { return m_writes; }
+
+private:
+    int m_delayMs;
+    std::atomic<int> m_writes{0};
+};
+
+TEST(BatchTest, ReturnsResultsInRequestOrder)
+{
+    auto monitors = CreateMonitors(true);
+    std::vector<BatchItem> items;
+    for (size_t i = 0; i < monitors.size(); i++)
+    {
+        items.push_back({monitors[i]->GetId(), monitors[i], static_cast<int>(10 * (i + 1))});
+    }
+
+    auto results = ExecuteBrightnessBatch(items);
+
+    ASSERT_EQ(results.size(), monitors.size());
+    for (size_t i = 0; i < monitors.size(); i++)
+    {
+        EXPECT_EQ(results[i].id, monitors[i]->GetId());
+        EXPECT_TRUE(results[i].success);
+        EXPECT_EQ(monitors[i]->GetBrightness(), static_cast<int>(10 * (i + 1)));
+    }
+}
+
+TEST(BatchTest, ReportsUnknownMonitor)
+{
+    std::vector<BatchItem> items = {{"missing", nullptr, 50}};
+
+    auto results = ExecuteBrightnessBatch(items);
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_FALSE(results[0].error.empty());
+}
+
+TEST(BatchTest, SameMonitorEntriesApplyInOrder)
+{
+    auto monitor = std::make_shared<MockMonitor>("ext", "Ext", "external", 50);
+    std::vector<BatchItem> items = {{"ext", monitor, 10}, {"ext", monitor, 20}, {"ext", monitor, 30}};
+
+    ExecuteBrightnessBatch(items);
+
+    EXPECT_EQ(monitor->GetBrightness(), 30);
+}
+
+TEST(BatchTest, ExternalMonitorsAreProgrammedInParallel)
+{
+    const int delayMs = 100;
+    std::vector<BatchItem> items;
+    for (int i = 0; i < 3; i++)
+    {
+        std::string id = "slow_external_" + std::to_string(i);
+        items.push_back({id, std::make_shared<SlowMockMonitor>(id, "external", delayMs), 75});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = ExecuteBrightnessBatch(items);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    for (const auto &result : results)
+    {
+        EXPECT_TRUE(result.success);
+    }
+
+    // Slowest monitor, not the sum of all three
+    EXPECT_LT(elapsed, 2 * delayMs);
+}
+
+// ============================================================================
+// Brightness Animator Tests
+// ============================================================================
+
+class AnimatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        animator.reset(new BrightnessAnimator(
+            [this](const std::string &id) -> std::shared_ptr<IMonitor>
+            {
+                auto it = monitors.find(id);
+                return it != monitors.end() ? it->second : nullptr;
+            },
+            [this](const AnimationResult &result)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                results.push_back(result);
+                cv.notify_all();
+            }));
+    }
+
+    void TearDown() override
+    {
+        animator->Stop();
+    }
+
+    /**
+     * Wait until at least count results arrived
+     */
+    bool WaitForResults(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&]
+                           { return results.size() >= count; });
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<IMonitor>> monitors;
+    std::unique_ptr<BrightnessAnimator> animator;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<AnimationResult> results;
+};
+
+TEST_F(AnimatorTest, ReachesTarget)
+{
+    monitors["fast"] = std::make_shared<MockMonitor>("fast", "Fast", "internal", 50);
+
+    uint64_t token = animator->SetTarget("fast", 80, 100);
+
+    ASSERT_TRUE(WaitForResults(1));
+    EXPECT_EQ(results[0].token, token);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[0].superseded);
+    EXPECT_EQ(results[0].value, 80);
+    EXPECT_EQ(monitors["fast"]->GetBrightness(), 80);
+}
+
+TEST_F(AnimatorTest, ClampsTargetToMonitorRange)
+{
+    monitors["fast"] = std::make_shared<MockMonitor>("fast", "Fast", "internal", 50);
+
+    animator->SetTarget("fast", 150, 0);
+
+    ASSERT_TRUE(WaitForResults(1));
+    EXPECT_TRUE(results[0].success);
+    EXPECT_EQ(monitors["fast"]->GetBrightness(), 100);
+}
+
+TEST_F(AnimatorTest, NewerTargetSupersedesInFlight)
+{
+    auto slow = std::make_shared<SlowMockMonitor>("slow", "external", 20);
+    monitors["slow"] = slow;
+
+    uint64_t first = animator->SetTarget("slow", 100, 1000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    uint64_t second = animator->SetTarget("slow", 0, 100);
+
+    ASSERT_TRUE(WaitForResults(2));
+    EXPECT_EQ(results[0].token, first);
+    EXPECT_TRUE(results[0].superseded);
+    EXPECT_EQ(results[1].token, second);
+    EXPECT_TRUE(results[1].success);
+    EXPECT_EQ(slow->GetBrightness(), 0);
+
+    // The first ramp was abandoned part way instead of running to 100
+    EXPECT_LT(slow->GetWriteCount(), 40);
+}
+
+TEST_F(AnimatorTest, UnknownMonitorFails)
+{
+    animator->SetTarget("missing", 50, 100);
+
+    ASSERT_TRUE(WaitForResults(1));
+    EXPECT_FALSE(results[0].success);
+    EXPECT_FALSE(results[0].superseded);
+}
+
+TEST_F(AnimatorTest, RemovedTrackFailsItsTransition)
+{
+    monitors["slow"] = std::make_shared<SlowMockMonitor>("slow", "external", 20);
+
+    uint64_t token = animator->SetTarget("slow", 100, 1000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_EQ(animator->GetTrackCount(), 1u);
+    animator->RemoveTrack("slow");
+    EXPECT_EQ(animator->GetTrackCount(), 0u);
+
+    ASSERT_TRUE(WaitForResults(1));
+    EXPECT_EQ(results[0].token, token);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_FALSE(results[0].superseded);
+
+    // A monitor that comes back gets a new track
+    animator->SetTarget("slow", 30, 0);
+    ASSERT_TRUE(WaitForResults(2));
+    EXPECT_TRUE(results[1].success);
+    EXPECT_EQ(animator->GetTrackCount(), 1u);
+}
+
+TEST_F(AnimatorTest, StepsAdaptToWriteLatency)
+{
+    auto slow = std::make_shared<SlowMockMonitor>("slow", "external", 40);
+    auto fast = std::make_shared<SlowMockMonitor>("fast", "internal", 0);
+    monitors["slow"] = slow;
+    monitors["fast"] = fast;
+
+    animator->SetTarget("slow", 0, 200);
+    animator->SetTarget("fast", 0, 200);
+
+    ASSERT_TRUE(WaitForResults(2));
+    EXPECT_EQ(slow->GetBrightness(), 0);
+    EXPECT_EQ(fast->GetBrightness(), 0);
+    EXPECT_GE(animator->GetWriteLatencyMs("slow"), 30.0);
+
+    // A slow monitor gets fewer, larger steps within the same time budget
+    EXPECT_LE(slow->GetWriteCount(), 8);
+    EXPECT_GT(fast->GetWriteCount(), slow->GetWriteCount());
+}
+
+/**
+ * Monitor that fades by itself in steps of resolutionMs
+ */
+static std::shared_ptr<SlowMockMonitor> MakeRampMonitor(const std::string &id, int resolutionMs)
+{
+    auto monitor = std::make_shared<SlowMockMonitor>(id, "internal", 0);
+    MockTiming timing;
+    timing.rampResolutionMs = resolutionMs;
+    monitor->SetTiming(timing);
+    return monitor;
+}
+
+TEST_F(AnimatorTest, HardwareRampSendsOneWrite)
+{
+    auto panel = MakeRampMonitor("panel", 100);
+    monitors["panel"] = panel;
+
+    auto start = std::chrono::steady_clock::now();
+    animator->SetTarget("panel", 0, 250);
+
+    ASSERT_TRUE(WaitForResults(1));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[0].hardwareRamp);
+    EXPECT_EQ(results[0].value, 0);
+    EXPECT_EQ(panel->GetWriteCount(), 1);
+
+    // Completes when the fade (rounded down to 200 ms) has run
+    EXPECT_GE(elapsed, std::chrono::milliseconds(190));
+}
+
+TEST_F(AnimatorTest, ShortTransitionFallsBackToSoftwareSteps)
+{
+    auto panel = MakeRampMonitor("panel", 100);
+    monitors["panel"] = panel;
+
+    animator->SetTarget("panel", 0, 50);
+
+    ASSERT_TRUE(WaitForResults(1));
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[0].hardwareRamp);
+    EXPECT_EQ(panel->GetBrightness(), 0);
+    EXPECT_GT(panel->GetWriteCount(), 1);
+}
+
+TEST_F(AnimatorTest, NewerTargetCutsHardwareRampShort)
+{
+    auto panel = MakeRampMonitor("panel", 100);
+    monitors["panel"] = panel;
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t first = animator->SetTarget("panel", 100, 2000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t second = animator->SetTarget("panel", 20, 0);
+
+    ASSERT_TRUE(WaitForResults(2));
+    EXPECT_EQ(results[0].token, first);
+    EXPECT_TRUE(results[0].superseded);
+    EXPECT_EQ(results[1].token, second);
+    EXPECT_TRUE(results[1].success);
+    EXPECT_EQ(panel->GetBrightness(), 20);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+}
+
+// ============================================================================
+// Write Queue Tests
+// ============================================================================
+
+TEST(WriteQueueTest, SkipsValueEqualToLastConfirmed)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 0);
+
+    EXPECT_EQ(queue.Write(monitor, 70), WriteOutcome::Written);
+    EXPECT_EQ(queue.Write(monitor, 70), WriteOutcome::Unchanged);
+    EXPECT_EQ(monitor->GetWriteCount(), 1);
+}
+
+TEST(WriteQueueTest, RampedWriteOnMonitorWithoutHardwareFade)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<MockMonitor>("ext", "Ext", "external", 50);
+
+    EXPECT_EQ(monitor->GetHardwareRampResolutionMs(), 0);
+    EXPECT_EQ(queue.Write(monitor, 30, 1000), WriteOutcome::Written);
+    EXPECT_EQ(monitor->GetBrightness(), 30);
+}
+
+TEST(WriteQueueTest, HardwareFadeIsTrackedPerMonitor)
+{
+    WriteQueue queue;
+    auto panel = MakeRampMonitor("panel", 100);
+    auto other = MakeRampMonitor("other", 100);
+
+    EXPECT_EQ(queue.Write(panel, 30, 200), WriteOutcome::Written);
+    EXPECT_EQ(queue.Write(other, 30), WriteOutcome::Written);
+    EXPECT_TRUE(queue.IsFading(panel));
+    EXPECT_FALSE(queue.IsFading(other));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    EXPECT_FALSE(queue.IsFading(panel));
+
+    // A plain write ends the fade early
+    queue.Write(panel, 60, 5000);
+    EXPECT_TRUE(queue.IsFading(panel));
+    queue.Write(panel, 70);
+    EXPECT_FALSE(queue.IsFading(panel));
+}
+
+TEST(WriteQueueTest, RampedWriteWithoutHardwareFadeIsNotFading)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<MockMonitor>("ext", "Ext", "external", 50);
+
+    queue.Write(monitor, 30, 1000);
+    EXPECT_FALSE(queue.IsFading(monitor));
+}
+
+TEST(WriteQueueTest, ObservedValueCountsAsConfirmed)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 0);
+
+    queue.Observe(monitor, 40);
+
+    EXPECT_EQ(queue.Write(monitor, 40), WriteOutcome::Unchanged);
+    EXPECT_EQ(queue.Write(monitor, 41), WriteOutcome::Written);
+    EXPECT_EQ(monitor->GetWriteCount(), 1);
+}
+
+TEST(WriteQueueTest, ClearForgetsConfirmedValues)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 0);
+
+    queue.Write(monitor, 70);
+    queue.Clear();
+
+    EXPECT_EQ(queue.Write(monitor, 70), WriteOutcome::Written);
+    EXPECT_EQ(monitor->GetWriteCount(), 2);
+}
+
+TEST(WriteQueueTest, NewValueReplacesPendingValue)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 100);
+    WriteOutcome first, second, third;
+
+    std::thread a([&]
+                  { first = queue.Write(monitor, 10); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread b([&]
+                  { second = queue.Write(monitor, 20); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread c([&]
+                  { third = queue.Write(monitor, 30); });
+
+    a.join();
+    b.join();
+    c.join();
+
+    // The in-flight write finishes, the waiting one is dropped, the newest wins
+    EXPECT_EQ(first, WriteOutcome::Written);
+    EXPECT_EQ(second, WriteOutcome::Superseded);
+    EXPECT_EQ(third, WriteOutcome::Written);
+    EXPECT_EQ(monitor->GetBrightness(), 30);
+    EXPECT_EQ(monitor->GetWriteCount(), 2);
+}
+
+TEST(WriteQueueTest, BurstWritesAreBounded)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 20);
+
+    std::vector<std::thread> writers;
+    for (int i = 1; i <= 20; i++)
+    {
+        writers.emplace_back([&queue, &monitor, i]
+                             { queue.Write(monitor, i); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    // Far fewer hardware writes than requests, and the last request lands
+    EXPECT_LT(monitor->GetWriteCount(), 20);
+    EXPECT_EQ(monitor->GetBrightness(), 20);
+}
+
+TEST(WriteQueueTest, DepthCountsInFlightAndWaitingWrites)
+{
+    WriteQueue queue;
+    auto monitor = std::make_shared<SlowMockMonitor>("ext", "external", 100);
+    EXPECT_EQ(queue.GetDepth(), 0u);
+
+    std::thread a([&]
+                  { queue.Write(monitor, 10); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(queue.GetDepth(), 1u);
+
+    std::thread b([&]
+                  { queue.Write(monitor, 20); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(queue.GetDepth(), 2u);
+
+    a.join();
+    b.join();
+    EXPECT_EQ(queue.GetDepth(), 0u);
+}
+
+// ============================================================================
+// Brightness Cache Tests
+// ============================================================================
+
+TEST(BrightnessCacheTest, ServesFreshValues)
+{
+    BrightnessCache cache(std::chrono::milliseconds(1000));
+    auto monitor = std::make_shared<MockMonitor>("ext", "External", "external", 50);
+    int value = -1;
+
+    EXPECT_FALSE(cache.Lookup(monitor, value));
+
+    cache.Store(monitor, 65);
+
+    ASSERT_TRUE(cache.Lookup(monitor, value));
+    EXPECT_EQ(value, 65);
+}
+
+TEST(BrightnessCacheTest, ExpiresAfterWindow)
+{
+    BrightnessCache cache(std::chrono::milliseconds(20));
+    auto monitor = std::make_shared<MockMonitor>("ext", "External", "external", 50);
+    int value = -1;
+
+    cache.Store(monitor, 65);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+    EXPECT_FALSE(cache.Lookup(monitor, value));
+}
+
+TEST(BrightnessCacheTest, ZeroWindowDisablesCaching)
+{
+    BrightnessCache cache(std::chrono::milliseconds(0));
+    auto monitor = std::make_shared<MockMonitor>("ext", "External", "external", 50);
+    int value = -1;
+
+    cache.Store(monitor, 65);
+
+    EXPECT_FALSE(cache.Lookup(monitor, value));
+}
+
+TEST(BrightnessCacheTest, IgnoresReadErrorsAndRecreatedMonitors)
+{
+    BrightnessCache cache(std::chrono::milliseconds(1000));
+    auto monitor = std::make_shared<MockMonitor>("ext", "External", "external", 50);
+    auto recreated = std::make_shared<MockMonitor>("ext", "External", "external", 50);
+    int value = -1;
+
+    cache.Store(monitor, -1);
+    EXPECT_FALSE(cache.Lookup(monitor, value));
+
+    cache.Store(monitor, 30);
+    EXPECT_FALSE(cache.Lookup(recreated, value));
+
+    cache.Invalidate(monitor);
+    EXPECT_FALSE(cache.Lookup(monitor, value));
+}
+
+// ============================================================================
+// Monitor Prober Tests
+// ============================================================================
+
+/**
+ * Mock monitor whose capability probe takes a fixed time, like a display
+ * that is slow to answer DDC/CI
+ */
+class SlowProbeMonitor : public MockMonitor
+{
+public:
+    SlowProbeMonitor(const std::string &id, int delayMs)
+        : MockMonitor(id, id, "external", 50), m_delayMs(delayMs), m_probed(false) {}
+
+    bool Probe() override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_delayMs));
+        m_probed = true;
+        return true;
+    }
+
+    bool IsProbed() const override { return m_probed; }
+
+private:
+    int m_delayMs;
+    std::atomic<bool> m_probed;
+};
+
+TEST(MonitorProberTest, ProbesAllMonitorsConcurrently)
+{
+    const int delayMs = 100;
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+    for (int i = 0; i < 3; i++)
+    {
+        monitors.push_back(std::make_shared<SlowProbeMonitor>("slow_" + std::to_string(i), delayMs));
+    }
+
+    MonitorProber prober;
+    std::atomic<int> probed(0);
+
+    auto start = std::chrono::steady_clock::now();
+    prober.ProbeAsync(monitors, [&](const std::shared_ptr<IMonitor> &)
+                      { probed++; });
+    auto queued = std::chrono::steady_clock::now();
+    prober.Wait();
+    auto finished = std::chrono::steady_clock::now();
+
+    // Returns before any probe completes, and all probes overlap
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(queued - start).count(), delayMs);
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(finished - start).count(), 2 * delayMs);
+    EXPECT_EQ(probed, 3);
+    for (const auto &monitor : monitors)
+    {
+        EXPECT_TRUE(monitor->IsProbed());
+    }
+}
+
+TEST(MonitorProberTest, SkipsMonitorsAlreadyProbed)
+{
+    auto monitors = CreateMonitors(true);
+    MonitorProber prober;
+    std::atomic<int> probed(0);
+
+    prober.ProbeAsync(monitors, [&](const std::shared_ptr<IMonitor> &)
+                      { probed++; });
+    prober.Wait();
+
+    EXPECT_EQ(probed, 0);
+}
+
+// ============================================================================
+// Capability Store Tests
+// ============================================================================
+
+static std::string CapabilityTestPath(const std::string &name)
+{
+    std::string path = ::testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+TEST(CapabilityStoreTest, PersistsAcrossInstances)
+{
+    std::string path = CapabilityTestPath("capabilities_roundtrip.txt");
+
+    {
+        CapabilityStore store;
+        EXPECT_FALSE(store.Load(path));
+
+        MonitorCapabilities vcp;
+        vcp.method = DdcMethod::Vcp;
+        vcp.maxValue = 255;
+        store.Update("monitor_del40f0_3f2a9c1e", vcp);
+
+        MonitorCapabilities dead;
+        dead.method = DdcMethod::Unsupported;
+        store.Update("monitor_unknown_0badf00d", dead);
+    }
+
+    CapabilityStore store;
+    ASSERT_TRUE(store.Load(path));
+    EXPECT_EQ(store.Size(), 2u);
+
+    MonitorCapabilities capabilities;
+    ASSERT_TRUE(store.Lookup("monitor_del40f0_3f2a9c1e", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::Vcp);
+    EXPECT_EQ(capabilities.maxValue, 255);
+
+    ASSERT_TRUE(store.Lookup("monitor_unknown_0badf00d", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::Unsupported);
+
+    EXPECT_FALSE(store.Lookup("monitor_missing_00000000", capabilities));
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityStoreTest, ForgetAndUnknownRemoveEntries)
+{
+    std::string path = CapabilityTestPath("capabilities_forget.txt");
+
+    CapabilityStore store;
+    store.Load(path);
+
+    MonitorCapabilities highLevel;
+    highLevel.method = DdcMethod::HighLevel;
+    store.Update("a", highLevel);
+    store.Update("b", highLevel);
+
+    store.Forget("a");
+    store.Update("b", MonitorCapabilities());
+    EXPECT_EQ(store.Size(), 0u);
+
+    CapabilityStore reloaded;
+    EXPECT_FALSE(reloaded.Load(path));
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityStoreTest, IgnoresOtherVersionsAndMalformedLines)
+{
+    std::string path = CapabilityTestPath("capabilities_version.txt");
+
+    {
+        std::ofstream file(path);
+        file << "BrightSyncCapabilities 99\n"
+             << "monitor_a\t1\t0\n";
+    }
+
+    CapabilityStore store;
+    EXPECT_FALSE(store.Load(path));
+    EXPECT_EQ(store.Size(), 0u);
+
+    {
+        std::ofstream file(path);
+        file << "BrightSyncCapabilities " << CapabilityStore::FORMAT_VERSION << "\n"
+             << "monitor_a\t1\t0\n"
+             << "monitor_b\tgarbage\n"
+             << "monitor_c\t7\t0\n";
+    }
+
+    EXPECT_TRUE(store.Load(path));
+    EXPECT_EQ(store.Size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityStoreTest, PersistsLastTopology)
+{
+    std::string path = CapabilityTestPath("capabilities_topology.txt");
+
+    {
+        CapabilityStore store;
+        store.Load(path);
+
+        KnownDisplay external;
+        external.id = "monitor_del40f0_3f2a9c1e";
+        external.name = "DELL U2720Q\tRev 2";
+        external.brightness = 65;
+
+        KnownDisplay internal;
+        internal.id = "internal_0";
+        internal.name = "Built-in Display";
+        internal.type = MonitorType::Internal;
+
+        store.SetDisplays({external, internal});
+    }
+
+    CapabilityStore store;
+    ASSERT_TRUE(store.Load(path));
+    EXPECT_EQ(store.Size(), 0u);
+
+    std::vector<KnownDisplay> displays = store.GetDisplays();
+    ASSERT_EQ(displays.size(), 2u);
+    EXPECT_EQ(displays[0].id, "monitor_del40f0_3f2a9c1e");
+    EXPECT_EQ(displays[0].name, "DELL U2720Q Rev 2");
+    EXPECT_EQ(displays[0].type, MonitorType::External);
+    EXPECT_EQ(displays[0].brightness, 65);
+    EXPECT_EQ(displays[1].name, "Built-in Display");
+    EXPECT_EQ(displays[1].type, MonitorType::Internal);
+    EXPECT_EQ(displays[1].brightness, -1);
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityStoreTest, ReadsVersionOneFiles)
+{
+    std::string path = CapabilityTestPath("capabilities_v1.txt");
+
+    {
+        std::ofstream file(path);
+        file << "BrightSyncCapabilities 1\n"
+             << "monitor_a\t2\t100\n";
+    }
+
+    CapabilityStore store;
+    ASSERT_TRUE(store.Load(path));
+    EXPECT_EQ(store.Size(), 1u);
+    EXPECT_TRUE(store.GetDisplays().empty());
+    std::remove(path.c_str());
+}
+
+/**
+ * Apply a read outcome to the tracker and the store, as DdcMonitor does
+ */
+static void TrackRead(CapabilityTracker &tracker, CapabilityStore &store, bool answered)
+{
+    MonitorCapabilities detected;
+    detected.method = DdcMethod::Vcp;
+    detected.maxValue = 100;
+
+    MonitorCapabilities persist;
+    if (answered ? tracker.Answered(detected, persist) : tracker.ReadFailed(persist))
+    {
+        store.Update("monitor_a", persist);
+    }
+}
+
+TEST(CapabilityTrackerTest, MonitorThatStopsAnsweringIsNotMarkedUnsupported)
+{
+    std::string path = CapabilityTestPath("capabilities_asleep.txt");
+    CapabilityStore store;
+    store.Load(path);
+    CapabilityTracker tracker;
+
+    TrackRead(tracker, store, true);
+    TrackRead(tracker, store, false);
+    TrackRead(tracker, store, false);
+
+    MonitorCapabilities capabilities;
+    ASSERT_TRUE(store.Lookup("monitor_a", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::Vcp);
+    EXPECT_EQ(tracker.Current().method, DdcMethod::Unknown);
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityTrackerTest, AnswerFromEarlierSessionCounts)
+{
+    std::string path = CapabilityTestPath("capabilities_earlier.txt");
+    CapabilityStore store;
+    store.Load(path);
+
+    MonitorCapabilities stored;
+    stored.method = DdcMethod::HighLevel;
+    stored.maxValue = 100;
+    store.Update("monitor_a", stored);
+
+    CapabilityTracker tracker;
+    tracker.Restore(stored);
+    EXPECT_TRUE(tracker.HasAnswered());
+
+    TrackRead(tracker, store, false);
+    TrackRead(tracker, store, false);
+
+    MonitorCapabilities capabilities;
+    ASSERT_TRUE(store.Lookup("monitor_a", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::HighLevel);
+    std::remove(path.c_str());
+}
+
+TEST(CapabilityTrackerTest, MonitorThatNeverAnsweredIsMarkedUnsupported)
+{
+    std::string path = CapabilityTestPath("capabilities_dead.txt");
+    CapabilityStore store;
+    store.Load(path);
+    CapabilityTracker tracker;
+
+    TrackRead(tracker, store, false);
+
+    MonitorCapabilities capabilities;
+    ASSERT_TRUE(store.Lookup("monitor_a", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::Unsupported);
+
+    // Switching DDC/CI on later is picked up
+    TrackRead(tracker, store, true);
+    ASSERT_TRUE(store.Lookup("monitor_a", capabilities));
+    EXPECT_EQ(capabilities.method, DdcMethod::Vcp);
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// DDC/CI Pacer Tests
+// ============================================================================
+
+TEST(DdcPacerTest, SpacesCommandsBySafeInterval)
+{
+    DdcPacer pacer(30, 10, 5, 100);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; i++)
+    {
+        pacer.Run([]()
+                  { return true; });
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // The first command goes out immediately, the other three wait
+    EXPECT_GE(elapsed, 3 * 30);
+    EXPECT_EQ(pacer.GetIntervalMs(), 30);
+}
+
+TEST(DdcPacerTest, LearnsFasterIntervalDownToFloor)
+{
+    DdcPacer pacer(50, 10, 10, 2);
+
+    for (int i = 0; i < 2; i++)
+        pacer.Complete(true);
+    EXPECT_EQ(pacer.GetIntervalMs(), 40);
+
+    for (int i = 0; i < 20; i++)
+        pacer.Complete(true);
+    EXPECT_EQ(pacer.GetIntervalMs(), 10);
+}
+
+TEST(DdcPacerTest, FailureAtLearnedIntervalRestoresSafeInterval)
+{
+    DdcPacer pacer(50, 10, 10, 1);
+
+    pacer.Complete(true);
+    pacer.Complete(true);
+    EXPECT_EQ(pacer.GetIntervalMs(), 30);
+
+    pacer.Complete(false);
+    EXPECT_EQ(pacer.GetIntervalMs(), 50);
+
+    // Never goes back to the interval that failed
+    for (int i = 0; i < 10; i++)
+        pacer.Complete(true);
+    EXPECT_EQ(pacer.GetIntervalMs(), 40);
+}
+
+TEST(DdcPacerTest, FailureAtSafeIntervalKeepsPacing)
+{
+    DdcPacer pacer(50, 10, 10, 2);
+
+    pacer.Complete(false);
+    EXPECT_EQ(pacer.GetIntervalMs(), 50);
+
+    pacer.Complete(true);
+    pacer.Complete(true);
+    EXPECT_EQ(pacer.GetIntervalMs(), 40);
+}
+
+// ============================================================================
+// Native Log Tests
+// ============================================================================
+
+class NativeLogTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_previousLevel = NativeLog::GetLevel();
+        NativeLog::SetSink([this](const std::vector<LogEntry> &entries)
+                           {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto &entry : entries)
+            {
+                m_messages.push_back(entry.message);
+            } });
+    }
+
+    void TearDown() override
+    {
+        NativeLog::Flush();
+        NativeLog::SetSink(LogSink());
+        NativeLog::SetLevel(m_previousLevel);
+    }
+
+    std::vector<std::string> Messages()
+    {
+        NativeLog::Flush();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_messages;
+    }
+
+    LogLevel m_previousLevel;
+    std::mutex m_mutex;
+    std::vector<std::string> m_messages;
+};
+
+TEST_F(NativeLogTest, DeliversEnabledLevelsOnly)
+{
+    NativeLog::SetLevel(LogLevel::Info);
+
+    BS_LOG_DEBUG("hidden");
+    BS_LOG_INFO("value " << 42);
+    BS_LOG_ERROR("failure");
+
+    std::vector<std::string> messages = Messages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0], "value 42");
+    EXPECT_EQ(messages[1], "failure");
+}
+
+TEST_F(NativeLogTest, DisabledLevelsDoNotFormat)
+{
+    NativeLog::SetLevel(LogLevel::Off);
+
+    int evaluated = 0;
+    auto expensive = [&evaluated]()
+    {
+        evaluated++;
+        return std::string("formatted");
+    };
+
+    BS_LOG_ERROR(expensive());
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(Messages().empty());
+}
+
+TEST_F(NativeLogTest, KeepsPerThreadOrderUnderContention)
+{
+    NativeLog::SetLevel(LogLevel::Trace);
+
+    const int threads = 4;
+    const int perThread = 100;
+    uint64_t droppedBefore = NativeLog::GetDroppedCount();
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; t++)
+    {
+        writers.emplace_back([t]()
+                             {
+            for (int i = 0; i < perThread; i++)
+            {
+                BS_LOG_TRACE(t << " " << i);
+                if (i % 16 == 0)
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    std::vector<std::string> messages = Messages();
+    std::vector<int> next(threads, 0);
+    for (const auto &message : messages)
+    {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(sscanf(message.c_str(), "%d %d", &t, &i), 2);
+        EXPECT_GE(i, next[t]);
+        next[t] = i + 1;
+    }
+
+    // Every message arrives unless the ring overflowed
+    EXPECT_EQ(messages.size() + (NativeLog::GetDroppedCount() - droppedBefore), (size_t)(threads * perThread));
+}
+
+TEST_F(NativeLogTest, DropsWhenRingIsFull)
+{
+    NativeLog::SetLevel(LogLevel::Info);
+
+    // Hold the log thread inside the sink so the ring fills up
+    std::mutex gate;
+    std::atomic<bool> entered(false);
+    NativeLog::SetSink([&](const std::vector<LogEntry> &)
+                       {
+        entered = true;
+        std::lock_guard<std::mutex> wait(gate); });
+    std::unique_lock<std::mutex> hold(gate);
+
+    BS_LOG_INFO("first");
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+
+    uint64_t droppedBefore = NativeLog::GetDroppedCount();
+    for (size_t i = 0; i < NativeLog::CAPACITY + 10; i++)
+    {
+        BS_LOG_INFO("fill " << i);
+    }
+    EXPECT_GE(NativeLog::GetDroppedCount() - droppedBefore, 10u);
+
+    hold.unlock();
+    NativeLog::Flush();
+}
+
+// ============================================================================
+// Monitor Stats Tests
+// ============================================================================
+
+TEST(LatencyHistogramTest, PlacesSamplesInOneTwoFiveBuckets)
+{
+    LatencyHistogram histogram;
+    histogram.Record(std::chrono::microseconds(50));  // < 0.1 ms
+    histogram.Record(std::chrono::microseconds(150)); // < 0.2 ms
+    histogram.Record(std::chrono::milliseconds(30));  // < 50 ms
+    histogram.Record(std::chrono::seconds(10));       // overflow
+
+    LatencyHistogram::Snapshot snapshot = histogram.Read();
+    EXPECT_EQ(snapshot.count, 4u);
+    EXPECT_EQ(snapshot.buckets[0], 1u);
+    EXPECT_EQ(snapshot.buckets[1], 1u);
+    EXPECT_EQ(snapshot.buckets[8], 1u);
+    EXPECT_EQ(snapshot.buckets[LatencyHistogram::BUCKETS - 1], 1u);
+    EXPECT_DOUBLE_EQ(snapshot.maxMs, 10000);
+    EXPECT_DOUBLE_EQ(LatencyHistogram::BucketUpperMs(8), 50);
+}
+
+TEST(LatencyHistogramTest, PercentilesUseBucketBounds)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 98; i++)
+    {
+        histogram.Record(std::chrono::microseconds(1500)); // < 2 ms
+    }
+    histogram.Record(std::chrono::milliseconds(40)); // < 50 ms
+    histogram.Record(std::chrono::milliseconds(70)); // < 100 ms
+
+    LatencyHistogram::Snapshot snapshot = histogram.Read();
+    EXPECT_DOUBLE_EQ(snapshot.PercentileMs(50), 2);
+    EXPECT_DOUBLE_EQ(snapshot.PercentileMs(99), 50);
+
+    // The top bucket is capped at the largest sample seen
+    EXPECT_DOUBLE_EQ(snapshot.PercentileMs(100), 70);
+    EXPECT_NEAR(snapshot.MeanMs(), (98 * 1.5 + 40 + 70) / 100.0, 1e-9);
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero)
+{
+    LatencyHistogram::Snapshot snapshot = LatencyHistogram().Read();
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_DOUBLE_EQ(snapshot.MeanMs(), 0);
+    EXPECT_DOUBLE_EQ(snapshot.PercentileMs(95), 0);
+}
+
+TEST(MonitorStatsTest, CountersAreKeptPerMonitorId)
+{
+    MonitorStats &stats = MonitorStats::Instance();
+    MonitorCounters &first = stats.ForMonitor("stats_test_a");
+
+    // A re-created monitor with the same ID shares its counters
+    EXPECT_EQ(&stats.ForMonitor("stats_test_a"), &first);
+    EXPECT_NE(&stats.ForMonitor("stats_test_b"), &first);
+
+    first.RecordRead(std::chrono::milliseconds(3), true);
+    first.RecordRead(std::chrono::milliseconds(3), false);
+    first.RecordWrite(std::chrono::milliseconds(8), true);
+
+    StatsSnapshot snapshot = stats.Read();
+    auto it = std::find_if(snapshot.monitors.begin(), snapshot.monitors.end(), [](const StatsSnapshot::Monitor &monitor)
+                           { return monitor.id == "stats_test_a"; });
+    ASSERT_NE(it, snapshot.monitors.end());
+    EXPECT_EQ(it->reads, 2u);
+    EXPECT_EQ(it->readFailures, 1u);
+    EXPECT_EQ(it->writes, 1u);
+    EXPECT_EQ(it->writeLatency.count, 1u);
+}
+
+TEST(MonitorStatsTest, ResetZeroesEverything)
+{
+    MonitorStats &stats = MonitorStats::Instance();
+    MonitorCounters &counters = stats.ForMonitor("stats_test_reset");
+    counters.RecordWrite(std::chrono::milliseconds(1), false);
+    stats.RecordCacheHit();
+    stats.RecordWriteCoalesced();
+    stats.RecordEnumeration(std::chrono::milliseconds(12));
+
+    stats.Reset();
+
+    StatsSnapshot snapshot = stats.Read();
+    EXPECT_EQ(snapshot.cacheHits, 0u);
+    EXPECT_EQ(snapshot.writesCoalesced, 0u);
+    EXPECT_EQ(snapshot.enumeration.count, 0u);
+    EXPECT_EQ(counters.writes.load(), 0u);
+    EXPECT_EQ(counters.writeLatency.Read().count, 0u);
+}
+
+// ============================================================================
+// Mock Topology Tests
+// ============================================================================
+
+TEST(MockTopologyTest, DefaultMatchesClassicMockSetup)
+{
+    MockTopology topology = MockTopology::Default();
+    const std::vector<MockDisplay> &displays = topology.GetDisplays();
+
+    ASSERT_EQ(displays.size(), 3u);
+    EXPECT_EQ(displays[0].id, "mock_internal_0");
+    EXPECT_EQ(displays[0].name, "Mock Internal Display");
+    EXPECT_EQ(displays[1].id, "mock_external_0");
+    EXPECT_EQ(displays[1].name, "Mock External Display 1");
+    EXPECT_EQ(displays[2].id, "mock_external_1");
+    EXPECT_EQ(displays[2].name, "Mock External Display 2");
+    EXPECT_EQ(topology.GetNextChangeMs(0), -1);
+}
+
+TEST(MockTopologyTest, AddGeneratesUniqueIdsPerType)
+{
+    MockTopology topology;
+    MockDisplay external;
+    topology.Add(external, 8);
+
+    MockDisplay named;
+    named.id = "desk";
+    named.name = "Desk";
+    topology.Add(named, 2);
+
+    const std::vector<MockDisplay> &displays = topology.GetDisplays();
+    ASSERT_EQ(displays.size(), 10u);
+    EXPECT_EQ(displays[7].id, "mock_external_7");
+    EXPECT_EQ(displays[7].name, "Mock External Display 8");
+    EXPECT_EQ(displays[8].id, "desk_0");
+    EXPECT_EQ(displays[9].name, "Desk 2");
+}
+
+TEST(MockTopologyTest, HotplugTimelineControlsConnectedDisplays)
+{
+    MockTopology topology;
+    MockDisplay late;
+    late.connectAtMs = 100;
+    topology.Add(late);
+
+    MockDisplay leaving;
+    leaving.disconnectAtMs = 200;
+    topology.Add(leaving);
+
+    EXPECT_EQ(topology.GetConnected(0).size(), 1u);
+    EXPECT_EQ(topology.GetConnected(150).size(), 2u);
+    EXPECT_EQ(topology.GetConnected(250).size(), 1u);
+
+    EXPECT_EQ(topology.GetNextChangeMs(0), 100);
+    EXPECT_EQ(topology.GetNextChangeMs(100), 200);
+    EXPECT_EQ(topology.GetNextChangeMs(200), -1);
+}
+
+TEST(MockTopologyTest, FactoryCreatesConnectedDisplays)
+{
+    MockTopology topology;
+    MockDisplay display;
+    display.brightness = 70;
+    topology.Add(display, 16);
+
+    MockDisplay unplugged;
+    unplugged.connectAtMs = 60 * 60 * 1000;
+    topology.Add(unplugged);
+
+    auto monitors = CreateMonitors(true, {}, nullptr, &topology);
+    ASSERT_EQ(monitors.size(), 16u);
+    for (const auto &monitor : monitors)
+    {
+        EXPECT_EQ(monitor->GetBrightness(), 70);
+    }
+
+    // Existing monitors are kept across enumerations
+    auto again = CreateMonitors(true, monitors, nullptr, &topology);
+    EXPECT_EQ(again[5], monitors[5]);
+}
+
+TEST(MockTopologyTest, HotplugTimerReportsEachEvent)
+{
+    auto topology = std::make_shared<MockTopology>();
+    for (int ms : {20, 40})
+    {
+        MockDisplay display;
+        display.connectAtMs = ms;
+        topology->Add(display);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int changes = 0;
+
+    MockHotplugTimer timer;
+    timer.Start(topology, [&]()
+                {
+        std::lock_guard<std::mutex> lock(mutex);
+        changes++;
+        cv.notify_all(); });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]()
+                            { return changes == 2; }));
+    lock.unlock();
+
+    timer.Stop();
+    EXPECT_EQ(topology->GetConnected(topology->GetElapsedMs()).size(), 2u);
+}
+
+// ============================================================================
+// Brightness Watcher Tests
+// ============================================================================
+
+TEST(BrightnessWatcherTest, ExternalChangeIsSeenByTheNextRead)
+{
+    MockMonitor monitor("osd", "OSD", "external", 50);
+    monitor.SimulateExternalChange(70);
+
+    EXPECT_EQ(monitor.GetLastKnownBrightness(), 50);
+    EXPECT_EQ(monitor.GetBrightness(), 70);
+    EXPECT_EQ(monitor.GetLastKnownBrightness(), 70);
+}
+
+TEST(BrightnessWatcherTest, SampleReportsOnlyExternalChanges)
+{
+    auto changed = std::make_shared<MockMonitor>("changed", "Changed", "external", 50);
+    auto written = std::make_shared<MockMonitor>("written", "Written", "external", 50);
+    changed->SimulateExternalChange(20);
+    written->SetBrightness(80);
+
+    std::vector<BrightnessChange> changes;
+    size_t count = BrightnessWatcher::Sample({changed, written}, [&](const BrightnessChange &change)
+                                             { changes.push_back(change); });
+
+    ASSERT_EQ(count, 1u);
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].id, "changed");
+    EXPECT_EQ(changes[0].previous, 50);
+    EXPECT_EQ(changes[0].current, 20);
+
+    // Already reported: the next sample finds nothing
+    EXPECT_EQ(BrightnessWatcher::Sample({changed, written}, nullptr), 0u);
+}
+
+TEST(BrightnessWatcherTest, FailedReadReportsNothing)
+{
+    auto monitor = std::make_shared<MockMonitor>("flaky", "Flaky", "external", 50);
+    monitor->SimulateExternalChange(90);
+
+    MockTiming timing;
+    timing.failureRate = 1;
+    monitor->SetTiming(timing);
+
+    EXPECT_EQ(monitor->GetBrightness(), 50);
+    EXPECT_EQ(BrightnessWatcher::Sample({monitor}, nullptr), 0u);
+
+    monitor->SetTiming(MockTiming());
+    EXPECT_EQ(BrightnessWatcher::Sample({monitor}, nullptr), 1u);
+}
+
+TEST(BrightnessWatcherTest, BackgroundThreadReportsChanges)
+{
+    auto monitor = std::make_shared<MockMonitor>("bg", "Background", "external", 40);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<BrightnessChange> changes;
+
+    BrightnessWatcher watcher;
+    watcher.Start([&]()
+                  { return std::vector<std::shared_ptr<IMonitor>>{monitor}; },
+                  [&](const BrightnessChange &change)
+                  {
+        std::lock_guard<std::mutex> lock(mutex);
+        changes.push_back(change);
+        cv.notify_all(); },
+                  std::chrono::milliseconds(10));
+    EXPECT_TRUE(watcher.IsRunning());
+
+    monitor->SimulateExternalChange(65);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]()
+                            { return !changes.empty(); }));
+    lock.unlock();
+
+    watcher.Stop();
+    EXPECT_FALSE(watcher.IsRunning());
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].id, "bg");
+    EXPECT_EQ(changes[0].previous, 40);
+    EXPECT_EQ(changes[0].current, 65);
+}
+
+TEST(BrightnessWatcherTest, StopReturnsWithoutWaitingForTheInterval)
+{
+    BrightnessWatcher watcher;
+    watcher.Start(nullptr, nullptr, std::chrono::hours(1));
+
+    auto start = std::chrono::steady_clock::now();
+    watcher.Stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+// ============================================================================
+// Hardware Executor Tests
+// ============================================================================
+
+TEST(HardwareExecutorTest, CommandsOfOneLaneRunOnOneThread)
+{
+    HardwareExecutor executor;
+    std::thread::id first;
+    std::thread::id second;
+
+    executor.Run("bus", [&]()
+                 { first = std::this_thread::get_id(); });
+    executor.Run("bus", [&]()
+                 { second = std::this_thread::get_id(); });
+
+    EXPECT_NE(first, std::this_thread::get_id());
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(executor.GetLaneCount(), 1u);
+}
+
+TEST(HardwareExecutorTest, LanesRunConcurrently)
+{
+    HardwareExecutor executor;
+    std::vector<std::thread> callers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; i++)
+    {
+        callers.emplace_back([&executor, i]()
+                             { executor.Run("bus" + std::to_string(i), []()
+                                            { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }); });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(180));
+    EXPECT_EQ(executor.GetLaneCount(), 4u);
+}
+
+TEST(HardwareExecutorTest, OneLaneSerializesCallers)
+{
+    HardwareExecutor executor;
+    std::atomic<int> active(0);
+    std::atomic<int> maxActive(0);
+    std::vector<std::thread> callers;
+
+    for (int i = 0; i < 8; i++)
+    {
+        callers.emplace_back([&]()
+                             { executor.Run("wmi", [&]()
+                                            {
+                int now = ++active;
+                int seen = maxActive;
+                while (now > seen && !maxActive.compare_exchange_weak(seen, now))
+                {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                --active; }); });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+
+    EXPECT_EQ(maxActive, 1);
+}
+
+TEST(HardwareExecutorTest, NestedCommandRunsInline)
+{
+    HardwareExecutor executor;
+    bool inner = false;
+
+    executor.Run("bus", [&]()
+                 {
+        EXPECT_TRUE(executor.IsLaneThread("bus"));
+        executor.Run("bus", [&]()
+                     { inner = true; }); });
+
+    EXPECT_TRUE(inner);
+    EXPECT_FALSE(executor.IsLaneThread("bus"));
+}
+
+TEST(HardwareExecutorTest, ExceptionReachesTheCaller)
+{
+    HardwareExecutor executor;
+
+    EXPECT_THROW(executor.Run("bus", []()
+                              { throw std::runtime_error("bus error"); }),
+                 std::runtime_error);
+
+    // The lane survives the failed command
+    bool ran = false;
+    executor.Run("bus", [&]()
+                 { ran = true; });
+    EXPECT_TRUE(ran);
+}
+
+TEST(HardwareExecutorTest, ShutdownRejectsLaterCommands)
+{
+    HardwareExecutor executor;
+    EXPECT_TRUE(executor.Run("bus", []() {}));
+    executor.Shutdown();
+    EXPECT_EQ(executor.GetLaneCount(), 0u);
+
+    // Never run on the calling thread instead of the lane
+    bool ran = false;
+    EXPECT_FALSE(executor.Run("bus", [&]()
+                              { ran = true; }));
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(executor.GetLaneCount(), 0u);
+}
+
+TEST(HardwareExecutorTest, StopLaneJoinsOnlyThatLane)
+{
+    HardwareExecutor executor;
+    std::thread::id after;
+
+    executor.Run("ddc:gone", []() {});
+    executor.Run("ddc:kept", []() {});
+    executor.StopLane("ddc:gone");
+    EXPECT_EQ(executor.GetLaneCount(), 1u);
+
+    // A monitor that comes back gets a new lane thread
+    executor.Run("ddc:gone", [&]()
+                 { after = std::this_thread::get_id(); });
+    EXPECT_NE(after, std::this_thread::get_id());
+    EXPECT_EQ(executor.GetLaneCount(), 2u);
+}
+
+TEST(HardwareExecutorTest, StopLaneIsIgnoredOnItsOwnThread)
+{
+    HardwareExecutor executor;
+
+    executor.Run("bus", [&]()
+                 { executor.StopLane("bus"); });
+
+    EXPECT_EQ(executor.GetLaneCount(), 1u);
+}
+
+// ============================================================================
+// Circuit Breaker Tests
+// ============================================================================
+
+TEST(CircuitBreakerTest, OpensAfterConsecutiveFailures)
+{
+    CircuitBreaker breaker(3, 20, 100);
+
+    breaker.Complete(false);
+    breaker.Complete(false);
+    EXPECT_TRUE(breaker.Allow());
+
+    // A success in between starts the count again
+    breaker.Complete(true);
+    EXPECT_FALSE(breaker.Complete(false));
+    EXPECT_FALSE(breaker.Complete(false));
+    EXPECT_TRUE(breaker.Complete(false));
+
+    EXPECT_TRUE(breaker.IsOpen());
+    EXPECT_FALSE(breaker.Allow());
+    EXPECT_EQ(breaker.GetConsecutiveFailures(), 3);
+    EXPECT_EQ(breaker.GetBackoffMs(), 20);
+}
+
+TEST(CircuitBreakerTest, ProbeIsDueAfterBackoffAndDoublesOnFailure)
+{
+    CircuitBreaker breaker(1, 20, 50);
+    breaker.Complete(false);
+    EXPECT_FALSE(breaker.IsProbeDue());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    EXPECT_TRUE(breaker.IsProbeDue());
+
+    // Failed probes back off exponentially up to the ceiling
+    breaker.Complete(false);
+    EXPECT_FALSE(breaker.IsProbeDue());
+    EXPECT_EQ(breaker.GetBackoffMs(), 40);
+    breaker.Complete(false);
+    EXPECT_EQ(breaker.GetBackoffMs(), 50);
+    EXPECT_TRUE(breaker.IsOpen());
+}
+
+TEST(CircuitBreakerTest, SuccessClosesAndResets)
+{
+    CircuitBreaker breaker(1, 20, 50);
+    breaker.Complete(false);
+
+    EXPECT_TRUE(breaker.Complete(true));
+    EXPECT_TRUE(breaker.Allow());
+    EXPECT_FALSE(breaker.IsProbeDue());
+    EXPECT_EQ(breaker.GetConsecutiveFailures(), 0);
+    EXPECT_EQ(breaker.GetBackoffMs(), 0);
+}
+
+TEST(CircuitBreakerTest, DeadMonitorFailsFast)
+{
+    MockMonitor monitor("dead", "Dead", "external", 50);
+    MockTiming timing;
+    timing.writeLatencyUs = 50000;
+    timing.failureRate = 1;
+    monitor.SetTiming(timing);
+
+    for (int i = 0; i < CircuitBreaker::FAILURE_THRESHOLD; i++)
+    {
+        EXPECT_FALSE(monitor.SetBrightness(80));
+    }
+    EXPECT_FALSE(monitor.IsResponding());
+
+    // No simulated bus timeout while the breaker is open
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(monitor.SetBrightness(80));
+    EXPECT_EQ(monitor.GetBrightness(), 50);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    // The backoff has not passed: the health check does not touch it either
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(monitor.CheckHealth());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(CircuitBreakerTest, HealthWatcherBringsMonitorBack)
+{
+    auto monitor = std::make_shared<MockMonitor>("kvm", "Kvm", "external", 50);
+    MockTiming timing;
+    timing.failureRate = 1;
+    monitor->SetTiming(timing);
+    for (int i = 0; i < CircuitBreaker::FAILURE_THRESHOLD; i++)
+    {
+        monitor->SetBrightness(80);
+    }
+    ASSERT_FALSE(monitor->IsResponding());
+
+    // Switched back to this input
+    monitor->SimulateExternalChange(30);
+    monitor->SetTiming(MockTiming());
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> recovered;
+
+    HealthWatcher watcher;
+    watcher.Start([&]()
+                  { return std::vector<std::shared_ptr<IMonitor>>{monitor}; },
+                  [&](const std::shared_ptr<IMonitor> &m)
+                  {
+        std::lock_guard<std::mutex> lock(mutex);
+        recovered.push_back(m->GetId());
+        cv.notify_all(); },
+                  std::chrono::milliseconds(20));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]
+                                { return !recovered.empty(); }));
+    }
+    watcher.Stop();
+
+    EXPECT_EQ(recovered[0], "kvm");
+    EXPECT_TRUE(monitor->IsResponding());
+    EXPECT_EQ(monitor->GetLastKnownBrightness(), 30);
+    EXPECT_TRUE(monitor->SetBrightness(60));
+}
+
+// ============================================================================
+// Request Tracing Tests
+// ============================================================================
+
+/**
+ * Turns tracing on for one test and leaves it off and empty afterwards
+ */
+class TraceRecorderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        TraceRecorder::SetEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        TraceRecorder::SetEnabled(false);
+        TraceRecorder::Drain();
+    }
+
+    /**
+     * Take the recorded events with the given name
+     */
+    static std::vector<TraceEvent> DrainNamed(const std::string &name)
+    {
+        std::vector<TraceEvent> named;
+        for (const TraceEvent &event : TraceRecorder::Drain())
+        {
+            if (name == event.name)
+            {
+                named.push_back(event);
+            }
+        }
+        return named;
+    }
+};
+
+TEST_F(TraceRecorderTest, DisabledRecordsNothing)
+{
+    TraceRecorder::SetEnabled(false);
+    {
+        TraceRequestScope request(1);
+        TraceSpan span("stage", "native");
+    }
+
+    EXPECT_TRUE(TraceRecorder::Drain().empty());
+}
+
+TEST_F(TraceRecorderTest, SpanBelongsToTheCurrentRequest)
+{
+    {
+        TraceRequestScope request(42);
+        TraceSpan span("stage", "native", "monitor_a");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(TraceRecorder::GetCurrentRequest(), 0u);
+
+    std::vector<TraceEvent> events = DrainNamed("stage");
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].requestId, 42u);
+    EXPECT_STREQ(events[0].category, "native");
+    EXPECT_EQ(events[0].monitorId, "monitor_a");
+    EXPECT_GE(events[0].durationUs, 2000);
+    EXPECT_LE(events[0].startUs + events[0].durationUs, TraceRecorder::NowUs());
+}
+
+TEST_F(TraceRecorderTest, RequestFollowsCommandToItsLane)
+{
+    HardwareExecutor executor;
+    uint64_t seen = 0;
+
+    {
+        TraceRequestScope request(7);
+        executor.Run("traced", [&]()
+                     {
+            seen = TraceRecorder::GetCurrentRequest();
+            TraceSpan span("hardware write", "mock"); });
+    }
+    EXPECT_EQ(seen, 7u);
+
+    std::vector<TraceEvent> events = TraceRecorder::Drain();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_STREQ(events[0].name, "lane wait");
+    EXPECT_STREQ(events[1].name, "hardware write");
+    EXPECT_EQ(events[0].requestId, 7u);
+    EXPECT_EQ(events[1].requestId, 7u);
+    EXPECT_EQ(events[0].threadId, events[1].threadId);
+
+    std::vector<TraceThread> threads = TraceRecorder::GetThreads();
+    EXPECT_TRUE(std::any_of(threads.begin(), threads.end(), [&](const TraceThread &thread)
+                            { return thread.id == events[1].threadId && thread.name == "lane traced"; }));
+}
+
+TEST_F(TraceRecorderTest, BatchThreadsContinueTheRequest)
+{
+    std::vector<BatchItem> items;
+    for (int i = 0; i < 3; i++)
+    {
+        BatchItem item;
+        item.id = "bus" + std::to_string(i);
+        item.monitor = std::make_shared<MockMonitor>(item.id, "External " + std::to_string(i), "external", 10);
+        item.value = 60;
+        items.push_back(item);
+    }
+
+    {
+        TraceRequestScope request(11);
+        ExecuteBrightnessBatch(items, BrightnessWriter());
+    }
+
+    std::vector<TraceEvent> writes = DrainNamed("hardware write");
+    ASSERT_EQ(writes.size(), 3u);
+    for (const TraceEvent &write : writes)
+    {
+        EXPECT_EQ(write.requestId, 11u);
+    }
+}
+
+TEST_F(TraceRecorderTest, AnimatorStepsBelongToTheRequestThatSetTheTarget)
+{
+    auto monitor = std::make_shared<MockMonitor>("fast", "Fast", "internal", 50);
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+
+    BrightnessAnimator animator([&](const std::string &)
+                                { return monitor; },
+                                [&](const AnimationResult &)
+                                {
+                                    std::lock_guard<std::mutex> lock(mutex);
+                                    done = true;
+                                    cv.notify_one();
+                                });
+
+    {
+        TraceRequestScope request(9);
+        animator.SetTarget("fast", 60, 50);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]
+                                { return done; }));
+    }
+    animator.Stop();
+
+    std::vector<TraceEvent> events = TraceRecorder::Drain();
+    size_t writes = 0;
+    for (const TraceEvent &event : events)
+    {
+        EXPECT_EQ(event.requestId, 9u) << event.name;
+        writes += std::string(event.name) == "hardware write" ? 1 : 0;
+    }
+    EXPECT_GT(writes, 0u);
+    EXPECT_TRUE(std::any_of(events.begin(), events.end(), [](const TraceEvent &event)
+                            { return std::string(event.name) == "animator wait"; }));
+}
+
+TEST_F(TraceRecorderTest, FullBufferDropsAndCounts)
+{
+    const size_t capacity = TraceRecorder::CAPACITY;
+    int64_t now = TraceRecorder::NowUs();
+    for (size_t i = 0; i < capacity + 5; i++)
+    {
+        TraceRecorder::Record("stage", "native", now, now);
+    }
+
+    EXPECT_EQ(TraceRecorder::GetDroppedCount(), 5u);
+    EXPECT_EQ(TraceRecorder::Drain().size(), capacity);
+
+    // Enabling again starts a new session
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::SetEnabled(true);
+    EXPECT_EQ(TraceRecorder::GetDroppedCount(), 0u);
+}
+
+// ============================================================================
+// Shared State Segment Tests
+// ============================================================================
+
+/**
+ * Read a segment of this process
+ */
+static SharedState ReadSegment(const StateSegment &segment)
+{
+    StateSegmentReader reader;
+    reader.Attach(segment.GetWords());
+
+    SharedState state;
+    EXPECT_TRUE(reader.Read(state));
+    return state;
+}
+
+TEST(StateSegmentTest, PublishesMonitorTable)
+{
+    StateSegment segment;
+    ASSERT_TRUE(segment.Create(STATE_SEGMENT_NAME));
+
+    std::vector<std::shared_ptr<IMonitor>> monitors = {
+        std::make_shared<MockMonitor>("panel", "Laptop Panel", "internal", 40),
+        std::make_shared<MockMonitor>("external", "External", "external", 75)};
+    segment.Publish(monitors);
+
+    SharedState state = ReadSegment(segment);
+    ASSERT_EQ(state.monitors.size(), 2u);
+    EXPECT_EQ(state.topologyVersion, 1u);
+
+    EXPECT_EQ(state.monitors[0].descriptor.id, "panel");
+    EXPECT_EQ(state.monitors[0].descriptor.name, "Laptop Panel");
+    EXPECT_EQ(state.monitors[0].descriptor.type, MonitorType::Internal);
+    EXPECT_EQ(state.monitors[0].descriptor.minBrightness, 0);
+    EXPECT_EQ(state.monitors[0].descriptor.maxBrightness, 100);
+    EXPECT_EQ(state.monitors[0].brightness, 40);
+    EXPECT_FALSE(state.monitors[0].probing);
+    EXPECT_TRUE(state.monitors[0].responding);
+
+    EXPECT_EQ(state.monitors[1].descriptor.type, MonitorType::External);
+    EXPECT_EQ(state.monitors[1].brightness, 75);
+}
+
+TEST(StateSegmentTest, UpdateChangesOneMonitor)
+{
+    StateSegment segment;
+    ASSERT_TRUE(segment.Create(STATE_SEGMENT_NAME));
+
+    auto panel = std::make_shared<MockMonitor>("panel", "Panel", "internal", 40);
+    auto external = std::make_shared<MockMonitor>("external", "External", "external", 75);
+    segment.Publish({panel, external});
+
+    segment.Update(*external, 20);
+    // A failed read keeps the last confirmed value
+    segment.Update(*panel, -1);
+    // Monitors outside the table are ignored
+    segment.Update(MockMonitor("other", "Other", "external", 10), 10);
+
+    SharedState state = ReadSegment(segment);
+    ASSERT_EQ(state.monitors.size(), 2u);
+    EXPECT_EQ(state.topologyVersion, 1u);
+    EXPECT_EQ(state.monitors[0].brightness, 40);
+    EXPECT_EQ(state.monitors[1].brightness, 20);
+}
+
+TEST(StateSegmentTest, CutsLongStringsAtCharacterBoundary)
+{
+    StateSegment segment;
+    ASSERT_TRUE(segment.Create(STATE_SEGMENT_NAME));
+
+    // 126 ASCII bytes and a two-byte character crossing the 127-byte limit
+    std::string name = std::string(126, 'n') + "\xC3\xA9";
+    segment.Publish({std::make_shared<MockMonitor>("id", name, "external")});
+
+    SharedState state = ReadSegment(segment);
+    ASSERT_EQ(state.monitors.size(), 1u);
+    EXPECT_EQ(state.monitors[0].descriptor.name, std::string(126, 'n'));
+}
+
+TEST(StateSegmentTest, KeepsFirstMonitorsOfLargeTopologies)
+{
+    StateSegment segment;
+    ASSERT_TRUE(segment.Create(STATE_SEGMENT_NAME));
+
+    const size_t maxMonitors = StateSegmentLayout::MAX_MONITORS;
+    std::vector<std::shared_ptr<IMonitor>> monitors;
+    for (size_t i = 0; i < maxMonitors + 2; i++)
+    {
+        monitors.push_back(std::make_shared<MockMonitor>("m" + std::to_string(i), "M", "external"));
+    }
+    segment.Publish(monitors);
+    segment.Update(*monitors.back(), 10);
+
+    SharedState state = ReadSegment(segment);
+    ASSERT_EQ(state.monitors.size(), maxMonitors);
+    EXPECT_EQ(state.monitors.back().descriptor.id, "m" + std::to_string(maxMonitors - 1));
+}
+
+TEST(StateSegmentTest, UnpublishedSegmentCannotBeRead)
+{
+    StateSegmentReader reader;
+    SharedState state;
+    EXPECT_FALSE(reader.Read(state));
+
+    // Words without the magic (another program, another layout)
+    std::atomic<uint32_t> words[StateSegmentLayout::TOTAL_WORDS] = {};
+    reader.Attach(words);
+    EXPECT_FALSE(reader.Read(state));
+
+    StateSegment segment;
+    EXPECT_EQ(segment.GetWords(), nullptr);
+    segment.Publish({std::make_shared<MockMonitor>("id", "Name", "external")});
+    EXPECT_FALSE(segment.IsOpen());
+}
+
+TEST(StateSegmentTest, ReadersNeverSeeHalfWrittenTables)
+{
+    StateSegment segment;
+    ASSERT_TRUE(segment.Create(STATE_SEGMENT_NAME));
+
+    std::vector<std::shared_ptr<IMonitor>> three = {
+        std::make_shared<MockMonitor>("a", "A", "internal", 10),
+        std::make_shared<MockMonitor>("b", "B", "external", 20),
+        std::make_shared<MockMonitor>("c", "C", "external", 30)};
+    std::vector<std::shared_ptr<IMonitor>> one = {
+        std::make_shared<MockMonitor>("only", "Only Monitor", "external", 90)};
+    segment.Publish(three);
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]()
+                       {
+        for (int i = 0; i < 2000; i++)
+        {
+            segment.Publish(i % 2 == 0 ? one : three);
+        }
+        done = true; });
+
+    StateSegmentReader reader;
+    reader.Attach(segment.GetWords());
+    int reads = 0;
+    while (!done || reads == 0)
+    {
+        SharedState state;
+        if (!reader.Read(state))
+        {
+            continue;
+        }
+        reads++;
+
+        // Every copy is one of the two tables, never a mix
+        if (state.monitors.size() == 1)
+        {
+            EXPECT_EQ(state.monitors[0].descriptor.id, "only");
+            EXPECT_EQ(state.monitors[0].descriptor.name, "Only Monitor");
+            EXPECT_EQ(state.monitors[0].brightness, 90);
+        }
+        else if (state.monitors.size() == 3)
+        {
+            EXPECT_EQ(state.monitors[0].descriptor.id, "a");
+            EXPECT_EQ(state.monitors[1].descriptor.name, "B");
+            EXPECT_EQ(state.monitors[2].brightness, 30);
+        }
+        else
+        {
+            ADD_FAILURE() << "Read a table of " << state.monitors.size() << " monitors";
+        }
+    }
+    writer.join();
+
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(ReadSegment(segment).topologyVersion, 2001u);
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+/**
+ * Factory that never reuses: every build creates new monitor objects
+ */
+static std::vector<std::shared_ptr<IMonitor>> CreateFreshMonitors(const std::vector<std::shared_ptr<IMonitor>> &)
+{
+    return {std::make_shared<MockMonitor>("a", "A", "internal", 50),
+            std::make_shared<MockMonitor>("b", "B", "external", 50)};
+}
+
+TEST(ConcurrencyTest, HeldSnapshotSurvivesRebuild)
+{
+    MonitorCache cache(CreateFreshMonitors);
+    MonitorCache::SnapshotPtr held = cache.GetSnapshot();
+    std::weak_ptr<IMonitor> old = held->Find("a");
+
+    cache.Invalidate();
+    MonitorCache::SnapshotPtr current = cache.GetSnapshot();
+
+    // The old snapshot is unchanged and keeps its monitors alive
+    EXPECT_NE(held, current);
+    EXPECT_EQ(held->monitors.size(), 2u);
+    EXPECT_NE(held->Find("a"), current->Find("a"));
+    EXPECT_TRUE(held->Find("a")->SetBrightness(30));
+
+    held.reset();
+    EXPECT_TRUE(old.expired());
+}
+
+TEST(ConcurrencyTest, TryGetSnapshotDoesNotWaitForARebuild)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool building = false;
+    bool release = false;
+
+    MonitorCache cache([&](const std::vector<std::shared_ptr<IMonitor>> &existing)
+                       {
+        std::unique_lock<std::mutex> lock(mutex);
+        building = true;
+        cv.notify_all();
+        cv.wait(lock, [&]()
+                { return release; });
+        return CreateFreshMonitors(existing); });
+
+    std::thread builder([&]()
+                        { cache.GetSnapshot(); });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]()
+                { return building; });
+    }
+
+    EXPECT_EQ(cache.TryGetSnapshot(), nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    builder.join();
+
+    ASSERT_NE(cache.TryGetSnapshot(), nullptr);
+    EXPECT_EQ(cache.TryGetSnapshot()->monitors.size(), 2u);
+}
+
+TEST(ConcurrencyTest, ReadersRaceRebuilds)
+{
+    MonitorCache cache(CreateFreshMonitors);
+    std::atomic<bool> stop(false);
+    std::atomic<int> reads(0);
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < 4; t++)
+    {
+        readers.emplace_back([&, t]()
+                             {
+            while (!stop)
+            {
+                MonitorCache::SnapshotPtr snapshot = (t % 2) ? cache.GetSnapshot() : cache.TryGetSnapshot();
+                if (!snapshot)
+                {
+                    continue;
+                }
+
+                // The index always matches the list it was published with
+                for (const auto &monitor : snapshot->monitors)
+                {
+                    EXPECT_EQ(snapshot->Find(monitor->GetId()), monitor);
+                    monitor->SetBrightness(monitor->GetBrightness() % 100 + 1);
+                }
+                reads++;
+            } });
+    }
+
+    // Keep rebuilding until the readers have done real work, however late
+    // the scheduler starts them
+    const int minReads = 200;
+    for (int i = 0; i < 200 || reads < minReads; i++)
+    {
+        if (i % 50 == 0)
+        {
+            cache.Clear();
+        }
+        cache.Invalidate();
+        EXPECT_EQ(cache.GetMonitors().size(), 2u);
+    }
+
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_GE(reads, minReads);
+}
+
+TEST(ConcurrencyTest, BrightnessCacheRacesStoresAndRecreation)
+{
+    BrightnessCache brightness(std::chrono::milliseconds(1000));
+    std::shared_ptr<IMonitor> first = std::make_shared<MockMonitor>("same", "Same", "external", 50);
+    std::shared_ptr<IMonitor> second = std::make_shared<MockMonitor>("same", "Same", "external", 50);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        std::shared_ptr<IMonitor> monitor = (t % 2) ? first : second;
+        int base = (t % 2) ? 0 : 50;
+        threads.emplace_back([&, monitor, base, t]()
+                             {
+            for (int i = 0; !stop; i++)
+            {
+                if (t < 2)
+                {
+                    brightness.Store(monitor, base + i % 50);
+                }
+                else
+                {
+                    // Never the value of the other instance with the same ID
+                    int value = -1;
+                    if (brightness.Lookup(monitor, value))
+                    {
+                        EXPECT_GE(value, base);
+                        EXPECT_LT(value, base + 50);
+                    }
+                    if (i % 100 == 0)
+                    {
+                        brightness.Invalidate(monitor);
+                    }
+                }
+            } });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop = true;
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(ConcurrencyTest, MockMonitorStateIsAtomic)
+{
+    MockMonitor monitor("atomic", "Atomic", "external", 50);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&monitor, t]()
+                             {
+            for (int i = 0; i < 1000; i++)
+            {
+                if (t % 2)
+                {
+                    monitor.SetBrightness(i % 2 ? 20 : 80);
+                }
+                else
+                {
+                    int value = monitor.GetBrightness();
+                    EXPECT_TRUE(value == 50 || value == 20 || value == 80);
+                }
+            } });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
 // ============================================================================
 // Main Entry Point
 // ============================================================================
@@ -0,0 +1,173 @@
+/**
+ * BrightSync - Request Tracing Implementation
+ */
+
+#include "trace_recorder.h"
+#include <map>
+#include <mutex>
+#include <chrono>
+
+std::atomic<bool> g_traceEnabled(false);
+
+// Recorded events and thread names
+static std::mutex g_traceMutex;
+static std::vector<TraceEvent> g_traceEvents;
+static std::map<uint32_t, std::string> g_traceThreads;
+static std::atomic<uint64_t> g_traceDropped(0);
+
+// Source of thread numbers; 0 means "not assigned yet"
+static std::atomic<uint32_t> g_nextThreadId(0);
+
+static thread_local uint64_t t_currentRequest = 0;
+static thread_local uint32_t t_threadId = 0;
+
+/**
+ * Number of the calling thread, assigned on first use
+ */
+static uint32_t GetThreadId()
+{
+    if (t_threadId == 0)
+    {
+        t_threadId = ++g_nextThreadId;
+    }
+    return t_threadId;
+}
+
+// ============================================================================
+// TraceRecorder
+// ============================================================================
+
+void TraceRecorder::SetEnabled(bool enabled)
+{
+    if (enabled && !g_traceEnabled.load())
+    {
+        std::lock_guard<std::mutex> lock(g_traceMutex);
+        g_traceEvents.clear();
+        g_traceDropped = 0;
+    }
+
+    g_traceEnabled = enabled;
+}
+
+int64_t TraceRecorder::NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t TraceRecorder::GetCurrentRequest()
+{
+    return t_currentRequest;
+}
+
+void TraceRecorder::SetCurrentRequest(uint64_t requestId)
+{
+    t_currentRequest = requestId;
+}
+
+void TraceRecorder::Resume(const TraceHandoff &handoff, const char *waitName, const char *category)
+{
+    t_currentRequest = handoff.requestId;
+    if (handoff.sentUs != 0)
+    {
+        Record(waitName, category, handoff.sentUs, NowUs());
+    }
+}
+
+void TraceRecorder::NameThread(const std::string &name)
+{
+    uint32_t id = GetThreadId();
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    g_traceThreads[id] = name;
+}
+
+void TraceRecorder::Record(const char *name, const char *category, int64_t startUs, int64_t endUs,
+                           const std::string &monitorId)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    TraceEvent event = {name, category, t_currentRequest, startUs,
+                        endUs > startUs ? endUs - startUs : 0, GetThreadId(), monitorId};
+
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    if (g_traceEvents.size() >= CAPACITY)
+    {
+        g_traceDropped++;
+        return;
+    }
+    g_traceEvents.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> TraceRecorder::Drain()
+{
+    std::vector<TraceEvent> events;
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    events.swap(g_traceEvents);
+    return events;
+}
+
+std::vector<TraceThread> TraceRecorder::GetThreads()
+{
+    std::vector<TraceThread> threads;
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+    for (const auto &entry : g_traceThreads)
+    {
+        threads.push_back({entry.first, entry.second});
+    }
+    return threads;
+}
+
+uint64_t TraceRecorder::GetDroppedCount()
+{
+    return g_traceDropped.load();
+}
+
+// ============================================================================
+// Scopes
+// ============================================================================
+
+TraceHandoff::TraceHandoff()
+    : requestId(t_currentRequest),
+      sentUs(TraceRecorder::IsEnabled() ? TraceRecorder::NowUs() : 0)
+{
+}
+
+TraceRequestScope::TraceRequestScope(uint64_t requestId)
+    : m_previous(t_currentRequest)
+{
+    t_currentRequest = requestId;
+}
+
+TraceRequestScope::TraceRequestScope(const TraceHandoff &handoff, const char *waitName, const char *category)
+    : m_previous(t_currentRequest)
+{
+    TraceRecorder::Resume(handoff, waitName, category);
+}
+
+TraceRequestScope::~TraceRequestScope()
+{
+    t_currentRequest = m_previous;
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category, const std::string &monitorId)
+    : m_name(name),
+      m_category(category),
+      m_startUs(TraceRecorder::IsEnabled() ? TraceRecorder::NowUs() : 0)
+{
+    if (m_startUs != 0)
+    {
+        m_monitorId = monitorId;
+    }
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (m_startUs != 0)
+    {
+        TraceRecorder::Record(m_name, m_category, m_startUs, TraceRecorder::NowUs(), m_monitorId);
+    }
+}
@@ -0,0 +1,186 @@
+/**
+ * BrightSync - Request Tracing
+ *
+ * Opt-in per-stage timestamps of brightness requests
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * One finished stage
+ */
+struct TraceEvent
+{
+    const char *name;      // stage, e.g. "lane wait" (string literal)
+    const char *category;  // "napi", "queue", "native", or the backend: "wmi", "ddc", "mock"
+    uint64_t requestId;    // request the stage belongs to, 0 for none
+    int64_t startUs;       // TraceRecorder::NowUs() at the start
+    int64_t durationUs;
+    uint32_t threadId;     // small per-thread number (see GetThreads)
+    std::string monitorId; // empty if the stage is not about one monitor
+};
+
+/**
+ * Name of a thread that recorded events
+ */
+struct TraceThread
+{
+    uint32_t id;
+    std::string name;
+};
+
+struct TraceHandoff;
+
+// Runtime switch; read inline by TraceRecorder::IsEnabled()
+extern std::atomic<bool> g_traceEnabled;
+
+/**
+ * Process-wide recorder of request stages
+ *
+ * A request ID from JavaScript rides along as the calling thread's current
+ * request; TraceHandoff and TraceRequestScope carry it to the thread that
+ * continues the work (libuv pool, hardware lane, batch thread, animator
+ * track) and record how long the work waited there. TraceSpan timestamps a
+ * stage with the monotonic microsecond clock that JavaScript also reads
+ * through traceNow(), so both sides land on one timeline.
+ *
+ * While tracing is off every helper costs one relaxed load. Events go into
+ * a bounded buffer (dropped when it is full) until Drain() takes them.
+ * All methods are thread-safe.
+ */
+class TraceRecorder
+{
+public:
+    static const size_t CAPACITY = 100000;
+
+    /**
+     * Check whether tracing is on
+     */
+    static bool IsEnabled()
+    {
+        return g_traceEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Turn tracing on or off
+     * Turning it on discards events and drop counts of an earlier session.
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * Monotonic clock in microseconds
+     */
+    static int64_t NowUs();
+
+    /**
+     * Request the calling thread currently works for (0 for none)
+     */
+    static uint64_t GetCurrentRequest();
+
+    /**
+     * Set the calling thread's current request
+     */
+    static void SetCurrentRequest(uint64_t requestId);
+
+    /**
+     * Make a handed-off request current and record its wait on this thread
+     * (see TraceHandoff)
+     * @param waitName Stage recorded from the handoff until now
+     */
+    static void Resume(const TraceHandoff &handoff, const char *waitName, const char *category);
+
+    /**
+     * Name the calling thread in the trace (e.g. its lane)
+     */
+    static void NameThread(const std::string &name);
+
+    /**
+     * Record a stage of the calling thread's current request
+     * @param startUs Start time from NowUs()
+     * @param endUs End time from NowUs()
+     * @param monitorId Monitor the stage is about, or empty
+     */
+    static void Record(const char *name, const char *category, int64_t startUs, int64_t endUs,
+                       const std::string &monitorId = std::string());
+
+    /**
+     * Take all recorded events
+     */
+    static std::vector<TraceEvent> Drain();
+
+    /**
+     * Threads named so far
+     */
+    static std::vector<TraceThread> GetThreads();
+
+    /**
+     * Number of events dropped because the buffer was full
+     */
+    static uint64_t GetDroppedCount();
+};
+
+/**
+ * The current request and the time it was handed to another thread
+ * Construct on the sending thread, before queueing the work.
+ */
+struct TraceHandoff
+{
+    TraceHandoff();
+
+    uint64_t requestId;
+    int64_t sentUs; // 0 while tracing is off
+};
+
+/**
+ * Makes a request current on this thread for the lifetime of the scope
+ */
+class TraceRequestScope
+{
+public:
+    explicit TraceRequestScope(uint64_t requestId);
+
+    /**
+     * Continue a handed-off request and record its wait on this thread
+     * @param waitName Stage recorded from the handoff until now
+     */
+    TraceRequestScope(const TraceHandoff &handoff, const char *waitName, const char *category);
+
+    /**
+     * Restore the previous request
+     */
+    ~TraceRequestScope();
+
+    TraceRequestScope(const TraceRequestScope &) = delete;
+    TraceRequestScope &operator=(const TraceRequestScope &) = delete;
+
+private:
+    uint64_t m_previous;
+};
+
+/**
+ * Records one stage of the current request, from construction to destruction
+ * Nothing is recorded if tracing was off at construction.
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char *name, const char *category, const std::string &monitorId = std::string());
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    std::string m_monitorId; // copied only while tracing
+    int64_t m_startUs;
+};
+
+#endif // TRACE_RECORDER_H
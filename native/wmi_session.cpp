@@ -0,0 +1,660 @@
+/**
+ * BrightSync - WMI Session
+ *
+ * Long-lived connection to ROOT\WMI for internal panel brightness control
+ */
+
+#include "wmi_session.h"
+#include "native_log.h"
+#include <atomic>
+#include <iomanip>
+
+#pragma comment(lib, "wbemuuid.lib")
+
+// ============================================================================
+// COM / Security Helpers
+// ============================================================================
+
+// Initialize COM security (process-wide, safe to call multiple times)
+static bool InitializeCOMSecurity()
+{
+    HRESULT hr = CoInitializeSecurity(
+        NULL,
+        -1,
+        NULL,
+        NULL,
+        RPC_C_AUTHN_LEVEL_DEFAULT,
+        RPC_C_IMP_LEVEL_IMPERSONATE,
+        NULL,
+        EOAC_NONE,
+        NULL);
+
+    // S_OK means success
+    // RPC_E_TOO_LATE means it was already initialized (also success)
+    if (SUCCEEDED(hr) || hr == RPC_E_TOO_LATE)
+    {
+        return true;
+    }
+
+    BS_LOG_ERROR("[WMI] ERROR: Failed to initialize COM security (HRESULT: 0x"
+                 << std::hex << hr << std::dec << ")");
+    return false;
+}
+
+/**
+ * Check if running with administrator privileges
+ */
+static bool IsRunningAsAdmin()
+{
+    BOOL isAdmin = FALSE;
+    PSID adminGroup = NULL;
+    SID_IDENTIFIER_AUTHORITY ntAuthority = SECURITY_NT_AUTHORITY;
+
+    if (AllocateAndInitializeSid(&ntAuthority, 2,
+                                 SECURITY_BUILTIN_DOMAIN_RID,
+                                 DOMAIN_ALIAS_RID_ADMINS,
+                                 0, 0, 0, 0, 0, 0, &adminGroup))
+    {
+        CheckTokenMembership(NULL, adminGroup, &isAdmin);
+        FreeSid(adminGroup);
+    }
+
+    return isAdmin != FALSE;
+}
+
+/**
+ * Check admin privileges once per process (token membership cannot change)
+ */
+static bool HasAdminPrivileges()
+{
+    static const bool isAdmin = []()
+    {
+        bool admin = IsRunningAsAdmin();
+        if (!admin)
+        {
+            BS_LOG_ERROR("[WMI] ERROR: Not running as Administrator!");
+            BS_LOG_ERROR("[WMI] Internal display brightness control requires admin privileges.");
+            BS_LOG_ERROR("[WMI] Please run the app as Administrator.");
+        }
+        return admin;
+    }();
+
+    return isAdmin;
+}
+
+/**
+ * Read a BSTR property of a WMI object
+ * @return Value, or an empty string if unavailable
+ */
+static std::wstring GetStringProperty(IWbemClassObject *object, const wchar_t *name)
+{
+    std::wstring value;
+
+    VARIANT vtProp;
+    VariantInit(&vtProp);
+    if (SUCCEEDED(object->Get(name, 0, &vtProp, NULL, NULL)) && vtProp.vt == VT_BSTR)
+    {
+        value = vtProp.bstrVal;
+    }
+    VariantClear(&vtProp);
+
+    return value;
+}
+
+/**
+ * Check the Active property of a WMI object (missing counts as active)
+ */
+static bool IsActiveInstance(IWbemClassObject *object)
+{
+    VARIANT vtActive;
+    VariantInit(&vtActive);
+    HRESULT hr = object->Get(L"Active", 0, &vtActive, NULL, NULL);
+    bool isActive = FAILED(hr) || vtActive.boolVal != 0;
+    VariantClear(&vtActive);
+
+    return isActive;
+}
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+WmiSession &WmiSession::ForCurrentThread()
+{
+    thread_local WmiSession session;
+    return session;
+}
+
+WmiSession::WmiSession()
+    : m_comInitialized(false),
+      m_comUsable(false),
+      m_pSvc(nullptr),
+      m_pInParams(nullptr),
+      m_pEvents(nullptr),
+      m_panelsValid(false)
+{
+    HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
+
+    // S_OK / S_FALSE: initialized by us (both need a matching CoUninitialize)
+    // RPC_E_CHANGED_MODE: already initialized with another model (still usable)
+    if (SUCCEEDED(hr))
+    {
+        m_comInitialized = true;
+        m_comUsable = true;
+    }
+    else if (hr == RPC_E_CHANGED_MODE)
+    {
+        m_comUsable = true;
+    }
+    else
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to initialize COM (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+    }
+}
+
+WmiSession::~WmiSession()
+{
+    Reset();
+
+    if (m_comInitialized)
+    {
+        CoUninitialize();
+    }
+}
+
+// ============================================================================
+// Session Management
+// ============================================================================
+
+void WmiSession::Reset()
+{
+    if (m_pEvents)
+    {
+        m_pEvents->Release();
+        m_pEvents = nullptr;
+    }
+
+    if (m_pInParams)
+    {
+        m_pInParams->Release();
+        m_pInParams = nullptr;
+    }
+
+    if (m_pSvc)
+    {
+        m_pSvc->Release();
+        m_pSvc = nullptr;
+    }
+
+    m_methodPaths.clear();
+    m_panelsValid = false;
+}
+
+bool WmiSession::EnsureConnected()
+{
+    if (m_pSvc)
+    {
+        return true;
+    }
+
+    if (!m_comUsable)
+    {
+        return false;
+    }
+
+    // Initialize COM security once per process
+    static std::atomic<bool> securityInitialized(false);
+    if (!securityInitialized)
+    {
+        if (!InitializeCOMSecurity())
+        {
+            return false;
+        }
+        securityInitialized = true;
+    }
+
+    if (!HasAdminPrivileges())
+    {
+        return false;
+    }
+
+    IWbemLocator *pLoc = nullptr;
+    HRESULT hr = CoCreateInstance(
+        CLSID_WbemLocator,
+        0,
+        CLSCTX_INPROC_SERVER,
+        IID_IWbemLocator,
+        (LPVOID *)&pLoc);
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to create WbemLocator (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        return false;
+    }
+
+    IWbemServices *pSvc = nullptr;
+    hr = pLoc->ConnectServer(
+        _bstr_t(L"ROOT\\WMI"),
+        NULL,
+        NULL,
+        0,
+        NULL,
+        0,
+        0,
+        &pSvc);
+
+    pLoc->Release();
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to connect to WMI (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        if (hr == 0x80041003)
+        {
+            BS_LOG_ERROR("[WMI] This error usually means access denied - run as Administrator!");
+        }
+        return false;
+    }
+
+    // Set security levels on proxy
+    hr = CoSetProxyBlanket(
+        pSvc,
+        RPC_C_AUTHN_WINNT,
+        RPC_C_AUTHZ_NONE,
+        NULL,
+        RPC_C_AUTHN_LEVEL_CALL,
+        RPC_C_IMP_LEVEL_IMPERSONATE,
+        NULL,
+        EOAC_NONE);
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to set proxy blanket (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        pSvc->Release();
+        return false;
+    }
+
+    m_pSvc = pSvc;
+    BS_LOG_INFO("[WMI] Connected to ROOT\\WMI");
+    return true;
+}
+
+bool WmiSession::EnsureMethodObject()
+{
+    if (m_pInParams && !m_methodPaths.empty())
+    {
+        return true;
+    }
+
+    if (!EnsureConnected())
+    {
+        return false;
+    }
+
+    // Find the method object of every active panel
+    IEnumWbemClassObject *pEnumerator = nullptr;
+    HRESULT hr = m_pSvc->ExecQuery(
+        bstr_t("WQL"),
+        bstr_t("SELECT InstanceName, Active FROM WmiMonitorBrightnessMethods"),
+        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+        NULL,
+        &pEnumerator);
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to query WmiMonitorBrightnessMethods (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    IWbemClassObject *pclsObj = nullptr;
+    ULONG uReturn = 0;
+
+    while (pEnumerator)
+    {
+        hr = pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn);
+
+        if (uReturn == 0)
+        {
+            break;
+        }
+
+        // Skip inactive instances
+        if (!IsActiveInstance(pclsObj))
+        {
+            pclsObj->Release();
+            continue;
+        }
+
+        std::wstring path = GetStringProperty(pclsObj, L"__PATH");
+        if (!path.empty())
+        {
+            m_methodPaths.emplace_back(GetStringProperty(pclsObj, L"InstanceName"), _bstr_t(path.c_str()));
+        }
+        else
+        {
+            BS_LOG_ERROR("[WMI] ERROR: Failed to get object path of a brightness method object");
+        }
+
+        pclsObj->Release();
+    }
+
+    pEnumerator->Release();
+
+    if (m_methodPaths.empty())
+    {
+        BS_LOG_ERROR("[WMI] ERROR: No active WmiMonitorBrightnessMethods instances found");
+        return false;
+    }
+
+    BS_LOG_INFO("[WMI] Found brightness method objects of " << m_methodPaths.size() << " panel(s)");
+
+    // Spawn the WmiSetBrightness in-params once; SetBrightness() puts the arguments
+    IWbemClassObject *pClass = nullptr;
+    hr = m_pSvc->GetObject(bstr_t("WmiMonitorBrightnessMethods"), 0, NULL, &pClass, NULL);
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to get method class (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    IWbemClassObject *pInParamsDefinition = nullptr;
+    hr = pClass->GetMethod(L"WmiSetBrightness", 0, &pInParamsDefinition, NULL);
+    pClass->Release();
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to get WmiSetBrightness method (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    IWbemClassObject *pInParams = nullptr;
+    hr = pInParamsDefinition->SpawnInstance(0, &pInParams);
+    pInParamsDefinition->Release();
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to spawn instance (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    m_pInParams = pInParams;
+    return true;
+}
+
+// ============================================================================
+// Brightness Operations
+// ============================================================================
+
+const _bstr_t *WmiSession::FindMethodPath(const std::wstring &instanceName) const
+{
+    if (instanceName.empty())
+    {
+        return m_methodPaths.empty() ? nullptr : &m_methodPaths.front().second;
+    }
+
+    for (const auto &entry : m_methodPaths)
+    {
+        if (_wcsicmp(entry.first.c_str(), instanceName.c_str()) == 0)
+        {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+bool WmiSession::QueryPanels(std::vector<WmiPanel> &panels)
+{
+    panels.clear();
+
+    if (!EnsureConnected())
+    {
+        return false;
+    }
+
+    IEnumWbemClassObject *pEnumerator = nullptr;
+    HRESULT hr = m_pSvc->ExecQuery(
+        bstr_t("WQL"),
+        bstr_t("SELECT InstanceName, CurrentBrightness, Active FROM WmiMonitorBrightness"),
+        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+        NULL,
+        &pEnumerator);
+
+    // Machines without a panel answer "not supported"; that is an answer too
+    if (hr == WBEM_E_NOT_SUPPORTED)
+    {
+        m_panels.clear();
+        m_panelsQueried = std::chrono::steady_clock::now();
+        m_panelsValid = true;
+        return true;
+    }
+
+    if (FAILED(hr))
+    {
+        Reset();
+        return false;
+    }
+
+    IWbemClassObject *pclsObj = nullptr;
+    ULONG uReturn = 0;
+
+    while (pEnumerator)
+    {
+        hr = pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn);
+
+        if (uReturn == 0)
+        {
+            break;
+        }
+
+        if (IsActiveInstance(pclsObj))
+        {
+            WmiPanel panel;
+            panel.instanceName = GetStringProperty(pclsObj, L"InstanceName");
+            panel.brightness = -1;
+
+            VARIANT vtProp;
+            VariantInit(&vtProp);
+            if (SUCCEEDED(pclsObj->Get(L"CurrentBrightness", 0, &vtProp, 0, 0)))
+            {
+                panel.brightness = vtProp.uiVal;
+            }
+            VariantClear(&vtProp);
+
+            panels.push_back(panel);
+        }
+
+        pclsObj->Release();
+    }
+
+    pEnumerator->Release();
+
+    bool success = hr == WBEM_S_FALSE || hr == WBEM_S_NO_ERROR || hr == WBEM_E_NOT_SUPPORTED;
+    m_panelsValid = success;
+    if (success)
+    {
+        m_panels = panels;
+        m_panelsQueried = std::chrono::steady_clock::now();
+    }
+    return success;
+}
+
+int WmiSession::GetBrightness(const std::wstring &instanceName)
+{
+    // The other panels of this refresh pass were read by the same query
+    if (!m_panelsValid ||
+        std::chrono::steady_clock::now() - m_panelsQueried > std::chrono::milliseconds(PANEL_QUERY_REUSE_MS))
+    {
+        std::vector<WmiPanel> panels;
+        if (!QueryPanels(panels))
+        {
+            return -1;
+        }
+    }
+
+    for (const auto &panel : m_panels)
+    {
+        if (instanceName.empty() || _wcsicmp(panel.instanceName.c_str(), instanceName.c_str()) == 0)
+        {
+            return panel.brightness;
+        }
+    }
+
+    return -1;
+}
+
+bool WmiSession::SetBrightness(int brightness, const std::wstring &instanceName, int timeoutSeconds)
+{
+    // Clamp brightness
+    if (brightness < 0)
+        brightness = 0;
+    if (brightness > 100)
+        brightness = 100;
+    if (timeoutSeconds < 1)
+        timeoutSeconds = 1;
+
+    // The panel changes; the next read asks WMI again
+    m_panelsValid = false;
+
+    if (!EnsureMethodObject())
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to get WMI service");
+        return false;
+    }
+
+    const _bstr_t *methodPath = FindMethodPath(instanceName);
+    if (!methodPath)
+    {
+        // The panel set may have changed; look the objects up again next time
+        BS_LOG_ERROR("[WMI] ERROR: No brightness method object for the requested panel");
+        Reset();
+        return false;
+    }
+
+    // Brightness parameter (VT_UI1)
+    VARIANT vtBrightness;
+    VariantInit(&vtBrightness);
+    vtBrightness.bVal = (BYTE)brightness;
+    vtBrightness.vt = VT_UI1;
+    HRESULT hr = m_pInParams->Put(L"Brightness", 0, &vtBrightness, 0);
+    VariantClear(&vtBrightness);
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to set Brightness parameter (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    // Timeout parameter (VT_I4 - the provider rejects VT_UI4)
+    VARIANT vtTimeout;
+    VariantInit(&vtTimeout);
+    vtTimeout.lVal = timeoutSeconds;
+    vtTimeout.vt = VT_I4;
+    hr = m_pInParams->Put(L"Timeout", 0, &vtTimeout, 0);
+    VariantClear(&vtTimeout);
+
+    if (FAILED(hr))
+    {
+        // The provider falls back to its default fade
+        BS_LOG_ERROR("[WMI] ERROR: Failed to set Timeout parameter (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+    }
+
+    IWbemClassObject *pOutParams = nullptr;
+    hr = m_pSvc->ExecMethod(
+        *methodPath,
+        bstr_t("WmiSetBrightness"),
+        0,
+        NULL,
+        m_pInParams,
+        &pOutParams,
+        NULL);
+
+    if (pOutParams)
+    {
+        pOutParams->Release();
+    }
+
+    if (FAILED(hr))
+    {
+        BS_LOG_ERROR("[WMI] ERROR: Failed to execute WmiSetBrightness (HRESULT: 0x"
+                     << std::hex << hr << std::dec << ")");
+        Reset();
+        return false;
+    }
+
+    return true;
+}
+
+int WmiSession::WaitForBrightnessEvent(WmiPanel &event, long timeoutMs)
+{
+    if (!m_pEvents)
+    {
+        if (!EnsureConnected())
+        {
+            return -1;
+        }
+
+        HRESULT hr = m_pSvc->ExecNotificationQuery(
+            bstr_t("WQL"),
+            bstr_t("SELECT * FROM WmiMonitorBrightnessEvent"),
+            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+            NULL,
+            &m_pEvents);
+
+        if (FAILED(hr))
+        {
+            BS_LOG_DEBUG("[WMI] Brightness event subscription failed (HRESULT: 0x"
+                         << std::hex << hr << std::dec << ")");
+            m_pEvents = nullptr;
+            Reset();
+            return -1;
+        }
+    }
+
+    IWbemClassObject *pEvent = nullptr;
+    ULONG uReturn = 0;
+    HRESULT hr = m_pEvents->Next(timeoutMs, 1, &pEvent, &uReturn);
+
+    if (hr == WBEM_S_TIMEDOUT || (SUCCEEDED(hr) && uReturn == 0))
+    {
+        return 0;
+    }
+
+    if (FAILED(hr))
+    {
+        Reset();
+        return -1;
+    }
+
+    // The OS changed a panel; the next read asks WMI again
+    m_panelsValid = false;
+
+    event.instanceName = GetStringProperty(pEvent, L"InstanceName");
+    event.brightness = -1;
+
+    VARIANT vtProp;
+    VariantInit(&vtProp);
+    if (SUCCEEDED(pEvent->Get(L"Brightness", 0, &vtProp, 0, 0)) && vtProp.vt == VT_UI1)
+    {
+        event.brightness = vtProp.bVal;
+    }
+    VariantClear(&vtProp);
+
+    pEvent->Release();
+
+    return 1;
+}
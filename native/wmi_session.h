@@ -0,0 +1,133 @@
+/**
+ * BrightSync - WMI Session
+ *
+ * Long-lived connection to ROOT\WMI for internal panel brightness control
+ */
+
+#ifndef WMI_SESSION_H
+#define WMI_SESSION_H
+
+#include <windows.h>
+#include <wbemidl.h>
+#include <comdef.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+
+/**
+ * One active internal panel as reported by WmiMonitorBrightness
+ */
+struct WmiPanel
+{
+    std::wstring instanceName; // e.g. DISPLAY\BOE0812\4&2d4b2c3&0&UID8388688_0
+    int brightness;            // 0-100, or -1 if unreadable
+};
+
+/**
+ * Cached WMI session for internal panel brightness
+ *
+ * COM interface pointers belong to the apartment of the thread that created
+ * them, so each thread gets its own session (see ForCurrentThread). The session
+ * connects once and keeps IWbemServices, the WmiMonitorBrightnessMethods object
+ * path of every panel and a spawned WmiSetBrightness in-params instance, so a
+ * write costs a single ExecMethod. Any failed call drops the cached objects and
+ * the next call reconnects.
+ *
+ * Panels are addressed by their InstanceName; an empty name means the first
+ * active panel. Reads are answered from the result of the last panel query
+ * if it is younger than PANEL_QUERY_REUSE_MS, so reading every panel of a
+ * refresh pass costs one WQL query; a write drops that result.
+ */
+class WmiSession
+{
+public:
+    static const int PANEL_QUERY_REUSE_MS = 100;
+
+    /**
+     * Get the session owned by the calling thread (created on first use)
+     */
+    static WmiSession &ForCurrentThread();
+
+    /**
+     * Destructor - releases COM objects and uninitializes COM if we initialized it
+     */
+    ~WmiSession();
+
+    WmiSession(const WmiSession &) = delete;
+    WmiSession &operator=(const WmiSession &) = delete;
+
+    /**
+     * Read every active panel and its brightness in one query
+     * @param panels Receives the panels (empty on machines without any)
+     * @return false if WMI could not be asked
+     */
+    bool QueryPanels(std::vector<WmiPanel> &panels);
+
+    /**
+     * Read brightness of an internal panel (see PANEL_QUERY_REUSE_MS)
+     * @param instanceName Panel to read (empty = first active panel)
+     * @return Brightness value (0-100) or -1 on error
+     */
+    int GetBrightness(const std::wstring &instanceName = std::wstring());
+
+    /**
+     * Set brightness of an internal panel
+     * @param brightness Brightness value (clamped to 0-100)
+     * @param instanceName Panel to write (empty = first active panel)
+     * @param timeoutSeconds WmiSetBrightness Timeout: the panel fades to the
+     *                       new value over this many seconds
+     * @return true on success, false on failure
+     */
+    bool SetBrightness(int brightness, const std::wstring &instanceName = std::wstring(), int timeoutSeconds = 1);
+
+    /**
+     * Wait for the next WmiMonitorBrightnessEvent (brightness changed by the OS)
+     * The event subscription is created on first use and kept with the session.
+     * @param event Receives the panel and its new brightness
+     * @param timeoutMs How long to wait for an event (0 takes only one that
+     *                  has already arrived)
+     * @return 1 if an event arrived, 0 on timeout, -1 on error
+     */
+    int WaitForBrightnessEvent(WmiPanel &event, long timeoutMs);
+
+    /**
+     * Release all cached WMI objects; the next call reconnects
+     */
+    void Reset();
+
+private:
+    WmiSession();
+
+    /**
+     * Connect to ROOT\WMI if not already connected
+     * @return true if m_pSvc is usable
+     */
+    bool EnsureConnected();
+
+    /**
+     * Resolve the method object paths and spawn reusable in-params
+     * @return true if m_methodPaths and m_pInParams are usable
+     */
+    bool EnsureMethodObject();
+
+    /**
+     * Find the method object path of a panel
+     * @return Path, or nullptr if the panel is unknown
+     */
+    const _bstr_t *FindMethodPath(const std::wstring &instanceName) const;
+
+    bool m_comInitialized; // CoInitializeEx succeeded and needs CoUninitialize
+    bool m_comUsable;      // COM is usable on this thread (ours or pre-existing)
+    IWbemServices *m_pSvc;
+    std::vector<std::pair<std::wstring, _bstr_t>> m_methodPaths; // by InstanceName
+    IWbemClassObject *m_pInParams;
+    IEnumWbemClassObject *m_pEvents; // brightness event subscription
+
+    // Result of the last successful QueryPanels, reused by GetBrightness
+    std::vector<WmiPanel> m_panels;
+    std::chrono::steady_clock::time_point m_panelsQueried;
+    bool m_panelsValid;
+};
+
+#endif // WMI_SESSION_H
@@ -0,0 +1,175 @@
+/**
+ * BrightSync - Brightness Write Queue Implementation
+ */
+
+#include "write_queue.h"
+#include <condition_variable>
+
+// ============================================================================
+// Queue State
+// ============================================================================
+
+/**
+ * A caller waiting behind the in-flight write
+ */
+struct WriteQueue::Request
+{
+    enum State
+    {
+        Queued,
+        Promoted, // the caller now owns the writer role
+        Dropped   // replaced by a newer value
+    };
+
+    explicit Request(int v) : value(v), state(Queued) {}
+
+    int value;
+    State state;
+};
+
+/**
+ * Per-monitor queue state, guarded by WriteQueue::m_mutex
+ */
+struct WriteQueue::Slot
+{
+    std::weak_ptr<IMonitor> monitor; // instance the confirmed value belongs to
+    bool writing = false;            // a write is in flight
+    std::shared_ptr<Request> pending; // at most one waiting value
+    int confirmed = -1;              // last value known to be on the hardware
+    std::chrono::steady_clock::time_point fadeEnd; // end of the last hardware fade
+    std::condition_variable cv;
+};
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+WriteOutcome WriteQueue::Write(const std::shared_ptr<IMonitor> &monitor, int value, int rampMs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::shared_ptr<Slot> slot = GetSlot(monitor);
+
+    if (slot->writing)
+    {
+        // Take the single waiting position, dropping whoever held it
+        if (slot->pending)
+        {
+            slot->pending->state = Request::Dropped;
+        }
+
+        std::shared_ptr<Request> request = std::make_shared<Request>(value);
+        slot->pending = request;
+        slot->cv.notify_all();
+
+        slot->cv.wait(lock, [&]
+                      { return request->state != Request::Queued; });
+        if (request->state == Request::Dropped)
+        {
+            return WriteOutcome::Superseded;
+        }
+    }
+    else
+    {
+        slot->writing = true;
+    }
+
+    // We own the writer role for this monitor
+    WriteOutcome outcome = WriteOutcome::Unchanged;
+    if (value != slot->confirmed)
+    {
+        lock.unlock();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool success = rampMs > 0 ? monitor->SetBrightnessRamped(value, rampMs)
+                                  : monitor->SetBrightness(value);
+        lock.lock();
+
+        // Any write ends a fade that was still running
+        bool fades = success && rampMs > 0 && monitor->GetHardwareRampResolutionMs() > 0;
+        slot->fadeEnd = fades ? start + std::chrono::milliseconds(rampMs)
+                              : std::chrono::steady_clock::time_point();
+        slot->confirmed = success ? value : -1;
+        outcome = success ? WriteOutcome::Written : WriteOutcome::Failed;
+    }
+
+    // Hand the writer role to the waiting caller, if any
+    if (slot->pending)
+    {
+        slot->pending->state = Request::Promoted;
+        slot->pending.reset();
+        slot->cv.notify_all();
+    }
+    else
+    {
+        slot->writing = false;
+    }
+
+    return outcome;
+}
+
+void WriteQueue::Observe(const std::shared_ptr<IMonitor> &monitor, int value)
+{
+    if (value < 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Slot> slot = GetSlot(monitor);
+
+    // An in-flight write will set the confirmed value itself
+    if (!slot->writing)
+    {
+        slot->confirmed = value;
+    }
+}
+
+bool WriteQueue::IsFading(const std::shared_ptr<IMonitor> &monitor) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_slots.find(monitor->GetId());
+    return it != m_slots.end() && it->second->monitor.lock() == monitor &&
+           std::chrono::steady_clock::now() < it->second->fadeEnd;
+}
+
+void WriteQueue::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &entry : m_slots)
+    {
+        entry.second->confirmed = -1;
+    }
+}
+
+size_t WriteQueue::GetDepth() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t depth = 0;
+    for (const auto &entry : m_slots)
+    {
+        depth += (entry.second->writing ? 1 : 0) + (entry.second->pending ? 1 : 0);
+    }
+    return depth;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+std::shared_ptr<WriteQueue::Slot> WriteQueue::GetSlot(const std::shared_ptr<IMonitor> &monitor)
+{
+    std::shared_ptr<Slot> &slot = m_slots[monitor->GetId()];
+    if (!slot)
+    {
+        slot = std::make_shared<Slot>();
+    }
+
+    // A re-created monitor with the same ID starts without a confirmed value
+    if (slot->monitor.lock() != monitor)
+    {
+        slot->monitor = monitor;
+        slot->confirmed = -1;
+    }
+
+    return slot;
+}
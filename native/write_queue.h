@@ -0,0 +1,101 @@
+/**
+ * BrightSync - Brightness Write Queue
+ *
+ * Per-monitor "latest value wins" coalescing of brightness writes
+ */
+
+#ifndef WRITE_QUEUE_H
+#define WRITE_QUEUE_H
+
+#include "monitor_interface.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+/**
+ * Function used to write brightness to a monitor
+ */
+typedef std::function<bool(const std::shared_ptr<IMonitor> &monitor, int value)> BrightnessWriter;
+
+/**
+ * Function used to write brightness as one hardware fade
+ */
+typedef std::function<bool(const std::shared_ptr<IMonitor> &monitor, int value, int durationMs)> BrightnessRampWriter;
+
+/**
+ * How a queued write was handled
+ */
+enum class WriteOutcome
+{
+    Written,    // value was sent to the hardware
+    Unchanged,  // value equals the last confirmed value; nothing sent
+    Superseded, // a newer value replaced this one before it was sent
+    Failed      // the hardware write failed
+};
+
+/**
+ * Depth-1 write queue per monitor
+ *
+ * At most one write per monitor is in flight and at most one waits behind
+ * it. A new value replaces the waiting one (whose caller returns Superseded
+ * straight away), so however fast input arrives - e.g. a slider drag - the
+ * final value is sent after at most one outstanding write. Values equal to
+ * the last confirmed brightness are not sent at all.
+ *
+ * Writes run on the calling thread. All methods are thread-safe.
+ */
+class WriteQueue
+{
+public:
+    /**
+     * Write brightness, coalescing with concurrent writes to the same monitor
+     * Blocks until the value is written, skipped or superseded
+     * @param monitor Target monitor
+     * @param value Brightness value
+     * @param rampMs Let the hardware fade over this time (see
+     *               IMonitor::SetBrightnessRamped), 0 for a plain write
+     * @return How the write was handled
+     */
+    WriteOutcome Write(const std::shared_ptr<IMonitor> &monitor, int value, int rampMs = 0);
+
+    /**
+     * Record a brightness value read from the hardware
+     * Keeps the confirmed value in sync with changes made outside BrightSync
+     * (monitor OSD buttons, Windows brightness slider)
+     */
+    void Observe(const std::shared_ptr<IMonitor> &monitor, int value);
+
+    /**
+     * Check whether a hardware fade sent through this queue may still be
+     * running on a monitor; its reads return values between the old and the
+     * new brightness until then
+     */
+    bool IsFading(const std::shared_ptr<IMonitor> &monitor) const;
+
+    /**
+     * Forget all confirmed values
+     */
+    void Clear();
+
+    /**
+     * Number of writes in flight or waiting, across all monitors
+     */
+    size_t GetDepth() const;
+
+private:
+    struct Request;
+    struct Slot;
+
+    /**
+     * Get the slot of a monitor (caller holds m_mutex)
+     */
+    std::shared_ptr<Slot> GetSlot(const std::shared_ptr<IMonitor> &monitor);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<Slot>> m_slots;
+};
+
+#endif // WRITE_QUEUE_H
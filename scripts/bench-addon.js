@@ -0,0 +1,120 @@
+/**
+ * Native Addon Benchmark
+ *
+ * Times the N-API surface of build/Release/brightness.node in mock mode,
+ * including marshalling of monitor objects, and reports ops/sec with
+ * p50 / p99 latency per call. Run after `npm run build:native`.
+ *
+ * Usage: node scripts/bench-addon.js [iterations]
+ */
+
+const path = require("path");
+
+const ITERATIONS = parseInt(process.argv[2], 10) || 20000;
+const ASYNC_ITERATIONS = Math.max(1, Math.floor(ITERATIONS / 10));
+
+let addon;
+try {
+  addon = require(
+    path.join(__dirname, "..", "build", "Release", "brightness.node"),
+  );
+} catch (error) {
+  console.error("Native addon not built; run `npm run build:native` first");
+  console.error(error.message);
+  process.exit(1);
+}
+
+/**
+ * Summarize per-call samples (milliseconds)
+ */
+function summarize(name, samples, totalMs) {
+  samples.sort((a, b) => a - b);
+  const at = (p) => samples[Math.floor((p / 100) * (samples.length - 1))];
+  return {
+    name,
+    calls: samples.length,
+    "ops/sec": Math.round((samples.length / totalMs) * 1000),
+    "p50 (us)": +(at(50) * 1000).toFixed(2),
+    "p99 (us)": +(at(99) * 1000).toFixed(2),
+  };
+}
+
+function benchSync(name, call, iterations = ITERATIONS) {
+  // Warm up caches and JIT before measuring
+  for (let i = 0; i < 100; i++) call(i);
+
+  const samples = new Array(iterations);
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) {
+    const t0 = process.hrtime.bigint();
+    call(i);
+    samples[i] = Number(process.hrtime.bigint() - t0) / 1e6;
+  }
+  const totalMs = Number(process.hrtime.bigint() - start) / 1e6;
+  return summarize(name, samples, totalMs);
+}
+
+async function benchAsync(name, call, iterations = ASYNC_ITERATIONS) {
+  for (let i = 0; i < 10; i++) await call(i);
+
+  const samples = new Array(iterations);
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) {
+    const t0 = process.hrtime.bigint();
+    await call(i);
+    samples[i] = Number(process.hrtime.bigint() - t0) / 1e6;
+  }
+  const totalMs = Number(process.hrtime.bigint() - start) / 1e6;
+  return summarize(name, samples, totalMs);
+}
+
+async function main() {
+  addon.initialize({ mockMode: true, logLevel: "warn" });
+
+  const monitors = addon.getMonitors();
+  const id = monitors[monitors.length - 1].id;
+  console.log(
+    `Benchmarking ${monitors.length} mock monitors, ${ITERATIONS} sync / ${ASYNC_ITERATIONS} async calls\n`,
+  );
+
+  const results = [
+    benchSync("getMonitors (cached)", () => addon.getMonitors()),
+    benchSync("getMonitors (forceRefresh)", () => addon.getMonitors(true)),
+    benchSync("getBrightness", () => addon.getBrightness(id)),
+    benchSync("setBrightness", (i) => addon.setBrightness(id, i % 101)),
+  ];
+
+  if (addon.getMonitorsAsync) {
+    results.push(
+      await benchAsync("getMonitorsAsync", () => addon.getMonitorsAsync()),
+    );
+  }
+  if (addon.setBrightnessBatch) {
+    results.push(
+      await benchAsync("setBrightnessBatch (all)", (i) =>
+        addon.setBrightnessBatch(
+          monitors.map((monitor) => ({ id: monitor.id, value: i % 101 })),
+        ),
+      ),
+    );
+  }
+  if (addon.getMonitorDescriptors && addon.readBrightnessSnapshot) {
+    const values = new Int32Array(monitors.length);
+    results.push(
+      benchSync("getMonitorDescriptors", () => addon.getMonitorDescriptors()),
+      benchSync("readBrightnessSnapshot", () =>
+        addon.readBrightnessSnapshot(values),
+      ),
+    );
+  }
+  if (addon.getStats) {
+    results.push(benchSync("getStats", () => addon.getStats()));
+  }
+
+  console.table(results);
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
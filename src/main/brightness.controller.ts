@@ -3,6 +3,7 @@
  */
 
 import { MonitorManager } from "./monitor.manager";
+import { traceService } from "./trace.service";
 import { Monitor } from "../shared/types";
 import { BRIGHTNESS_TRANSITION, BRIGHTNESS } from "../shared/constants";
 
@@ -47,6 +48,18 @@ export class BrightnessController {
   public async setMasterBrightness(
     targetValue: number,
     animated: boolean = true,
+  ): Promise<void> {
+    return traceService.span("BrightnessController.setMasterBrightness", () =>
+      this.applyMasterBrightness(targetValue, animated),
+    );
+  }
+
+  /**
+   * Body of setMasterBrightness (a stage of its own when tracing)
+   */
+  private async applyMasterBrightness(
+    targetValue: number,
+    animated: boolean,
   ): Promise<void> {
     if (!this.syncEnabled) {
       console.log("Sync disabled, skipping master brightness change");
@@ -63,7 +76,18 @@ export class BrightnessController {
       `Setting master brightness to ${clampedTarget} for ${monitors.length} monitors`,
     );
 
-    // Set brightness for all monitors in parallel
+    if (!animated) {
+      // Program all monitors in one native batch
+      await this.monitorManager.setBrightnessBatch(
+        monitors.map((monitor) => ({
+          id: monitor.id,
+          value: this.calculateProportionalBrightness(clampedTarget, monitor),
+        })),
+      );
+      return;
+    }
+
+    // Animate all monitors in parallel
     const promises = monitors.map(async (monitor) => {
       // Calculate target brightness for this monitor
       const target = this.calculateProportionalBrightness(
@@ -71,11 +95,7 @@ export class BrightnessController {
         monitor,
       );
 
-      if (animated) {
-        await this.setWithTransition(monitor.id, monitor.current, target);
-      } else {
-        await this.monitorManager.setBrightness(monitor.id, target);
-      }
+      await this.setWithTransition(monitor.id, monitor.current, target);
     });
 
     await Promise.all(promises);
@@ -88,6 +108,19 @@ export class BrightnessController {
     monitorId: string,
     targetValue: number,
     animated: boolean = true,
+  ): Promise<boolean> {
+    return traceService.span("BrightnessController.setMonitorBrightness", () =>
+      this.applyMonitorBrightness(monitorId, targetValue, animated),
+    );
+  }
+
+  /**
+   * Body of setMonitorBrightness (a stage of its own when tracing)
+   */
+  private async applyMonitorBrightness(
+    monitorId: string,
+    targetValue: number,
+    animated: boolean,
   ): Promise<boolean> {
     const clampedTarget = Math.max(
       BRIGHTNESS.MIN,
@@ -119,7 +152,10 @@ export class BrightnessController {
    * Increase brightness by a step
    */
   public async increaseBrightness(step: number = 10): Promise<void> {
-    const monitors = await this.monitorManager.getMonitors();
+    // Monitors still being probed have no brightness yet
+    const monitors = (await this.monitorManager.getMonitors()).filter(
+      (m) => m.current >= 0,
+    );
 
     if (monitors.length === 0) {
       console.warn("No monitors available to increase brightness");
@@ -138,7 +174,10 @@ export class BrightnessController {
    * Decrease brightness by a step
    */
   public async decreaseBrightness(step: number = 10): Promise<void> {
-    const monitors = await this.monitorManager.getMonitors();
+    // Monitors still being probed have no brightness yet
+    const monitors = (await this.monitorManager.getMonitors()).filter(
+      (m) => m.current >= 0,
+    );
 
     if (monitors.length === 0) {
       console.warn("No monitors available to decrease brightness");
@@ -177,6 +216,17 @@ export class BrightnessController {
     currentValue: number,
     targetValue: number,
   ): Promise<void> {
+    // The native animator coalesces overlapping targets itself, so a new
+    // request (e.g. a repeated hotkey) redirects the running transition
+    if (this.monitorManager.supportsNativeTransitions()) {
+      await this.monitorManager.transitionTo(
+        monitorId,
+        targetValue,
+        BRIGHTNESS_TRANSITION.DURATION_MS,
+      );
+      return;
+    }
+
     // Check if transition is already in progress for this monitor
     if (this.transitionInProgress.get(monitorId)) {
       console.log(
@@ -230,7 +280,9 @@ export class BrightnessController {
    * Get average brightness across all monitors
    */
   public async getAverageBrightness(): Promise<number> {
-    const monitors = await this.monitorManager.getMonitors();
+    const monitors = (await this.monitorManager.getMonitors()).filter(
+      (m) => m.current >= 0,
+    );
 
     if (monitors.length === 0) {
       return BRIGHTNESS.DEFAULT;
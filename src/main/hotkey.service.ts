@@ -5,6 +5,7 @@
 import { globalShortcut } from "electron";
 import { BrightnessController } from "./brightness.controller";
 import { HOTKEYS } from "../shared/constants";
+import { traceService } from "./trace.service";
 
 export class HotkeyService {
   private brightnessController: BrightnessController;
@@ -29,8 +30,10 @@ export class HotkeyService {
         HOTKEYS.INCREASE,
         async () => {
           console.log("Hotkey pressed: Increase brightness");
-          await this.brightnessController.increaseBrightness(
-            HOTKEYS.BRIGHTNESS_STEP,
+          await traceService.request("hotkey increase", () =>
+            this.brightnessController.increaseBrightness(
+              HOTKEYS.BRIGHTNESS_STEP,
+            ),
           );
         },
       );
@@ -44,8 +47,10 @@ export class HotkeyService {
         HOTKEYS.DECREASE,
         async () => {
           console.log("Hotkey pressed: Decrease brightness");
-          await this.brightnessController.decreaseBrightness(
-            HOTKEYS.BRIGHTNESS_STEP,
+          await traceService.request("hotkey decrease", () =>
+            this.brightnessController.decreaseBrightness(
+              HOTKEYS.BRIGHTNESS_STEP,
+            ),
           );
         },
       );
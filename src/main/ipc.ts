@@ -11,9 +11,11 @@ import {
   Monitor,
   BrightnessChangeRequest,
   AppSettings,
+  NativeStats,
 } from "../shared/types";
 import Store from "electron-store";
 import { DEFAULT_SETTINGS } from "../shared/constants";
+import { traceService } from "./trace.service";
 
 export class IPCHandler {
   private monitorManager: MonitorManager;
@@ -49,7 +51,9 @@ export class IPCHandler {
     ipcMain.handle(
       IPC_CHANNELS.MONITORS_GET,
       async (_event: IpcMainInvokeEvent): Promise<IPCResponse<Monitor[]>> => {
-        return this.handleMonitorsGet();
+        return traceService.request(`ipc ${IPC_CHANNELS.MONITORS_GET}`, () =>
+          this.handleMonitorsGet(),
+        );
       },
     );
 
@@ -60,7 +64,9 @@ export class IPCHandler {
         _event: IpcMainInvokeEvent,
         monitorId: string,
       ): Promise<IPCResponse<number>> => {
-        return this.handleBrightnessGet(monitorId);
+        return traceService.request(`ipc ${IPC_CHANNELS.BRIGHTNESS_GET}`, () =>
+          this.handleBrightnessGet(monitorId),
+        );
       },
     );
 
@@ -71,7 +77,11 @@ export class IPCHandler {
         _event: IpcMainInvokeEvent,
         request: BrightnessChangeRequest,
       ): Promise<IPCResponse<boolean>> => {
-        return this.handleBrightnessSet(request);
+        return traceService.request(
+          `ipc ${IPC_CHANNELS.BRIGHTNESS_SET}`,
+          () => this.handleBrightnessSet(request),
+          request?.sentAt,
+        );
       },
     );
 
@@ -102,6 +112,16 @@ export class IPCHandler {
       },
     );
 
+    // Get native statistics
+    ipcMain.handle(
+      IPC_CHANNELS.STATS_GET,
+      async (
+        _event: IpcMainInvokeEvent,
+      ): Promise<IPCResponse<NativeStats | null>> => {
+        return this.handleStatsGet();
+      },
+    );
+
     console.log("IPC handlers registered");
   }
 
@@ -110,7 +130,10 @@ export class IPCHandler {
    */
   private async handleMonitorsGet(): Promise<IPCResponse<Monitor[]>> {
     try {
-      const monitors = await this.monitorManager.getMonitors(true);
+      // Pushed changes reach the native cache, so polls need not force a read
+      const monitors = await this.monitorManager.getMonitors(
+        !this.monitorManager.isWatchingBrightness(),
+      );
       return {
         success: true,
         data: monitors,
@@ -309,6 +332,26 @@ export class IPCHandler {
     }
   }
 
+  /**
+   * Handle stats get request
+   */
+  private async handleStatsGet(): Promise<IPCResponse<NativeStats | null>> {
+    try {
+      return {
+        success: true,
+        data: this.monitorManager.getStats(),
+      };
+    } catch (error) {
+      const errorMessage =
+        error instanceof Error ? error.message : String(error);
+      console.error("Failed to get stats:", errorMessage);
+      return {
+        success: false,
+        error: errorMessage,
+      };
+    }
+  }
+
   /**
    * Emit brightness changed event to renderer
    */
@@ -10,7 +10,9 @@ import { BrightnessController } from "./brightness.controller";
 import { IPCHandler } from "./ipc";
 import { TrayService } from "./tray.service";
 import { HotkeyService } from "./hotkey.service";
+import { traceService } from "./trace.service";
 import { WINDOW } from "../shared/constants";
+import { MockDisplayConfig } from "../shared/types";
 import { exec } from "child_process";
 import { promisify } from "util";
 
@@ -25,13 +27,46 @@ class BrightSyncApp {
   private hotkeyService!: HotkeyService;
   private isQuitting: boolean = false;
   private mockMode: boolean = false;
+  // Where the request trace is written on quit (--trace=<file.json>)
+  private tracePath: string | null = null;
 
   constructor() {
     // Detect mock mode from command line arguments
     this.detectMockMode();
+    this.detectTracing();
     this.initializeApp();
   }
 
+  /**
+   * Start request tracing if --trace=<file.json> is present
+   */
+  private detectTracing(): void {
+    const arg = process.argv.find((a) => a.startsWith("--trace="));
+    if (!arg) {
+      return;
+    }
+
+    this.tracePath = arg.substring("--trace=".length);
+    traceService.start();
+    console.log(`Tracing requests to ${this.tracePath}`);
+  }
+
+  /**
+   * Write the request trace (load it in chrome://tracing or Perfetto)
+   */
+  private writeTrace(): void {
+    if (!this.tracePath) {
+      return;
+    }
+
+    try {
+      fs.writeFileSync(this.tracePath, JSON.stringify(traceService.stop()));
+      console.log(`Request trace written to ${this.tracePath}`);
+    } catch (error) {
+      console.error(`Failed to write trace ${this.tracePath}:`, error);
+    }
+  }
+
   /**
    * Detect if --mock flag is present in command line arguments
    */
@@ -193,12 +228,53 @@ class BrightSyncApp {
     }
   }
 
+  /**
+   * Read the simulated displays from --mock-topology=<file.json>
+   */
+  private loadMockTopology(): MockDisplayConfig[] | undefined {
+    const arg = process.argv.find((a) => a.startsWith("--mock-topology="));
+    if (!arg) {
+      return undefined;
+    }
+
+    const file = arg.substring("--mock-topology=".length);
+    try {
+      const topology = JSON.parse(fs.readFileSync(file, "utf8"));
+      if (!Array.isArray(topology)) {
+        throw new Error("expected an array of displays");
+      }
+      console.log(`Using mock topology from ${file}`);
+      return topology as MockDisplayConfig[];
+    } catch (error) {
+      console.error(`Failed to load mock topology ${file}:`, error);
+      return undefined;
+    }
+  }
+
   /**
    * Initialize all services
    */
   private initializeServices(): void {
-    // Initialize monitor manager with mock mode flag
-    this.monitorManager = new MonitorManager(this.mockMode);
+    // Initialize monitor manager with mock mode flag; detected monitor
+    // capabilities are kept in the user data folder for the next launch
+    this.monitorManager = new MonitorManager(this.mockMode, {
+      capabilityCachePath: path.join(
+        app.getPath("userData"),
+        "monitor-capabilities.txt",
+      ),
+      // --verbose logs every native hardware call
+      logLevel: process.argv.includes("--verbose") ? "debug" : "info",
+      mockTopology: this.mockMode ? this.loadMockTopology() : undefined,
+      // Tray and window come up before the hardware has been enumerated
+      deferHardware: true,
+    });
+
+    this.monitorManager
+      .whenHardwareReady()
+      .then(() => console.log("Monitor discovery finished"))
+      .catch((error) =>
+        console.error("Background monitor discovery failed:", error),
+      );
 
     // Initialize brightness controller
     this.brightnessController = new BrightnessController(this.monitorManager);
@@ -209,6 +285,15 @@ class BrightSyncApp {
       this.brightnessController,
     );
 
+    // Forward brightness changes made by the OS or a monitor's OSD
+    this.monitorManager.onBrightnessChanged((event) => {
+      this.ipcHandler.emitBrightnessChanged(
+        event.monitorId,
+        event.oldValue,
+        event.newValue,
+      );
+    });
+
     // Initialize tray service
     this.trayService = new TrayService(this.brightnessController);
 
@@ -271,12 +356,18 @@ class BrightSyncApp {
   private onAppQuit(): void {
     console.log("Cleaning up...");
 
+    // Stop native brightness change notifications
+    this.monitorManager.onBrightnessChanged(null);
+
     // Unregister hotkeys
     this.hotkeyService.unregisterAll();
 
     // Destroy tray
     this.trayService.destroy();
 
+    // Save the request trace while the native layer is still loaded
+    this.writeTrace();
+
     console.log("Cleanup complete");
   }
 }
@@ -2,23 +2,128 @@
  * Monitor Manager - Interface to native addon for monitor operations
  */
 
-import { Monitor } from "../shared/types";
+import {
+  Monitor,
+  BrightnessBatchEntry,
+  BrightnessBatchResult,
+  BrightnessTransitionResult,
+  NativeLogLevel,
+  NativeLogEntry,
+  NativeStats,
+  MockDisplayConfig,
+  MonitorDescriptorSet,
+  SharedMonitorState,
+  BrightnessChangeEvent,
+  NativeTrace,
+} from "../shared/types";
+import { traceService } from "./trace.service";
 import * as path from "path";
 
 // Import native addon
 let nativeAddon: NativeBrightnessAddon | null = null;
 
+// Optional trailing trace ID of the async exports
+type TraceArgs = [] | [traceId: number];
+
 interface NativeBrightnessAddon {
-  initialize(config: { mockMode: boolean }): boolean;
-  getMonitors(): Monitor[];
-  getBrightness(monitorId: string): number;
+  initialize(config: {
+    mockMode: boolean;
+    brightnessCacheMs?: number;
+    // File remembering DDC/CI capabilities between launches
+    capabilityCachePath?: string;
+    logLevel?: NativeLogLevel;
+    mockTopology?: MockDisplayConfig[];
+    // Discover monitors in the background (see whenHardwareReady)
+    deferHardware?: boolean;
+  }): boolean;
+  // forceRefresh bypasses the native brightness cache
+  getMonitors(forceRefresh?: boolean): Monitor[];
+  getBrightness(monitorId: string, forceRefresh?: boolean): number;
   setBrightness(monitorId: string, value: number): boolean;
+  // Promise-based variants run hardware I/O off the main thread; a trailing
+  // trace ID ties their native stages to a traced request
+  getMonitorsAsync?(
+    forceRefresh?: boolean,
+    ...trace: TraceArgs
+  ): Promise<Monitor[]>;
+  getBrightnessAsync?(
+    monitorId: string,
+    forceRefresh?: boolean,
+    ...trace: TraceArgs
+  ): Promise<number>;
+  setBrightnessAsync?(
+    monitorId: string,
+    value: number,
+    ...trace: TraceArgs
+  ): Promise<boolean>;
+  // Programs all monitors concurrently (one native worker per bus)
+  setBrightnessBatch?(
+    entries: BrightnessBatchEntry[],
+    ...trace: TraceArgs
+  ): Promise<BrightnessBatchResult[]>;
+  // Native animator; a newer target replaces the in-flight one
+  setBrightnessTarget?(
+    monitorId: string,
+    value: number,
+    durationMs: number,
+    ...trace: TraceArgs
+  ): Promise<BrightnessTransitionResult>;
+  // Forwards native log messages in batches; null restores stdout
+  setLogHandler?(handler: ((entries: NativeLogEntry[]) => void) | null): void;
+  // Counters and latencies; reset zeroes them after reading
+  getStats?(reset?: boolean): NativeStats;
+  // Allocation-free polling: descriptors change only with the topology,
+  // brightness is copied into a caller-owned buffer (-1 = use the async path)
+  getMonitorDescriptors?(): MonitorDescriptorSet | null;
+  readBrightnessSnapshot?(values: Int32Array): number;
+  // Shared-memory copy of the monitor table, also readable from other
+  // processes (null until the main process has published one)
+  readSharedState?(): SharedMonitorState | null;
+  // Pushes changes made outside BrightSync (OS, Fn keys, monitor OSD);
+  // externals are sampled every sampleIntervalMs, null stops
+  onBrightnessChanged?(
+    handler: ((event: BrightnessChangeEvent) => void) | null,
+    sampleIntervalMs?: number,
+  ): void;
+  // Resolves when deferred discovery has finished; until then getMonitors
+  // reports the last session's monitors (provisional: true)
+  whenHardwareReady?(): Promise<boolean>;
+  // Per-stage timestamps of traced requests (see TraceService)
+  setTracing?(enabled: boolean): void;
+  traceNow?(): number;
+  drainTrace?(): NativeTrace;
+}
+
+/**
+ * Trailing trace ID argument for the native exports (none when untraced)
+ */
+function traceArgs(): TraceArgs {
+  const traceId = traceService.currentId();
+  return traceId === undefined ? [] : [traceId];
+}
+
+/**
+ * Options for the native monitor layer
+ */
+export interface MonitorManagerOptions {
+  // Where per-monitor DDC/CI capabilities are persisted (real mode only)
+  capabilityCachePath?: string;
+  // Native log level (default "info"; "debug" logs every hardware call)
+  logLevel?: NativeLogLevel;
+  // Simulated displays in mock mode (default: 1 internal, 2 external)
+  mockTopology?: MockDisplayConfig[];
+  // Return from initialization at once and discover monitors in the
+  // background, serving the last known monitors from capabilityCachePath
+  deferHardware?: boolean;
 }
 
 /**
  * Initialize the native addon
  */
-function initializeNativeAddon(mockMode: boolean): NativeBrightnessAddon {
+function initializeNativeAddon(
+  mockMode: boolean,
+  options: MonitorManagerOptions,
+): NativeBrightnessAddon {
   if (nativeAddon) {
     return nativeAddon;
   }
@@ -32,7 +137,13 @@ function initializeNativeAddon(mockMode: boolean): NativeBrightnessAddon {
     nativeAddon = require(addonPath) as NativeBrightnessAddon;
 
     // Initialize with mock mode configuration
-    const success = nativeAddon.initialize({ mockMode });
+    const success = nativeAddon.initialize({
+      mockMode,
+      capabilityCachePath: options.capabilityCachePath,
+      logLevel: options.logLevel,
+      mockTopology: options.mockTopology,
+      deferHardware: options.deferHardware,
+    });
 
     if (success) {
       console.log(
@@ -54,12 +165,34 @@ export class MonitorManager {
   private monitors: Monitor[] = [];
   private lastUpdate: number = 0;
   private cacheTimeout: number = 500; // Cache monitor list for 500ms
+  // Descriptors this.monitors was built from, and its brightness buffer
+  private descriptors: MonitorDescriptorSet | null = null;
+  private brightnessBuffer: Int32Array = new Int32Array(0);
+  // Set while native code pushes brightness changes
+  private watchingBrightness = false;
 
-  constructor(mockMode: boolean = false) {
-    this.addon = initializeNativeAddon(mockMode);
+  constructor(mockMode: boolean = false, options: MonitorManagerOptions = {}) {
+    this.addon = initializeNativeAddon(mockMode, options);
+    this.attachTracing();
     this.refreshMonitors();
   }
 
+  /**
+   * Let traced requests continue into the native layer
+   */
+  private attachTracing(): void {
+    const { setTracing, traceNow, drainTrace } = this.addon;
+    if (!setTracing || !traceNow || !drainTrace) {
+      return;
+    }
+
+    traceService.attachNative({
+      setEnabled: (enabled) => setTracing(enabled),
+      now: () => traceNow(),
+      drain: () => drainTrace(),
+    });
+  }
+
   /**
    * Get list of all connected monitors
    */
@@ -75,15 +208,29 @@ export class MonitorManager {
       return this.monitors;
     }
 
-    return this.refreshMonitors();
+    return this.refreshMonitors(forceRefresh);
   }
 
   /**
    * Refresh monitor list from native addon
+   *
+   * Brightness values come from the native cache unless forceRefresh is set
    */
-  private async refreshMonitors(): Promise<Monitor[]> {
+  private async refreshMonitors(
+    forceRefresh: boolean = false,
+  ): Promise<Monitor[]> {
     try {
-      this.monitors = this.addon.getMonitors();
+      if (!forceRefresh && this.readSnapshot()) {
+        this.lastUpdate = Date.now();
+        return this.monitors;
+      }
+
+      this.descriptors = null;
+      this.monitors = await traceService.span("addon.getMonitors", async () =>
+        this.addon.getMonitorsAsync
+          ? this.addon.getMonitorsAsync(forceRefresh, ...traceArgs())
+          : this.addon.getMonitors(forceRefresh),
+      );
       this.lastUpdate = Date.now();
 
       console.log(
@@ -98,12 +245,73 @@ export class MonitorManager {
     }
   }
 
+  /**
+   * Update the cached monitors in place from native memory
+   *
+   * The Monitor objects are only rebuilt when the topology changes, so
+   * steady-state polling allocates nothing
+   * @returns false if the addon lacks the snapshot exports or would need
+   *          to enumerate or read hardware
+   */
+  private readSnapshot(): boolean {
+    if (
+      !this.addon.getMonitorDescriptors ||
+      !this.addon.readBrightnessSnapshot
+    ) {
+      return false;
+    }
+
+    const descriptors = this.addon.getMonitorDescriptors();
+    if (!descriptors) {
+      return false;
+    }
+
+    if (descriptors !== this.descriptors) {
+      this.monitors = descriptors.monitors.map((descriptor) => ({
+        ...descriptor,
+        current: -1,
+        probing: true,
+      }));
+      this.brightnessBuffer = new Int32Array(this.monitors.length);
+      this.descriptors = descriptors;
+    }
+
+    // A topology change between the two calls shows up as a version mismatch
+    const version = this.addon.readBrightnessSnapshot(this.brightnessBuffer);
+    if (version !== descriptors.version) {
+      return false;
+    }
+
+    for (let i = 0; i < this.monitors.length; i++) {
+      const current = this.brightnessBuffer[i];
+      this.monitors[i].current = current;
+      this.monitors[i].probing = current < 0;
+    }
+    return true;
+  }
+
   /**
    * Get current brightness for a specific monitor
+   *
+   * Recently read or written values are served from the native cache;
+   * pass forceRefresh to read the hardware
    */
-  public async getBrightness(monitorId: string): Promise<number> {
+  public async getBrightness(
+    monitorId: string,
+    forceRefresh: boolean = false,
+  ): Promise<number> {
     try {
-      const brightness = this.addon.getBrightness(monitorId);
+      const brightness = await traceService.span(
+        "addon.getBrightness",
+        async () =>
+          this.addon.getBrightnessAsync
+            ? this.addon.getBrightnessAsync(
+                monitorId,
+                forceRefresh,
+                ...traceArgs(),
+              )
+            : this.addon.getBrightness(monitorId, forceRefresh),
+      );
 
       if (brightness < 0) {
         throw new Error(`Failed to get brightness for monitor ${monitorId}`);
@@ -130,7 +338,17 @@ export class MonitorManager {
       // Clamp value to valid range
       const clampedValue = Math.max(0, Math.min(100, Math.round(value)));
 
-      const success = this.addon.setBrightness(monitorId, clampedValue);
+      const success = await traceService.span(
+        "addon.setBrightness",
+        async () =>
+          this.addon.setBrightnessAsync
+            ? this.addon.setBrightnessAsync(
+                monitorId,
+                clampedValue,
+                ...traceArgs(),
+              )
+            : this.addon.setBrightness(monitorId, clampedValue),
+      );
 
       if (!success) {
         console.warn(`Failed to set brightness for monitor ${monitorId}`);
@@ -154,25 +372,211 @@ export class MonitorManager {
   }
 
   /**
-   * Set brightness for all monitors
+   * Set brightness for several monitors at once
+   *
+   * Uses the native batch export when available so all displays are
+   * programmed concurrently; falls back to parallel single writes.
    */
-  public async setBrightnessForAll(
-    value: number,
+  public async setBrightnessBatch(
+    entries: BrightnessBatchEntry[],
   ): Promise<Map<string, boolean>> {
     const results = new Map<string, boolean>();
-    const monitors = await this.getMonitors();
+    const clamped = entries.map((entry) => ({
+      id: entry.id,
+      value: Math.max(0, Math.min(100, Math.round(entry.value))),
+    }));
 
-    // Set brightness for all monitors in parallel
-    const promises = monitors.map(async (monitor) => {
-      const success = await this.setBrightness(monitor.id, value);
-      results.set(monitor.id, success);
-    });
+    if (!this.addon.setBrightnessBatch) {
+      await Promise.all(
+        clamped.map(async (entry) => {
+          results.set(
+            entry.id,
+            await this.setBrightness(entry.id, entry.value),
+          );
+        }),
+      );
+      return results;
+    }
+
+    try {
+      const setBrightnessBatch = this.addon.setBrightnessBatch;
+      const batchResults = await traceService.span(
+        "addon.setBrightnessBatch",
+        () => setBrightnessBatch(clamped, ...traceArgs()),
+      );
 
-    await Promise.all(promises);
+      batchResults.forEach((result, index) => {
+        results.set(result.id, result.success);
+
+        if (!result.success) {
+          console.warn(
+            `Failed to set brightness for monitor ${result.id}:`,
+            result.error,
+          );
+          return;
+        }
+
+        // Update cached monitor brightness
+        const monitor = this.monitors.find((m) => m.id === result.id);
+        if (monitor) {
+          monitor.current = clamped[index].value;
+        }
+      });
+    } catch (error) {
+      console.error("Failed to set brightness batch:", error);
+      clamped.forEach((entry) => results.set(entry.id, false));
+    }
 
     return results;
   }
 
+  /**
+   * Check if the native addon can run transitions itself
+   */
+  public supportsNativeTransitions(): boolean {
+    return typeof this.addon.setBrightnessTarget === "function";
+  }
+
+  /**
+   * Animate a monitor towards a target using the native animator
+   *
+   * Resolves once the target is reached, or once a newer target for the same
+   * monitor replaced it. Returns false only on hardware errors.
+   */
+  public async transitionTo(
+    monitorId: string,
+    value: number,
+    durationMs: number,
+  ): Promise<boolean> {
+    if (!this.addon.setBrightnessTarget) {
+      return this.setBrightness(monitorId, value);
+    }
+
+    try {
+      const clampedValue = Math.max(0, Math.min(100, Math.round(value)));
+      const setBrightnessTarget = this.addon.setBrightnessTarget;
+      const result = await traceService.span("addon.setBrightnessTarget", () =>
+        setBrightnessTarget(
+          monitorId,
+          clampedValue,
+          durationMs,
+          ...traceArgs(),
+        ),
+      );
+
+      // Update cached monitor brightness with the value actually reached
+      const monitor = this.monitors.find((m) => m.id === monitorId);
+      if (monitor && result.value >= 0) {
+        monitor.current = result.value;
+      }
+
+      if (!result.success && !result.superseded) {
+        console.warn(`Failed to animate brightness for monitor ${monitorId}`);
+        return false;
+      }
+
+      return true;
+    } catch (error) {
+      console.error(
+        `Failed to animate brightness for monitor ${monitorId}:`,
+        error,
+      );
+      return false;
+    }
+  }
+
+  /**
+   * Receive native log messages in batches instead of on stdout
+   * Pass null to go back to stdout. Returns false if the addon cannot forward.
+   */
+  public setNativeLogHandler(
+    handler: ((entries: NativeLogEntry[]) => void) | null,
+  ): boolean {
+    if (!this.addon.setLogHandler) {
+      return false;
+    }
+
+    this.addon.setLogHandler(handler);
+    return true;
+  }
+
+  /**
+   * Receive brightness changes made outside BrightSync
+   * The cached monitor list is updated before the listener runs. Pass null
+   * to stop. Returns false if the addon cannot push changes.
+   */
+  public onBrightnessChanged(
+    listener: ((event: BrightnessChangeEvent) => void) | null,
+    sampleIntervalMs?: number,
+  ): boolean {
+    if (!this.addon.onBrightnessChanged) {
+      return false;
+    }
+
+    if (!listener) {
+      this.addon.onBrightnessChanged(null);
+      this.watchingBrightness = false;
+      return true;
+    }
+
+    this.addon.onBrightnessChanged((event) => {
+      const monitor = this.monitors.find((m) => m.id === event.monitorId);
+      if (monitor) {
+        monitor.current = event.newValue;
+      }
+      listener(event);
+    }, sampleIntervalMs);
+    this.watchingBrightness = true;
+    return true;
+  }
+
+  /**
+   * Check if brightness changes are pushed by the native layer
+   * While they are, polls can use cached values instead of forcing a read.
+   */
+  public isWatchingBrightness(): boolean {
+    return this.watchingBrightness;
+  }
+
+  /**
+   * Wait until the native layer has discovered the real monitors
+   * Resolves at once if discovery was not deferred or the addon cannot
+   * defer it. The cached monitor list is refreshed before resolving.
+   */
+  public async whenHardwareReady(): Promise<void> {
+    if (!this.addon.whenHardwareReady) {
+      return;
+    }
+
+    await this.addon.whenHardwareReady();
+    await this.refreshMonitors();
+  }
+
+  /**
+   * Get native counters and latencies
+   * Returns null if the addon does not collect them.
+   */
+  public getStats(reset = false): NativeStats | null {
+    if (!this.addon.getStats) {
+      return null;
+    }
+
+    return this.addon.getStats(reset);
+  }
+
+  /**
+   * Set brightness for all monitors
+   */
+  public async setBrightnessForAll(
+    value: number,
+  ): Promise<Map<string, boolean>> {
+    const monitors = await this.getMonitors();
+
+    return this.setBrightnessBatch(
+      monitors.map((monitor) => ({ id: monitor.id, value })),
+    );
+  }
+
   /**
    * Get the internal (laptop) monitor if available
    */
@@ -0,0 +1,300 @@
+/**
+ * Trace Service - Opt-in end-to-end latency tracing of brightness requests
+ */
+
+import { AsyncLocalStorage } from "async_hooks";
+import { ChromeTrace, ChromeTraceEvent, NativeTrace } from "../shared/types";
+
+// JavaScript stages kept per session, as many as the native buffer holds
+const MAX_JS_STAGES = 100000;
+
+/**
+ * Native half of tracing (installed by MonitorManager)
+ */
+export interface NativeTraceSource {
+  setEnabled(enabled: boolean): void;
+  // Clock of the native events, in microseconds
+  now(): number;
+  drain(): NativeTrace;
+}
+
+/**
+ * One JavaScript stage of a request (microseconds on the trace clock)
+ */
+interface TraceStage {
+  name: string;
+  traceId: number;
+  spanId: number;
+  start: number;
+  end: number;
+}
+
+export class TraceService {
+  // Trace ID of the request the running code belongs to
+  private context = new AsyncLocalStorage<number>();
+  private native: NativeTraceSource | null = null;
+  private enabled = false;
+  private nextTraceId = 1;
+  private nextSpanId = 1;
+  private stages: TraceStage[] = [];
+  private maxStages: number;
+  // Stages lost because the session already held maxStages
+  private droppedStages = 0;
+
+  /**
+   * @param maxStages JavaScript stages kept per session; later ones are
+   *                  counted as dropped
+   */
+  constructor(maxStages: number = MAX_JS_STAGES) {
+    this.maxStages = maxStages;
+  }
+
+  /**
+   * Check if tracing is on
+   */
+  public isEnabled(): boolean {
+    return this.enabled;
+  }
+
+  /**
+   * Use the native clock and collect native stages
+   */
+  public attachNative(source: NativeTraceSource): void {
+    this.native = source;
+    if (this.enabled) {
+      source.setEnabled(true);
+    }
+  }
+
+  /**
+   * Start a tracing session, discarding any earlier one
+   */
+  public start(): void {
+    this.stages = [];
+    this.droppedStages = 0;
+    this.enabled = true;
+    this.native?.setEnabled(true);
+    console.log("Request tracing started");
+  }
+
+  /**
+   * Stop tracing and return everything recorded since start()
+   */
+  public stop(): ChromeTrace {
+    const native = this.native?.drain() ?? null;
+    this.native?.setEnabled(false);
+    this.enabled = false;
+
+    const trace = this.toChromeTrace(this.stages, native);
+    this.stages = [];
+    this.droppedStages = 0;
+    console.log(
+      `Request tracing stopped (${trace.traceEvents.length} events)`,
+    );
+    return trace;
+  }
+
+  /**
+   * Trace ID of the running request, for passing to the native addon
+   * Undefined while tracing is off or outside a request.
+   */
+  public currentId(): number | undefined {
+    return this.enabled ? this.context.getStore() : undefined;
+  }
+
+  /**
+   * Run a new request (an IPC call, a hotkey) under its own trace ID
+   * @param sentAt When the request left the renderer (ms since epoch), to
+   *               record its IPC transit
+   */
+  public async request<T>(
+    name: string,
+    fn: () => Promise<T>,
+    sentAt?: number,
+  ): Promise<T> {
+    if (!this.enabled) {
+      return fn();
+    }
+
+    const traceId = this.nextTraceId++;
+    if (sentAt !== undefined) {
+      const receivedAt = this.now();
+      this.addStage({
+        name: "ipc transit",
+        traceId,
+        spanId: this.nextSpanId++,
+        start: Math.min(receivedAt, this.fromEpochMs(sentAt, receivedAt)),
+        end: receivedAt,
+      });
+    }
+
+    return this.context.run(traceId, () => this.record(name, traceId, fn));
+  }
+
+  /**
+   * Run one stage of the current request
+   * Runs fn untraced outside a request.
+   */
+  public async span<T>(name: string, fn: () => Promise<T>): Promise<T> {
+    const traceId = this.currentId();
+    if (traceId === undefined) {
+      return fn();
+    }
+
+    return this.record(name, traceId, fn);
+  }
+
+  /**
+   * Time fn as a stage of a request
+   */
+  private async record<T>(
+    name: string,
+    traceId: number,
+    fn: () => Promise<T>,
+  ): Promise<T> {
+    const stage: TraceStage = {
+      name,
+      traceId,
+      spanId: this.nextSpanId++,
+      start: this.now(),
+      end: 0,
+    };
+
+    try {
+      return await fn();
+    } finally {
+      stage.end = this.now();
+      if (this.enabled) {
+        this.addStage(stage);
+      }
+    }
+  }
+
+  /**
+   * Keep a finished stage unless the session is full
+   */
+  private addStage(stage: TraceStage): void {
+    if (this.stages.length < this.maxStages) {
+      this.stages.push(stage);
+    } else {
+      this.droppedStages++;
+    }
+  }
+
+  /**
+   * Current time in microseconds on the clock native stages use
+   */
+  private now(): number {
+    if (this.native) {
+      return this.native.now();
+    }
+
+    const [seconds, nanoseconds] = process.hrtime();
+    return seconds * 1e6 + nanoseconds / 1e3;
+  }
+
+  /**
+   * Convert a wall-clock timestamp from another process to the trace clock
+   * @param nowUs The trace clock read just before
+   */
+  private fromEpochMs(epochMs: number, nowUs: number): number {
+    const ageMs = performance.timeOrigin + performance.now() - epochMs;
+    return nowUs - ageMs * 1000;
+  }
+
+  /**
+   * Build the trace-event file
+   *
+   * JavaScript stages become async slices (they overlap on the main
+   * thread); native stages are complete events on the thread that ran
+   * them. Both carry the request's traceId in args.
+   */
+  private toChromeTrace(
+    stages: TraceStage[],
+    native: NativeTrace | null,
+  ): ChromeTrace {
+    const pid = process.pid;
+    const threads = native?.threads ?? [];
+    const jsThread = threads.find((thread) => thread.name === "JavaScript");
+    const jsTid = jsThread ? jsThread.tid : 0;
+
+    const metadata: ChromeTraceEvent[] = [
+      {
+        name: "process_name",
+        ph: "M",
+        pid,
+        tid: jsTid,
+        args: { name: "BrightSync main" },
+      },
+      ...threads.map((thread) => ({
+        name: "thread_name",
+        ph: "M",
+        pid,
+        tid: thread.tid,
+        args: { name: thread.name },
+      })),
+    ];
+
+    const events: ChromeTraceEvent[] = [];
+    for (const stage of stages) {
+      const id = `0x${stage.spanId.toString(16)}`;
+      const args = { traceId: stage.traceId };
+      events.push(
+        {
+          name: stage.name,
+          cat: "js",
+          ph: "b",
+          id,
+          ts: stage.start,
+          pid,
+          tid: jsTid,
+          args,
+        },
+        {
+          name: stage.name,
+          cat: "js",
+          ph: "e",
+          id,
+          ts: stage.end,
+          pid,
+          tid: jsTid,
+          args,
+        },
+      );
+    }
+
+    for (const event of native?.events ?? []) {
+      const args: Record<string, unknown> = {};
+      if (event.traceId > 0) {
+        args.traceId = event.traceId;
+      }
+      if (event.monitorId) {
+        args.monitorId = event.monitorId;
+      }
+      events.push({
+        name: event.name,
+        cat: event.cat,
+        ph: "X",
+        ts: event.ts,
+        dur: event.dur,
+        pid,
+        tid: event.tid,
+        args,
+      });
+    }
+
+    events.sort((a, b) => (a.ts ?? 0) - (b.ts ?? 0));
+
+    return {
+      traceEvents: [...metadata, ...events],
+      displayTimeUnit: "ms",
+      otherData: {
+        droppedNativeEvents: native?.dropped ?? 0,
+        droppedJsStages: this.droppedStages,
+      },
+    };
+  }
+}
+
+// Shared by every layer a request passes through
+export const traceService = new TraceService();
@@ -3,6 +3,7 @@
  */
 
 import { contextBridge, ipcRenderer, IpcRendererEvent } from "electron";
+import * as path from "path";
 import {
   IPC_CHANNELS,
   IPCResponse,
@@ -10,8 +11,39 @@ import {
   BrightnessChangeRequest,
   BrightnessChangeEvent,
   AppSettings,
+  NativeStats,
+  SharedMonitorState,
 } from "../shared/types";
 
+/**
+ * Read-only shared state module (build/Release/brightsync_state.node)
+ * Only maps the segment the main process publishes; the hardware addon is
+ * never loaded into the renderer.
+ */
+interface SharedStateReader {
+  readSharedState(): SharedMonitorState | null;
+}
+
+// Loaded on first use; null if the module cannot be loaded here
+let stateReader: SharedStateReader | null | undefined;
+
+/**
+ * Load the shared state module
+ */
+function getStateReader(): SharedStateReader | null {
+  if (stateReader === undefined) {
+    try {
+      stateReader = require(
+        path.join(__dirname, "../../build/Release/brightsync_state.node"),
+      ) as SharedStateReader;
+    } catch (error) {
+      console.warn("Shared monitor state unavailable, using IPC:", error);
+      stateReader = null;
+    }
+  }
+  return stateReader;
+}
+
 /**
  * API exposed to renderer process via contextBridge
  */
@@ -23,6 +55,15 @@ const brightnessAPI = {
     return ipcRenderer.invoke(IPC_CHANNELS.MONITORS_GET);
   },
 
+  /**
+   * Read all monitors from shared memory (no IPC, no hardware access)
+   * Null until the main process has published them; use getMonitors then.
+   */
+  getMonitorState: (): Monitor[] | null => {
+    const state = getStateReader()?.readSharedState() ?? null;
+    return state && state.version > 0 ? state.monitors : null;
+  },
+
   /**
    * Get brightness for a specific monitor
    */
@@ -32,11 +73,15 @@ const brightnessAPI = {
 
   /**
    * Set brightness
+   * The send time lets a traced session show the IPC transit.
    */
   setBrightness: async (
     request: BrightnessChangeRequest,
   ): Promise<IPCResponse<boolean>> => {
-    return ipcRenderer.invoke(IPC_CHANNELS.BRIGHTNESS_SET, request);
+    return ipcRenderer.invoke(IPC_CHANNELS.BRIGHTNESS_SET, {
+      ...request,
+      sentAt: performance.timeOrigin + performance.now(),
+    });
   },
 
   /**
@@ -62,6 +107,13 @@ const brightnessAPI = {
     return ipcRenderer.invoke(IPC_CHANNELS.SETTINGS_SET, settings);
   },
 
+  /**
+   * Get native counters and latencies (null if not collected)
+   */
+  getStats: async (): Promise<IPCResponse<NativeStats | null>> => {
+    return ipcRenderer.invoke(IPC_CHANNELS.STATS_GET);
+  },
+
   /**
    * Listen for brightness change events
    */
@@ -38,6 +38,7 @@ declare global {
       setSettings: (
         settings: Partial<AppSettings>,
       ) => Promise<{ success: boolean; data?: boolean; error?: string }>;
+      getMonitorState: () => Monitor[] | null;
       onBrightnessChanged: (
         callback: (event: {
           monitorId: string;
@@ -86,11 +87,15 @@ class App extends React.Component<{}, AppState> {
         this.refreshMonitors();
       }, 2000);
 
-      // Listen for brightness changes
+      // Apply pushed brightness changes without asking for every monitor
       this.brightnessChangeUnsubscribe =
         window.brightnessAPI.onBrightnessChanged((event) => {
           console.log("Brightness changed:", event);
-          this.refreshMonitors();
+          this.setState((prevState) => ({
+            monitors: prevState.monitors.map((m) =>
+              m.id === event.monitorId ? { ...m, current: event.newValue } : m,
+            ),
+          }));
         });
 
       this.setState({ loading: false });
@@ -134,7 +139,11 @@ class App extends React.Component<{}, AppState> {
    */
   private async refreshMonitors(): Promise<void> {
     try {
-      const response = await window.brightnessAPI.getMonitors();
+      // Shared memory answers without IPC; the IPC path is the fallback
+      const shared = window.brightnessAPI.getMonitorState();
+      const response = shared
+        ? { success: true, data: shared, error: undefined }
+        : await window.brightnessAPI.getMonitors();
 
       if (response.success && response.data) {
         this.setState((prevState) => ({
@@ -20,6 +20,8 @@ export class MonitorCard extends React.Component<MonitorCardProps> {
   render(): React.ReactNode {
     const { monitor, disabled = false } = this.props;
     const isInternal = monitor.type === "internal";
+    // Brightness is filled in once the native capability probe finishes
+    const probing = monitor.probing === true || monitor.current < 0;
 
     return (
       <div className={`monitor-card ${isInternal ? "internal" : "external"}`}>
@@ -36,13 +38,15 @@ export class MonitorCard extends React.Component<MonitorCardProps> {
         <div className="monitor-brightness">
           <div className="brightness-label">
             <span>Brightness</span>
-            <span className="brightness-value">{monitor.current}%</span>
+            <span className="brightness-value">
+              {probing ? "…" : `${monitor.current}%`}
+            </span>
           </div>
 
           <BrightnessSlider
-            value={monitor.current}
+            value={probing ? 0 : monitor.current}
             onChange={this.handleBrightnessChange}
-            disabled={disabled}
+            disabled={disabled || probing}
             min={0}
             max={100}
           />
@@ -8,6 +8,7 @@
 export const BRIGHTNESS_TRANSITION = {
   STEP_SIZE: 2,
   STEP_DELAY_MS: 10,
+  DURATION_MS: 250, // Time budget for native transitions
 } as const;
 
 /**
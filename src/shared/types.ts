@@ -11,7 +11,36 @@ export interface Monitor {
   type: "internal" | "external";
   min: number;
   max: number;
-  current: number;
+  current: number; // -1 while the capability probe is still running
+  probing?: boolean;
+  responding?: boolean; // false while native calls fail fast (no answer)
+  provisional?: boolean; // remembered from the last session, not yet probed
+}
+
+/**
+ * Immutable part of a monitor (see getMonitorDescriptors in the native addon)
+ */
+export type MonitorDescriptor = Pick<
+  Monitor,
+  "id" | "name" | "type" | "min" | "max"
+>;
+
+/**
+ * Descriptors of all monitors; the same object is returned until the
+ * topology version changes
+ */
+export interface MonitorDescriptorSet {
+  version: number;
+  monitors: MonitorDescriptor[];
+}
+
+/**
+ * Monitor table the native layer publishes in shared memory; any process
+ * can read it without IPC or hardware access
+ */
+export interface SharedMonitorState {
+  version: number; // topology version, 0 until the first enumeration
+  monitors: Monitor[];
 }
 
 /**
@@ -35,6 +64,7 @@ export const IPC_CHANNELS = {
   BRIGHTNESS_CHANGED: "brightness:changed",
   SETTINGS_GET: "settings:get",
   SETTINGS_SET: "settings:set",
+  STATS_GET: "stats:get",
 } as const;
 
 /**
@@ -52,6 +82,152 @@ export interface IPCResponse<T> {
 export interface BrightnessChangeRequest {
   monitorId?: string; // If undefined, applies to all monitors
   value: number;
+  sentAt?: number; // renderer timestamp (ms since epoch), for tracing
+}
+
+/**
+ * One entry of a batched brightness write
+ */
+export interface BrightnessBatchEntry {
+  id: string;
+  value: number;
+}
+
+/**
+ * Per-monitor outcome of a batched brightness write
+ */
+export interface BrightnessBatchResult {
+  id: string;
+  success: boolean;
+  error?: string;
+}
+
+/**
+ * Outcome of a native brightness transition
+ */
+export interface BrightnessTransitionResult {
+  id: string;
+  value: number; // Brightness actually reached
+  success: boolean;
+  superseded: boolean; // Replaced by a newer target before finishing
+  hardwareRamp?: boolean; // One write; the monitor faded by itself
+}
+
+/**
+ * Native log level
+ */
+export type NativeLogLevel = "trace" | "debug" | "info" | "warn" | "error" | "off";
+
+/**
+ * Message forwarded from the native log
+ */
+export interface NativeLogEntry {
+  level: NativeLogLevel;
+  time: number; // Milliseconds since epoch
+  message: string;
+}
+
+/**
+ * Simulated display(s) for mock mode (one entry may describe several)
+ */
+export interface MockDisplayConfig {
+  type: "internal" | "external";
+  count?: number; // copies of this entry (default 1)
+  id?: string; // generated per type when omitted
+  name?: string;
+  brightness?: number; // initial value (default 50)
+  maxValue?: number; // raw VCP range (default 100)
+  timing?: "instant" | "ddc" | "wmi"; // latency preset (default "instant")
+  readLatencyMs?: number;
+  writeLatencyMs?: number;
+  jitterMs?: number;
+  failureRate?: number; // 0-1
+  hardwareRampMs?: number; // fades by itself in steps of this many ms (0 = no)
+  connectAtMs?: number; // plugged in this long after initialize
+  disconnectAtMs?: number; // unplugged this long after initialize
+}
+
+/**
+ * Latency distribution of one native operation (bucketed, so percentiles
+ * are bucket upper bounds)
+ */
+export interface NativeLatencyStats {
+  count: number;
+  meanMs: number;
+  maxMs: number;
+  p50Ms: number;
+  p95Ms: number;
+  p99Ms: number;
+}
+
+/**
+ * Hardware counters of one monitor
+ */
+export interface NativeMonitorStats {
+  reads: number;
+  readFailures: number;
+  writes: number;
+  writeFailures: number;
+  retries: number; // transactions repeated after re-acquiring handles
+  readLatency: NativeLatencyStats;
+  writeLatency: NativeLatencyStats;
+}
+
+/**
+ * Native counters and latencies (see getStats in the native addon)
+ */
+export interface NativeStats {
+  monitors: Record<string, NativeMonitorStats>;
+  enumeration: NativeLatencyStats;
+  cache: { hits: number; misses: number };
+  writeQueue: { depth: number; coalesced: number };
+}
+
+/**
+ * One stage recorded by the native layer (see drainTrace in the native
+ * addon); ts and dur are microseconds on the traceNow() clock
+ */
+export interface NativeTraceEvent {
+  name: string;
+  cat: string; // "napi", "queue", "native", "wmi", "ddc" or "mock"
+  traceId: number; // 0 if not part of a traced request
+  ts: number;
+  dur: number;
+  tid: number;
+  monitorId?: string;
+}
+
+/**
+ * Native trace events taken since the last drain
+ */
+export interface NativeTrace {
+  events: NativeTraceEvent[];
+  threads: { tid: number; name: string }[];
+  dropped: number; // events lost because the native buffer was full
+}
+
+/**
+ * One event in Chrome trace-event format
+ */
+export interface ChromeTraceEvent {
+  name: string;
+  cat?: string;
+  ph: string;
+  ts?: number;
+  dur?: number;
+  pid: number;
+  tid: number;
+  id?: string;
+  args?: Record<string, unknown>;
+}
+
+/**
+ * A trace file for chrome://tracing or Perfetto
+ */
+export interface ChromeTrace {
+  traceEvents: ChromeTraceEvent[];
+  displayTimeUnit: "ms";
+  otherData: { droppedNativeEvents: number; droppedJsStages: number };
 }
 
 /**
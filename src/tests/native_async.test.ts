@@ -0,0 +1,248 @@
+/**
+ * Native Async Surface Tests
+ *
+ * Verifies that MonitorManager prefers the Promise-based addon exports
+ * so hardware I/O never runs on the Electron main thread
+ */
+
+import { Monitor } from "../shared/types";
+
+// Mock native addon exposing both sync and async variants
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(),
+  getBrightness: jest.fn(),
+  setBrightness: jest.fn(() => true),
+  getMonitorsAsync: jest.fn(),
+  getBrightnessAsync: jest.fn(),
+  setBrightnessAsync: jest.fn(),
+  setBrightnessBatch: jest.fn(),
+  setLogHandler: jest.fn(),
+  getStats: jest.fn(),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+import { BrightnessController } from "../main/brightness.controller";
+
+describe("Native Async Surface", () => {
+  let monitorManager: MonitorManager;
+  let mockMonitors: Monitor[];
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+
+    mockMonitors = [
+      {
+        id: "mock_internal_0",
+        name: "Mock Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 50,
+      },
+      {
+        id: "mock_external_0",
+        name: "Mock External Display 1",
+        type: "external",
+        min: 0,
+        max: 100,
+        current: 50,
+      },
+    ];
+
+    mockNativeAddon.getMonitorsAsync.mockImplementation(() =>
+      Promise.resolve(mockMonitors),
+    );
+    mockNativeAddon.getBrightnessAsync.mockImplementation((id: string) => {
+      const monitor = mockMonitors.find((m) => m.id === id);
+      return Promise.resolve(monitor ? monitor.current : -1);
+    });
+    mockNativeAddon.setBrightnessAsync.mockImplementation(
+      (id: string, value: number) => {
+        const monitor = mockMonitors.find((m) => m.id === id);
+        if (monitor) {
+          monitor.current = value;
+        }
+        return Promise.resolve(monitor !== undefined);
+      },
+    );
+
+    mockNativeAddon.setBrightnessBatch.mockImplementation(
+      (entries: { id: string; value: number }[]) =>
+        Promise.resolve(
+          entries.map((entry) => {
+            const monitor = mockMonitors.find((m) => m.id === entry.id);
+            if (monitor) {
+              monitor.current = entry.value;
+              return { id: entry.id, success: true };
+            }
+            return {
+              id: entry.id,
+              success: false,
+              error: `Monitor not found: ${entry.id}`,
+            };
+          }),
+        ),
+    );
+
+    monitorManager = new MonitorManager(true);
+  });
+
+  it("should enumerate monitors through getMonitorsAsync", async () => {
+    const monitors = await monitorManager.getMonitors(true);
+
+    expect(monitors).toHaveLength(2);
+    expect(mockNativeAddon.getMonitorsAsync).toHaveBeenCalled();
+    expect(mockNativeAddon.getMonitors).not.toHaveBeenCalled();
+  });
+
+  it("should read brightness through getBrightnessAsync", async () => {
+    const brightness = await monitorManager.getBrightness("mock_external_0");
+
+    expect(brightness).toBe(50);
+    expect(mockNativeAddon.getBrightnessAsync).toHaveBeenCalledWith(
+      "mock_external_0",
+      false,
+    );
+    expect(mockNativeAddon.getBrightness).not.toHaveBeenCalled();
+  });
+
+  it("should bypass the native brightness cache on forceRefresh", async () => {
+    await monitorManager.getBrightness("mock_external_0", true);
+    await monitorManager.getMonitors(true);
+
+    expect(mockNativeAddon.getBrightnessAsync).toHaveBeenCalledWith(
+      "mock_external_0",
+      true,
+    );
+    expect(mockNativeAddon.getMonitorsAsync).toHaveBeenLastCalledWith(true);
+  });
+
+  it("should write brightness through setBrightnessAsync", async () => {
+    const success = await monitorManager.setBrightness("mock_external_0", 80);
+
+    expect(success).toBe(true);
+    expect(mockNativeAddon.setBrightnessAsync).toHaveBeenCalledWith(
+      "mock_external_0",
+      80,
+    );
+    expect(mockNativeAddon.setBrightness).not.toHaveBeenCalled();
+    expect(mockMonitors[1].current).toBe(80);
+  });
+
+  it("should reject when the async read fails", async () => {
+    mockNativeAddon.getBrightnessAsync.mockImplementationOnce(() =>
+      Promise.reject(new Error("Monitor not found: missing")),
+    );
+
+    await expect(monitorManager.getBrightness("missing")).rejects.toThrow(
+      "Monitor not found",
+    );
+  });
+
+  it("should drive transitions without touching sync exports", async () => {
+    const brightnessController = new BrightnessController(monitorManager);
+
+    await brightnessController.setMasterBrightness(70, true);
+
+    expect(mockMonitors.every((m) => m.current === 70)).toBe(true);
+    expect(mockNativeAddon.setBrightness).not.toHaveBeenCalled();
+  });
+
+  it("should leave monitors that are still probing out of averages", async () => {
+    mockMonitors.push({
+      id: "monitor_del40f0_3f2a9c1e",
+      name: "Slow DDC Display",
+      type: "external",
+      min: 0,
+      max: 100,
+      current: -1,
+      probing: true,
+    });
+    const brightnessController = new BrightnessController(monitorManager);
+
+    const average = await brightnessController.getAverageBrightness();
+
+    expect(average).toBe(50);
+  });
+
+  it("should hand native log handlers to the addon", () => {
+    const handler = jest.fn();
+
+    expect(monitorManager.setNativeLogHandler(handler)).toBe(true);
+    expect(mockNativeAddon.setLogHandler).toHaveBeenCalledWith(handler);
+
+    monitorManager.setNativeLogHandler(null);
+    expect(mockNativeAddon.setLogHandler).toHaveBeenLastCalledWith(null);
+  });
+
+  it("should pass native stats through and forward reset", () => {
+    const stats = {
+      monitors: {},
+      enumeration: {
+        count: 1,
+        meanMs: 3,
+        maxMs: 3,
+        p50Ms: 5,
+        p95Ms: 5,
+        p99Ms: 5,
+      },
+      cache: { hits: 4, misses: 1 },
+      writeQueue: { depth: 0, coalesced: 2 },
+    };
+    mockNativeAddon.getStats.mockReturnValue(stats);
+
+    expect(monitorManager.getStats()).toBe(stats);
+    expect(mockNativeAddon.getStats).toHaveBeenLastCalledWith(false);
+
+    monitorManager.getStats(true);
+    expect(mockNativeAddon.getStats).toHaveBeenLastCalledWith(true);
+  });
+
+  describe("Batched writes", () => {
+    it("should program all monitors with one batch call", async () => {
+      const results = await monitorManager.setBrightnessForAll(30);
+
+      expect(mockNativeAddon.setBrightnessBatch).toHaveBeenCalledTimes(1);
+      expect(mockNativeAddon.setBrightnessAsync).not.toHaveBeenCalled();
+      expect(results.get("mock_internal_0")).toBe(true);
+      expect(results.get("mock_external_0")).toBe(true);
+      expect(mockMonitors.every((m) => m.current === 30)).toBe(true);
+    });
+
+    it("should clamp batch values before calling native code", async () => {
+      await monitorManager.setBrightnessBatch([
+        { id: "mock_internal_0", value: 150 },
+        { id: "mock_external_0", value: -20 },
+      ]);
+
+      expect(mockNativeAddon.setBrightnessBatch).toHaveBeenCalledWith([
+        { id: "mock_internal_0", value: 100 },
+        { id: "mock_external_0", value: 0 },
+      ]);
+    });
+
+    it("should report per-monitor failures", async () => {
+      const results = await monitorManager.setBrightnessBatch([
+        { id: "mock_internal_0", value: 40 },
+        { id: "missing", value: 40 },
+      ]);
+
+      expect(results.get("mock_internal_0")).toBe(true);
+      expect(results.get("missing")).toBe(false);
+    });
+
+    it("should use the batch for non-animated master brightness", async () => {
+      const brightnessController = new BrightnessController(monitorManager);
+
+      await brightnessController.setMasterBrightness(60, false);
+
+      expect(mockNativeAddon.setBrightnessBatch).toHaveBeenCalledTimes(1);
+      expect(mockMonitors.every((m) => m.current === 60)).toBe(true);
+    });
+  });
+});
@@ -0,0 +1,113 @@
+/**
+ * Native Change Notification Tests
+ *
+ * Verifies that MonitorManager subscribes to pushed brightness changes,
+ * applies them to its cached monitors and stops forcing hardware reads
+ * while they arrive
+ */
+
+import { BrightnessChangeEvent, Monitor } from "../shared/types";
+
+let pushChange: ((event: BrightnessChangeEvent) => void) | null = null;
+let mockMonitors: Monitor[];
+
+// Mock native addon exposing the change subscription
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(() => mockMonitors),
+  getBrightness: jest.fn(),
+  setBrightness: jest.fn(() => true),
+  onBrightnessChanged: jest.fn(
+    (handler: ((event: BrightnessChangeEvent) => void) | null) => {
+      pushChange = handler;
+    },
+  ),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+
+describe("Native Change Notifications", () => {
+  let monitorManager: MonitorManager;
+
+  beforeEach(async () => {
+    mockMonitors = [
+      {
+        id: "mock_internal_0",
+        name: "Mock Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 40,
+      },
+      {
+        id: "mock_external_0",
+        name: "Mock External Display 1",
+        type: "external",
+        min: 0,
+        max: 100,
+        current: 60,
+      },
+    ];
+    pushChange = null;
+
+    monitorManager = new MonitorManager(true);
+    await monitorManager.getMonitors(true);
+    jest.clearAllMocks();
+  });
+
+  it("should pass pushed changes to the listener", () => {
+    const listener = jest.fn();
+    expect(monitorManager.onBrightnessChanged(listener, 2000)).toBe(true);
+    expect(mockNativeAddon.onBrightnessChanged).toHaveBeenCalledWith(
+      expect.any(Function),
+      2000,
+    );
+
+    const event = {
+      monitorId: "mock_external_0",
+      oldValue: 60,
+      newValue: 25,
+    };
+    pushChange!(event);
+
+    expect(listener).toHaveBeenCalledWith(event);
+    expect(monitorManager.isWatchingBrightness()).toBe(true);
+  });
+
+  it("should update the cached monitor before the listener runs", async () => {
+    let seen = -1;
+    monitorManager.onBrightnessChanged(() => {
+      seen = mockMonitors[1].current;
+    });
+
+    pushChange!({ monitorId: "mock_external_0", oldValue: 60, newValue: 25 });
+
+    expect(seen).toBe(25);
+    const monitors = await monitorManager.getMonitors();
+    expect(monitors[1].current).toBe(25);
+    expect(mockNativeAddon.getMonitors).not.toHaveBeenCalled();
+  });
+
+  it("should report changes of monitors it has not listed", () => {
+    const listener = jest.fn();
+    monitorManager.onBrightnessChanged(listener);
+
+    pushChange!({ monitorId: "unknown", oldValue: 10, newValue: 20 });
+
+    expect(listener).toHaveBeenCalledTimes(1);
+    expect(mockMonitors.map((m) => m.current)).toEqual([40, 60]);
+  });
+
+  it("should unsubscribe with null", () => {
+    monitorManager.onBrightnessChanged(jest.fn());
+    expect(monitorManager.onBrightnessChanged(null)).toBe(true);
+
+    expect(mockNativeAddon.onBrightnessChanged).toHaveBeenLastCalledWith(null);
+    expect(pushChange).toBeNull();
+    expect(monitorManager.isWatchingBrightness()).toBe(false);
+  });
+});
@@ -0,0 +1,90 @@
+/**
+ * Native Deferred Start Tests
+ *
+ * Verifies that MonitorManager can start before the hardware is enumerated:
+ * the last session's monitors are served first and the real ones replace
+ * them once the native layer reports that discovery has finished
+ */
+
+import { Monitor } from "../shared/types";
+
+let mockMonitors: Monitor[];
+let finishDiscovery: (() => void) | null = null;
+
+// Mock native addon with deferred discovery
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(() => mockMonitors),
+  getBrightness: jest.fn(),
+  setBrightness: jest.fn(() => true),
+  whenHardwareReady: jest.fn(
+    () =>
+      new Promise<boolean>((resolve) => {
+        finishDiscovery = () => resolve(true);
+      }),
+  ),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+
+describe("Native Deferred Start", () => {
+  let monitorManager: MonitorManager;
+
+  beforeEach(() => {
+    mockMonitors = [
+      {
+        id: "monitor_del40f0_3f2a9c1e",
+        name: "DELL U2720Q",
+        type: "external",
+        min: 0,
+        max: 100,
+        current: 65,
+        provisional: true,
+      },
+    ];
+    finishDiscovery = null;
+
+    monitorManager = new MonitorManager(false, { deferHardware: true });
+  });
+
+  it("should ask the addon to defer hardware discovery", () => {
+    expect(mockNativeAddon.initialize).toHaveBeenCalledWith(
+      expect.objectContaining({ deferHardware: true }),
+    );
+  });
+
+  it("should serve the last known monitors until discovery finishes", async () => {
+    const monitors = await monitorManager.getMonitors(true);
+
+    expect(monitors).toHaveLength(1);
+    expect(monitors[0].provisional).toBe(true);
+    expect(monitors[0].current).toBe(65);
+  });
+
+  it("should refresh the monitor list when the hardware is ready", async () => {
+    const ready = monitorManager.whenHardwareReady();
+
+    mockMonitors = [
+      { ...mockMonitors[0], current: 70, provisional: undefined },
+      {
+        id: "internal_0",
+        name: "Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 40,
+      },
+    ];
+    finishDiscovery!();
+    await ready;
+
+    const monitors = await monitorManager.getMonitors();
+    expect(monitors).toHaveLength(2);
+    expect(monitors[0].current).toBe(70);
+    expect(monitors[0].provisional).toBeUndefined();
+  });
+});
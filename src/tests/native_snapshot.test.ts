@@ -0,0 +1,150 @@
+/**
+ * Native Snapshot Polling Tests
+ *
+ * Verifies that MonitorManager polls through the descriptor set and the
+ * brightness buffer, reusing its Monitor objects while the topology is
+ * unchanged
+ */
+
+import { MonitorDescriptorSet } from "../shared/types";
+
+let descriptorSet: MonitorDescriptorSet | null;
+let brightness: number[];
+let snapshotVersion: number;
+
+// Mock native addon exposing the snapshot exports
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(() => []),
+  getBrightness: jest.fn(),
+  setBrightness: jest.fn(() => true),
+  getMonitorsAsync: jest.fn(() => Promise.resolve([])),
+  getMonitorDescriptors: jest.fn(() => descriptorSet),
+  readBrightnessSnapshot: jest.fn((values: Int32Array) => {
+    values.set(brightness);
+    return snapshotVersion;
+  }),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+
+describe("Native Snapshot Polling", () => {
+  let monitorManager: MonitorManager;
+  let now: number;
+  let dateSpy: jest.SpyInstance;
+
+  // Step past the 500ms monitor list cache so every call polls native code
+  const poll = () => {
+    now += 1000;
+    return monitorManager.getMonitors();
+  };
+
+  beforeEach(() => {
+    descriptorSet = {
+      version: 1,
+      monitors: [
+        {
+          id: "mock_internal_0",
+          name: "Mock Internal Display",
+          type: "internal",
+          min: 0,
+          max: 100,
+        },
+        {
+          id: "mock_external_0",
+          name: "Mock External Display 1",
+          type: "external",
+          min: 0,
+          max: 100,
+        },
+      ],
+    };
+    brightness = [40, 60];
+    snapshotVersion = 1;
+    now = Date.now();
+    dateSpy = jest.spyOn(Date, "now").mockImplementation(() => now);
+
+    monitorManager = new MonitorManager(true);
+    jest.clearAllMocks();
+  });
+
+  afterEach(() => {
+    dateSpy.mockRestore();
+  });
+
+  it("should build monitors from descriptors and the brightness buffer", async () => {
+    const polled = await poll();
+
+    expect(polled).toHaveLength(2);
+    expect(polled[0]).toMatchObject({
+      id: "mock_internal_0",
+      type: "internal",
+      current: 40,
+      probing: false,
+    });
+    expect(polled[1].current).toBe(60);
+  });
+
+  it("should reuse the monitor objects while the topology is unchanged", async () => {
+    const first = await poll();
+    brightness = [10, 90];
+    const second = await poll();
+
+    expect(second).toBe(first);
+    expect(second[0]).toBe(first[0]);
+    expect(second.map((m) => m.current)).toEqual([10, 90]);
+    expect(mockNativeAddon.getMonitorsAsync).not.toHaveBeenCalled();
+  });
+
+  it("should rebuild the monitors when the descriptors change", async () => {
+    const first = await poll();
+    descriptorSet = {
+      version: 2,
+      monitors: descriptorSet!.monitors.slice(0, 1),
+    };
+    brightness = [70];
+    snapshotVersion = 2;
+
+    const second = await poll();
+
+    expect(second).not.toBe(first);
+    expect(second).toHaveLength(1);
+    expect(second[0].current).toBe(70);
+  });
+
+  it("should report probing monitors with -1", async () => {
+    brightness = [40, -1];
+
+    const monitors = await poll();
+
+    expect(monitors[1]).toMatchObject({ current: -1, probing: true });
+  });
+
+  it("should fall back to getMonitorsAsync when the snapshot needs hardware", async () => {
+    snapshotVersion = -1;
+
+    await poll();
+
+    expect(mockNativeAddon.getMonitorsAsync).toHaveBeenCalledWith(false);
+  });
+
+  it("should fall back while the monitor list is being rebuilt", async () => {
+    descriptorSet = null;
+
+    await poll();
+
+    expect(mockNativeAddon.readBrightnessSnapshot).not.toHaveBeenCalled();
+    expect(mockNativeAddon.getMonitorsAsync).toHaveBeenCalled();
+  });
+
+  it("should bypass the snapshot on forceRefresh", async () => {
+    await monitorManager.getMonitors(true);
+
+    expect(mockNativeAddon.getMonitorDescriptors).not.toHaveBeenCalled();
+    expect(mockNativeAddon.getMonitorsAsync).toHaveBeenCalledWith(true);
+  });
+});
@@ -0,0 +1,146 @@
+/**
+ * Native Transition Tests
+ *
+ * Verifies that animated brightness changes are handed to the native
+ * animator as targets and that overlapping requests are coalesced
+ */
+
+import { Monitor, BrightnessTransitionResult } from "../shared/types";
+
+// Pending transitions per monitor, mimicking the native animator
+const pending = new Map<
+  string,
+  { value: number; resolve: (result: BrightnessTransitionResult) => void }
+>();
+
+let mockMonitors: Monitor[] = [];
+
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(() => mockMonitors),
+  getBrightness: jest.fn((id: string) => {
+    const monitor = mockMonitors.find((m) => m.id === id);
+    return monitor ? monitor.current : -1;
+  }),
+  setBrightness: jest.fn(() => true),
+  setBrightnessTarget: jest.fn(
+    (id: string, value: number): Promise<BrightnessTransitionResult> => {
+      const monitor = mockMonitors.find((m) => m.id === id);
+      if (!monitor) {
+        return Promise.resolve({
+          id,
+          value: -1,
+          success: false,
+          superseded: false,
+        });
+      }
+
+      // A newer target replaces the in-flight one
+      const previous = pending.get(id);
+      if (previous) {
+        previous.resolve({
+          id,
+          value: monitor.current,
+          success: false,
+          superseded: true,
+        });
+      }
+
+      return new Promise((resolve) => pending.set(id, { value, resolve }));
+    },
+  ),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+import { BrightnessController } from "../main/brightness.controller";
+
+/**
+ * Finish all pending transitions at their target value
+ */
+function completeTransitions(): void {
+  pending.forEach((entry, id) => {
+    const monitor = mockMonitors.find((m) => m.id === id);
+    if (monitor) {
+      monitor.current = entry.value;
+    }
+    entry.resolve({ id, value: entry.value, success: true, superseded: false });
+  });
+  pending.clear();
+}
+
+describe("Native Transitions", () => {
+  let monitorManager: MonitorManager;
+  let brightnessController: BrightnessController;
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+    pending.clear();
+
+    mockMonitors = [
+      {
+        id: "mock_internal_0",
+        name: "Mock Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 50,
+      },
+      {
+        id: "mock_external_0",
+        name: "Mock External Display 1",
+        type: "external",
+        min: 0,
+        max: 100,
+        current: 50,
+      },
+    ];
+
+    monitorManager = new MonitorManager(true);
+    brightnessController = new BrightnessController(monitorManager);
+  });
+
+  it("should send one target per monitor instead of stepping in JS", async () => {
+    const transition = brightnessController.setMasterBrightness(80, true);
+    await new Promise((resolve) => setImmediate(resolve));
+    completeTransitions();
+    await transition;
+
+    expect(mockNativeAddon.setBrightnessTarget).toHaveBeenCalledTimes(2);
+    expect(mockNativeAddon.setBrightness).not.toHaveBeenCalled();
+    expect(mockMonitors.every((m) => m.current === 80)).toBe(true);
+  });
+
+  it("should redirect a running transition instead of skipping", async () => {
+    const first = brightnessController.setMonitorBrightness(
+      "mock_external_0",
+      90,
+    );
+    await new Promise((resolve) => setImmediate(resolve));
+
+    const second = brightnessController.setMonitorBrightness(
+      "mock_external_0",
+      20,
+    );
+    await new Promise((resolve) => setImmediate(resolve));
+    completeTransitions();
+
+    expect(await first).toBe(true);
+    expect(await second).toBe(true);
+    expect(mockNativeAddon.setBrightnessTarget).toHaveBeenLastCalledWith(
+      "mock_external_0",
+      20,
+      expect.any(Number),
+    );
+    expect(mockMonitors[1].current).toBe(20);
+  });
+
+  it("should report hardware failures as false", async () => {
+    const success = await monitorManager.transitionTo("missing", 40, 100);
+
+    expect(success).toBe(false);
+  });
+});
@@ -0,0 +1,204 @@
+/**
+ * Request Trace Tests
+ *
+ * Verifies that a traced request keeps one ID from its entry point down to
+ * the native addon and that the session is exported as Chrome trace events
+ */
+
+import { Monitor, NativeTraceEvent } from "../shared/types";
+
+let clockUs = 1000;
+let nativeEvents: NativeTraceEvent[] = [];
+
+// Mock native addon with the tracing exports
+const mockNativeAddon = {
+  initialize: jest.fn(() => true),
+  getMonitors: jest.fn(),
+  getBrightness: jest.fn(),
+  setBrightness: jest.fn(() => true),
+  getMonitorsAsync: jest.fn(),
+  getBrightnessAsync: jest.fn(
+    (_monitorId: string, _forceRefresh?: boolean, _traceId?: number) =>
+      Promise.resolve(40),
+  ),
+  setBrightnessAsync: jest.fn(
+    (_monitorId: string, _value: number, _traceId?: number) =>
+      Promise.resolve(true),
+  ),
+  setTracing: jest.fn(),
+  traceNow: jest.fn(() => (clockUs += 10)),
+  drainTrace: jest.fn(() => ({
+    events: nativeEvents,
+    threads: [
+      { tid: 1, name: "JavaScript" },
+      { tid: 2, name: "lane wmi" },
+    ],
+    dropped: 0,
+  })),
+};
+
+jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
+  virtual: true,
+});
+
+import { MonitorManager } from "../main/monitor.manager";
+import { BrightnessController } from "../main/brightness.controller";
+import { TraceService, traceService } from "../main/trace.service";
+
+describe("Request Trace", () => {
+  let monitorManager: MonitorManager;
+  let brightnessController: BrightnessController;
+
+  beforeEach(() => {
+    jest.clearAllMocks();
+    nativeEvents = [];
+
+    const monitors: Monitor[] = [
+      {
+        id: "internal_0",
+        name: "Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 40,
+      },
+    ];
+    mockNativeAddon.getMonitorsAsync.mockImplementation(() =>
+      Promise.resolve(monitors),
+    );
+
+    monitorManager = new MonitorManager(false);
+    brightnessController = new BrightnessController(monitorManager);
+  });
+
+  afterEach(() => {
+    if (traceService.isEnabled()) {
+      traceService.stop();
+    }
+  });
+
+  it("should not pass a trace ID while tracing is off", async () => {
+    await brightnessController.setMonitorBrightness("internal_0", 70, false);
+
+    expect(mockNativeAddon.setBrightnessAsync).toHaveBeenCalledWith(
+      "internal_0",
+      70,
+    );
+  });
+
+  it("should carry one ID per request down to the native addon", async () => {
+    traceService.start();
+    expect(mockNativeAddon.setTracing).toHaveBeenCalledWith(true);
+
+    await traceService.request("test first", () =>
+      brightnessController.setMonitorBrightness("internal_0", 70, false),
+    );
+    await traceService.request("test second", () =>
+      brightnessController.setMonitorBrightness("internal_0", 80, false),
+    );
+
+    const [first, second] = mockNativeAddon.setBrightnessAsync.mock.calls.map(
+      (call) => call[2],
+    );
+    expect(typeof first).toBe("number");
+    expect(second).not.toBe(first);
+    expect(mockNativeAddon.getBrightnessAsync).toHaveBeenCalledWith(
+      "internal_0",
+      false,
+      first,
+    );
+  });
+
+  it("should export JavaScript and native stages as Chrome trace events", async () => {
+    traceService.start();
+    await traceService.request("hotkey increase", () =>
+      brightnessController.setMonitorBrightness("internal_0", 70, false),
+    );
+    const traceId = mockNativeAddon.setBrightnessAsync.mock
+      .calls[0][2] as number;
+    nativeEvents = [
+      {
+        name: "hardware write",
+        cat: "wmi",
+        traceId,
+        ts: 1015,
+        dur: 5,
+        tid: 2,
+        monitorId: "internal_0",
+      },
+    ];
+
+    const trace = traceService.stop();
+    expect(mockNativeAddon.setTracing).toHaveBeenLastCalledWith(false);
+
+    // Every layer shows up as a slice of the request on the JS thread
+    const begins = trace.traceEvents.filter((e) => e.ph === "b");
+    expect(begins.map((e) => e.name)).toEqual(
+      expect.arrayContaining([
+        "hotkey increase",
+        "BrightnessController.setMonitorBrightness",
+        "addon.getBrightness",
+        "addon.setBrightness",
+      ]),
+    );
+    begins.forEach((e) => {
+      expect(e.tid).toBe(1);
+      expect(e.args).toEqual({ traceId });
+    });
+    expect(trace.traceEvents.filter((e) => e.ph === "e")).toHaveLength(
+      begins.length,
+    );
+
+    const write = trace.traceEvents.find((e) => e.ph === "X");
+    expect(write).toMatchObject({
+      name: "hardware write",
+      cat: "wmi",
+      ts: 1015,
+      dur: 5,
+      tid: 2,
+      args: { traceId, monitorId: "internal_0" },
+    });
+    expect(trace.traceEvents).toContainEqual(
+      expect.objectContaining({
+        name: "thread_name",
+        ph: "M",
+        tid: 2,
+        args: { name: "lane wmi" },
+      }),
+    );
+  });
+
+  it("should cap the JavaScript stages of a session and count the rest", async () => {
+    const capped = new TraceService(4);
+    capped.start();
+    for (let i = 0; i < 5; i++) {
+      await capped.request(`request ${i}`, () => Promise.resolve(i));
+    }
+
+    const trace = capped.stop();
+    expect(trace.traceEvents.filter((e) => e.ph === "b")).toHaveLength(4);
+    expect(trace.otherData).toEqual({
+      droppedNativeEvents: 0,
+      droppedJsStages: 1,
+    });
+
+    // A new session starts empty
+    capped.start();
+    await capped.request("again", () => Promise.resolve(0));
+    expect(capped.stop().otherData.droppedJsStages).toBe(0);
+  });
+
+  it("should record the IPC transit of a renderer request", async () => {
+    traceService.start();
+    await traceService.request(
+      "ipc brightness:set",
+      () => Promise.resolve(true),
+      performance.timeOrigin + performance.now() - 5,
+    );
+
+    const trace = traceService.stop();
+    const transit = trace.traceEvents.filter((e) => e.name === "ipc transit");
+    expect(transit).toHaveLength(2);
+    expect(transit[1].ts! - transit[0].ts!).toBeGreaterThanOrEqual(5000);
+  });
+});
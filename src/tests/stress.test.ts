@@ -20,6 +20,7 @@ jest.mock("../../build/Release/brightness.node", () => mockNativeAddon, {
 
 import { BrightnessController } from "../main/brightness.controller";
 import { MonitorManager } from "../main/monitor.manager";
+import { traceService } from "../main/trace.service";
 
 describe("Stress Tests", () => {
   let brightnessController: BrightnessController;
@@ -351,6 +352,135 @@ describe("Stress Tests", () => {
     });
   });
 
+  describe("Large Topology Stress", () => {
+    /**
+     * Monitors as native mock mode reports them for
+     * mockTopology: [{ type: "internal" }, { type: "external", count }]
+     */
+    const createTopology = (externalCount: number): Monitor[] => [
+      {
+        id: "mock_internal_0",
+        name: "Mock Internal Display",
+        type: "internal",
+        min: 0,
+        max: 100,
+        current: 50,
+      },
+      ...Array.from({ length: externalCount }, (_, i) => ({
+        id: `mock_external_${i}`,
+        name: `Mock External Display ${i + 1}`,
+        type: "external" as const,
+        min: 0,
+        max: 100,
+        current: 50,
+      })),
+    ];
+
+    it.each([8, 16])(
+      "should sync master brightness across %i monitors",
+      async (count) => {
+        mockMonitors.splice(
+          0,
+          mockMonitors.length,
+          ...createTopology(count - 1),
+        );
+        await monitorManager.getMonitors(true);
+
+        for (let i = 0; i < 100; i++) {
+          await brightnessController.setMasterBrightness(i % 101, true);
+        }
+
+        expect(mockMonitors).toHaveLength(count);
+        mockMonitors.forEach((monitor) => {
+          expect(monitor.current).toBe(99);
+        });
+      },
+    );
+
+    it("should follow monitors being plugged in and out", async () => {
+      mockMonitors.splice(0, mockMonitors.length, ...createTopology(15));
+      expect(await monitorManager.getMonitors(true)).toHaveLength(16);
+
+      // Hotplug: half the external monitors disappear, then come back
+      mockMonitors.splice(8);
+      expect(await monitorManager.getMonitors(true)).toHaveLength(8);
+      await brightnessController.setMasterBrightness(30, true);
+
+      mockMonitors.push(...createTopology(15).slice(8));
+      const monitors = await monitorManager.getMonitors(true);
+      expect(monitors).toHaveLength(16);
+      expect(mockMonitors.slice(0, 8).every((m) => m.current === 30)).toBe(
+        true,
+      );
+    });
+  });
+
+  describe("Traced Stress", () => {
+    type TracedStage = { name: string; ts: number; end: number };
+
+    afterEach(() => {
+      if (traceService.isEnabled()) {
+        traceService.stop();
+      }
+    });
+
+    it("should time every stage of 200 concurrent traced requests", async () => {
+      await monitorManager.getMonitors(true);
+      traceService.start();
+
+      const requests = 200;
+      await Promise.all(
+        Array.from({ length: requests }, (_, i) =>
+          traceService.request("stress master", () =>
+            brightnessController.setMasterBrightness(i % 101, false),
+          ),
+        ),
+      );
+      const trace = traceService.stop();
+
+      // Pair every slice and group the stages by request
+      const ends = new Map(
+        trace.traceEvents.filter((e) => e.ph === "e").map((e) => [e.id, e]),
+      );
+      const stages = new Map<unknown, TracedStage[]>();
+      trace.traceEvents
+        .filter((e) => e.ph === "b")
+        .forEach((begin) => {
+          const end = ends.get(begin.id);
+          expect(end).toBeDefined();
+          expect(end!.ts!).toBeGreaterThanOrEqual(begin.ts!);
+
+          const traceId = begin.args!.traceId;
+          stages.set(traceId, [
+            ...(stages.get(traceId) ?? []),
+            { name: begin.name, ts: begin.ts!, end: end!.ts! },
+          ]);
+        });
+
+      expect(stages.size).toBe(requests);
+      stages.forEach((request) => {
+        const names = request.map((stage) => stage.name);
+        expect(names).toEqual(
+          expect.arrayContaining([
+            "stress master",
+            "BrightnessController.setMasterBrightness",
+          ]),
+        );
+        expect(
+          names.filter((name) => name === "addon.setBrightness"),
+        ).toHaveLength(mockMonitors.length);
+
+        // Every stage lies within its request
+        const outer = request.find((stage) => stage.name === "stress master")!;
+        request.forEach((stage) => {
+          expect(stage.ts).toBeGreaterThanOrEqual(outer.ts);
+          expect(stage.end).toBeLessThanOrEqual(outer.end);
+        });
+      });
+      expect(trace.otherData.droppedJsStages).toBe(0);
+    });
+  });
+
   describe("Boundary Stress", () => {
     it("should handle alternating min/max values rapidly", async () => {
       for (let i = 0; i < 200; i++) {